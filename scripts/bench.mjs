@@ -0,0 +1,244 @@
+#!/usr/bin/env node
+// RayforceDB benchmark runner
+// Runs scripts/bench.suite.mjs against every built variant in dist/, under
+// Node and in headless Chromium (playwright), and writes one JSON report.
+// Reports of different commits or builds can then be compared:
+//
+//   node scripts/bench.mjs [--variants "wasm wasm-min"] [--node|--browser]
+//                          [--quick] [--out dist/bench.json]
+//   node scripts/bench.mjs --compare base.json head.json [--threshold 10]
+//
+// --compare exits with 1 when a case regressed by more than --threshold
+// percent, so it can gate CI.
+import { execFileSync, execSync } from 'node:child_process';
+import { existsSync, statSync } from 'node:fs';
+import { readFile, writeFile } from 'node:fs/promises';
+import { createServer } from 'node:http';
+import { extname, join, normalize } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import os from 'node:os';
+
+import { VARIANTS, runStartup, runSuite } from './bench.suite.mjs';
+
+const ROOT = fileURLToPath(new URL('..', import.meta.url));
+const DIST = join(ROOT, 'dist');
+
+function parseArgs(argv) {
+  const args = { variants: Object.keys(VARIANTS), node: true, browser: true, quick: false,
+    out: join(DIST, 'bench.json'), compare: null, threshold: 10 };
+  for (let i = 0; i < argv.length; i++) {
+    switch (argv[i]) {
+      case '--variants': args.variants = argv[++i].split(/[\s,]+/).filter(Boolean); break;
+      case '--node': args.browser = false; break;
+      case '--browser': args.node = false; break;
+      case '--quick': args.quick = true; break;
+      case '--out': args.out = argv[++i]; break;
+      case '--compare': args.compare = [argv[++i], argv[++i]]; break;
+      case '--threshold': args.threshold = Number(argv[++i]); break;
+      // Internal: runStartup of one variant, printed as JSON (see runNode)
+      case '--startup': args.startup = argv[++i]; break;
+      default: throw new Error(`Unknown argument '${argv[i]}'`);
+    }
+  }
+  return args;
+}
+
+function gitCommit() {
+  try {
+    return execSync('git rev-parse --short HEAD', { cwd: ROOT, stdio: ['ignore', 'pipe', 'ignore'] })
+      .toString().trim();
+  } catch {
+    return null;
+  }
+}
+
+// Loader and binary sizes of a variant, next to its timings
+function variantSizes(variant) {
+  const js = join(DIST, VARIANTS[variant].loader);
+  const wasm = js.replace(/\.js$/, '.wasm');
+  return { js: statSync(js).size, wasm: existsSync(wasm) ? statSync(wasm).size : null };
+}
+
+// ============================================================================
+// Node
+// ============================================================================
+
+// Startup cases in a child process, whose instances go away with it
+function nodeStartup(variant, quick) {
+  const argv = [fileURLToPath(import.meta.url), '--startup', variant, ...(quick ? ['--quick'] : [])];
+  const out = execFileSync(process.execPath, argv, { stdio: ['ignore', 'pipe', 'inherit'] }).toString();
+  // The report is the last line, after anything the module printed
+  return JSON.parse(out.trim().split('\n').pop());
+}
+
+async function runNode(variants, quick) {
+  const { init } = await import(join(DIST, 'index.js'));
+  const runs = [];
+  for (const variant of variants) {
+    console.log(`▶ node ${variant}`);
+    const startup = nodeStartup(variant, quick);
+    const run = await runSuite(init, variant, { quick });
+    run.results.splice(1, 0, ...startup);
+    runs.push({ runtime: 'node', ...run });
+  }
+  return runs;
+}
+
+// ============================================================================
+// Headless Chromium
+// ============================================================================
+
+const MIME = {
+  '.html': 'text/html', '.js': 'text/javascript', '.mjs': 'text/javascript',
+  '.wasm': 'application/wasm', '.json': 'application/json', '.bin': 'application/octet-stream',
+};
+
+// Static server over the repo; COOP/COEP make the page cross-origin
+// isolated so wasm-mt gets SharedArrayBuffer
+function serve() {
+  const server = createServer(async (req, res) => {
+    const path = normalize(join(ROOT, decodeURIComponent(new URL(req.url, 'http://x').pathname)));
+    if (!path.startsWith(ROOT)) {
+      res.writeHead(403).end();
+      return;
+    }
+    try {
+      const body = await readFile(path);
+      res.writeHead(200, {
+        'Content-Type': MIME[extname(path)] || 'application/octet-stream',
+        'Cross-Origin-Opener-Policy': 'same-origin',
+        'Cross-Origin-Embedder-Policy': 'require-corp',
+      });
+      res.end(body);
+    } catch {
+      res.writeHead(404).end();
+    }
+  });
+  return new Promise(resolve => server.listen(0, '127.0.0.1', () => resolve(server)));
+}
+
+// window.benchResult of one fresh page
+async function benchPage(browser, url) {
+  const page = await browser.newPage();
+  try {
+    await page.goto(url);
+    return await page.evaluate(() => window.benchResult);
+  } finally {
+    await page.close();
+  }
+}
+
+async function runBrowser(variants, quick) {
+  let playwright;
+  try {
+    playwright = await import('playwright');
+  } catch {
+    console.warn('⚠️  playwright not installed (npm install): skipping browser runs');
+    return [];
+  }
+
+  const server = await serve();
+  const browser = await playwright.chromium.launch();
+  const base = `http://127.0.0.1:${server.address().port}/scripts/bench.html`;
+  const runs = [];
+  try {
+    for (const variant of variants) {
+      console.log(`▶ chromium ${variant}`);
+      // Startup cases get a page of their own, like nodeStartup
+      const startup = await benchPage(browser, `${base}?variant=${variant}${quick ? '&quick' : ''}&startup`);
+      const run = await benchPage(browser, `${base}?variant=${variant}${quick ? '&quick' : ''}`);
+      if (startup.error || run.error) throw new Error(`chromium ${variant}: ${startup.error ?? run.error}`);
+      run.results.splice(1, 0, ...startup);
+      runs.push({ runtime: 'chromium', browser: browser.version(), ...run });
+    }
+  } finally {
+    await browser.close();
+    server.close();
+  }
+  return runs;
+}
+
+// ============================================================================
+// Compare
+// ============================================================================
+
+// Percent change of `head` against `base`, positive when better. Ratios
+// (fragmentation) can be 0, so they change by percentage points.
+function improvement(unit, base, head) {
+  if (unit === 'ratio') return (base - head) * 100;
+  const lowerIsBetter = unit === 'ms' || unit === 'MB';
+  return (lowerIsBetter ? base / head - 1 : head / base - 1) * 100;
+}
+
+async function compare([basePath, headPath], threshold) {
+  const [base, head] = await Promise.all([basePath, headPath].map(async p => JSON.parse(await readFile(p, 'utf8'))));
+  const baseline = new Map();
+  for (const run of base.runs) {
+    for (const r of run.results) baseline.set(`${run.runtime} ${run.variant} ${r.name}`, r);
+  }
+
+  console.log(`${base.commit ?? basePath} → ${head.commit ?? headPath}`);
+  let regressions = 0;
+  for (const run of head.runs) {
+    for (const r of run.results) {
+      const key = `${run.runtime} ${run.variant} ${r.name}`;
+      const b = baseline.get(key);
+      if (b === undefined || b.value === null || r.value === null) continue;
+      const change = improvement(r.unit, b.value, r.value);
+      const flag = change < -threshold ? '  ❌' : '';
+      if (flag) regressions++;
+      console.log(`${key.padEnd(48)} ${fmt(b.value).padStart(12)} ${fmt(r.value).padStart(12)} ${r.unit.padEnd(7)} ${(change >= 0 ? '+' : '') + change.toFixed(1)}%${flag}`);
+    }
+  }
+  if (regressions > 0) {
+    console.log(`${regressions} case(s) regressed by more than ${threshold}%`);
+    process.exit(1);
+  }
+}
+
+function fmt(value) {
+  return value >= 1000 ? Math.round(value).toLocaleString('en-US') : value.toPrecision(4);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+const args = parseArgs(process.argv.slice(2));
+
+if (args.startup !== null) {
+  const { init } = await import(join(DIST, 'index.js'));
+  const results = await runStartup(init, args.startup, { quick: args.quick });
+  process.stdout.write(`\n${JSON.stringify(results)}\n`);
+  // Started instances (and wasm-mt's pthreads) could keep the process alive
+  process.exit(0);
+} else if (args.compare !== null) {
+  await compare(args.compare, args.threshold);
+} else {
+  const variants = args.variants.filter(v => {
+    if (VARIANTS[v] === undefined) throw new Error(`Unknown variant '${v}'`);
+    if (existsSync(join(DIST, VARIANTS[v].loader))) return true;
+    console.warn(`⚠️  ${v}: dist/${VARIANTS[v].loader} not built, skipping (make ${v})`);
+    return false;
+  });
+  if (variants.length === 0) {
+    console.error('❌ No built variants in dist/ (make wasm)');
+    process.exit(1);
+  }
+
+  const runs = [
+    ...(args.node ? await runNode(variants, args.quick) : []),
+    ...(args.browser ? await runBrowser(variants, args.quick) : []),
+  ];
+  for (const run of runs) run.sizes = variantSizes(run.variant);
+
+  const report = {
+    commit: gitCommit(),
+    date: new Date().toISOString(),
+    quick: args.quick,
+    host: { node: process.version, platform: process.platform, arch: process.arch, cpus: os.cpus().length },
+    runs,
+  };
+  await writeFile(args.out, JSON.stringify(report, null, 2) + '\n');
+  console.log(`✅ Benchmark report written: ${args.out}`);
+}
@@ -0,0 +1,214 @@
+// RayforceDB benchmark suite
+// Platform-neutral: scripts/bench.mjs runs it under Node and, through
+// scripts/bench.html, in headless Chromium. Every case reports one number
+// (median of its repetitions) so runs of different builds and commits can
+// be compared line by line.
+
+// Build variants: the make target, its loader in dist/ and init() options
+export const VARIANTS = {
+  'wasm': { loader: 'rayforce.js', options: {} },
+  'wasm-mt': { loader: 'rayforce-mt.js', options: { threads: 4 } },
+  'wasm-min': { loader: 'rayforce-min.js', options: { wasmPath: './rayforce-min.js' } },
+  'wasm64': { loader: 'rayforce-64.js', options: { memory64: true } },
+  'wasm-pool': { loader: 'rayforce-pool.js', options: { wasmPath: './rayforce-pool.js' } },
+};
+
+// Representative queries over the generated `trades` and `refs` tables
+export const QUERIES = {
+  'select-where': '(select {from: trades where: (> price 500.0)})',
+  'group-by': '(select {from: trades by: sym total: (sum size) hi: (max price)})',
+  'join': '(left-join [sym] trades refs)',
+};
+
+const SYMBOLS = Array.from({ length: 256 }, (_, i) => `S${i.toString(36).toUpperCase()}`);
+
+// Deterministic data: every run and build sees the same bytes
+function rng(seed) {
+  let s = seed >>> 0;
+  return () => {
+    s = (s + 0x6d2b79f5) >>> 0;
+    let t = Math.imul(s ^ (s >>> 15), 1 | s);
+    t ^= t + Math.imul(t ^ (t >>> 7), 61 | t);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+const CSV_COLUMNS = {
+  i64: (r) => String(Math.floor(r() * 1e9)),
+  f64: (r) => (r() * 1000).toFixed(4),
+  symbol: (r) => SYMBOLS[Math.floor(r() * SYMBOLS.length)],
+};
+
+// About `bytes` of CSV with four columns of `kind` ('mixed' rotates them)
+function csvText(kind, bytes) {
+  const r = rng(42);
+  const kinds = kind === 'mixed' ? ['i64', 'f64', 'symbol', 'f64'] : [kind, kind, kind, kind];
+  const lines = [kinds.map((_, i) => `c${i}`).join(',')];
+  let size = lines[0].length + 1;
+  while (size < bytes) {
+    const line = kinds.map(k => CSV_COLUMNS[k](r)).join(',');
+    lines.push(line);
+    size += line.length + 1;
+  }
+  return lines.join('\n') + '\n';
+}
+
+function tradeColumns(rows) {
+  const r = rng(7);
+  const sym = new Array(rows);
+  const price = new Float64Array(rows);
+  const size = new BigInt64Array(rows);
+  for (let i = 0; i < rows; i++) {
+    sym[i] = SYMBOLS[Math.floor(r() * SYMBOLS.length)];
+    price[i] = r() * 1000;
+    size[i] = BigInt(Math.floor(r() * 10000));
+  }
+  return { sym, price, size };
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+// Run `fn` `reps` times after one warm-up; returns the median in ms
+function time(fn, reps) {
+  const samples = [];
+  fn();
+  for (let i = 0; i < reps; i++) {
+    const t0 = performance.now();
+    fn();
+    samples.push(performance.now() - t0);
+  }
+  return median(samples);
+}
+
+async function timeAsync(fn, reps) {
+  const samples = [];
+  for (let i = 0; i < reps; i++) {
+    const t0 = performance.now();
+    await fn();
+    samples.push(performance.now() - t0);
+  }
+  return median(samples);
+}
+
+/**
+ * Time instances started after the module is compiled. An SDK instance has
+ * no teardown, so every one started here lives until the process (or page)
+ * exits: run this in its own so they cannot weigh on runSuite's cases.
+ * @param {Function} init - init() of dist/index.js
+ * @param {string} variant - Key of VARIANTS
+ * @param {Object} [config]
+ * @param {boolean} [config.quick=false] - Fewer repetitions
+ * @returns {Promise<Object[]>} startup.warm and startup.lean results
+ */
+export async function runStartup(init, variant, config = {}) {
+  const { quick = false } = config;
+  const reps = quick ? 3 : 7;
+  const options = { ...VARIANTS[variant].options, singleton: false };
+
+  // Compiles and caches the module, like the cold start of runSuite
+  await init(options);
+  return [
+    { name: 'startup.warm', value: await timeAsync(() => init(options), reps), unit: 'ms' },
+    { name: 'startup.lean', value: await timeAsync(() => init({ ...options, lean: true }), reps), unit: 'ms' },
+  ];
+}
+
+/**
+ * Run every case against one variant (all but runStartup's)
+ * @param {Function} init - init() of dist/index.js
+ * @param {string} variant - Key of VARIANTS
+ * @param {Object} [config]
+ * @param {boolean} [config.quick=false] - Smaller inputs, fewer repetitions
+ * @returns {Promise<Object>} { variant, version, simd, pointerSize, results }
+ */
+export async function runSuite(init, variant, config = {}) {
+  const { quick = false } = config;
+  const reps = quick ? 3 : 7;
+  const rows = quick ? 100_000 : 1_000_000;
+  const csvSizes = quick ? [1 << 20] : [1 << 20, 16 << 20];
+  const options = { ...VARIANTS[variant].options, singleton: false };
+
+  const results = [];
+  const record = (name, value, unit, extra = {}) => results.push({ name, value, unit, ...extra });
+
+  // Startup: this instance compiles the module and runs the rest of the
+  // suite; warm and lean starts come from runStartup in a fresh process
+  const t0 = performance.now();
+  const rf = await init({ ...options, cacheModule: false });
+  record('startup.cold', performance.now() - t0, 'ms');
+
+  // read_csv throughput by size and column type
+  for (const bytes of csvSizes) {
+    for (const kind of ['i64', 'f64', 'symbol', 'mixed']) {
+      const text = csvText(kind, bytes);
+      const ms = time(() => rf.readCsv(text).drop(), reps);
+      record(`read_csv.${kind}.${bytes >> 20}MB`, text.length / 1048576 / (ms / 1000), 'MB/s');
+    }
+  }
+
+  // Table construction: element-wise sdk.table against bulk tableFromColumns
+  const cols = tradeColumns(rows);
+  const plain = { sym: cols.sym, price: Array.from(cols.price), size: Array.from(cols.size) };
+  record('table.arrays', rows / (time(() => rf.table(plain).drop(), reps) / 1000), 'rows/s');
+  record('table.bulk', rows / (time(() => rf.tableFromColumns(cols).drop(), reps) / 1000), 'rows/s');
+
+  // Export
+  const trades = rf.tableFromColumns(cols);
+  rf.set('trades', trades);
+  record('export.toJS', rows / (time(() => trades.toJS(), reps) / 1000), 'rows/s');
+  const rowSample = Math.min(rows, 100_000);
+  const head = rf.tableFromColumns({
+    sym: cols.sym.slice(0, rowSample),
+    price: cols.price.subarray(0, rowSample),
+    size: cols.size.subarray(0, rowSample),
+  });
+  record('export.toRows', rowSample / (time(() => head.toRows(), reps) / 1000), 'rows/s');
+  head.drop();
+
+  // Symbol round trip: intern then resolve
+  const ids = rf.internSymbols(cols.sym);
+  record('symbols.intern', rows / (time(() => rf.internSymbols(cols.sym), reps) / 1000), 'syms/s');
+  record('symbols.resolve', rows / (time(() => rf.resolveSymbols(ids), reps) / 1000), 'syms/s');
+
+  // Query latency
+  rf.set('refs', rf.tableFromColumns({
+    sym: SYMBOLS,
+    sector: SYMBOLS.map((_, i) => SYMBOLS[i % 16]),
+  }));
+  for (const [name, query] of Object.entries(QUERIES)) {
+    const probe = rf.eval(query);
+    const error = probe.isError ? probe.message : undefined;
+    probe.drop();
+    if (error !== undefined) {
+      record(`eval.${name}`, null, 'ms', { error });
+      continue;
+    }
+    record(`eval.${name}`, time(() => rf.eval(query).drop(), reps), 'ms');
+  }
+  record('eval.scalar', time(() => rf.eval('(+ 1 2)').drop(), reps * 100), 'ms');
+  trades.drop();
+
+  // Allocator (wasm against wasm-pool): short-lived atoms, then the heap
+  // left after atoms of mixed lifetimes, one in ten outliving the rest
+  const atoms = quick ? 100_000 : 1_000_000;
+  const churn = () => {
+    for (let i = 0; i < atoms; i++) rf.i64(i).drop();
+  };
+  record('alloc.atoms', atoms / (time(churn, reps) / 1000), 'atoms/s');
+  const held = [];
+  for (let i = 0; i < atoms; i++) {
+    const atom = i % 2 ? rf.f64(i) : rf.symbol(SYMBOLS[i % SYMBOLS.length]);
+    if (i % 10 === 0) held.push(atom);
+    else atom.drop();
+  }
+  for (const atom of held) atom.drop();
+  const heap = rf.heapStats();
+  record('alloc.heap', heap.heapBytes / 1048576, 'MB', { allocator: heap.allocator });
+  record('alloc.fragmentation', heap.fragmentation, 'ratio');
+
+  return { variant, version: rf.version, simd: rf.simd, pointerSize: rf.pointerSize, results };
+}
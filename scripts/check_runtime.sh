@@ -0,0 +1,25 @@
+#!/bin/sh
+# RayforceDB runtime method check
+# Fails when the SDK reads an Emscripten runtime method that the given
+# EXPORTED_RUNTIME_METHODS list leaves out. wasm-min trims the list, and a
+# missing method only shows up as "x is not a function" at run time.
+#
+#   sh scripts/check_runtime.sh "$(MIN_RUNTIME_METHODS)" src/rayforce.sdk.js ...
+set -e
+
+METHODS="$1"
+shift
+
+missing=0
+for name in $(grep -ohE '(_wasm|\bw)\.[A-Za-z_][A-Za-z0-9_]*' "$@" | sed 's/.*\.//' | sort -u); do
+    case "${name}" in
+        # Exports, the split build's linker and a Module option
+        _*|loadDynamicLibrary|onMemoryGrowth) continue ;;
+    esac
+    case "${METHODS}" in
+        *"'${name}'"*) ;;
+        *) echo "❌ ${name} is used by the SDK but not in EXPORTED_RUNTIME_METHODS"; missing=1 ;;
+    esac
+done
+
+exit ${missing}
@@ -0,0 +1,46 @@
+#!/bin/sh
+# RayforceDB WASM Size Report
+# Prints raw, gzip and brotli byte sizes of every built variant in dist/
+# and writes them to dist/size-report.json
+set -e
+
+DIST_DIR="${1:-$(pwd)/dist}"
+REPORT="${DIST_DIR}/size-report.json"
+VARIANTS="rayforce rayforce-mt rayforce-64 rayforce-min rayforce-pool rayforce-split rayforce-io"
+
+gzip_size() {
+    gzip -9 -c "$1" | wc -c | tr -d ' '
+}
+
+brotli_size() {
+    if command -v brotli >/dev/null 2>&1; then
+        brotli -q 11 -c "$1" | wc -c | tr -d ' '
+    else
+        echo null
+    fi
+}
+
+printf '%-24s %12s %12s %12s\n' "file" "raw" "gzip" "brotli"
+
+first=1
+echo "{" > "${REPORT}"
+for variant in ${VARIANTS}; do
+    for ext in js wasm; do
+        file="${DIST_DIR}/${variant}.${ext}"
+        [ -f "${file}" ] || continue
+
+        raw=$(wc -c < "${file}" | tr -d ' ')
+        gz=$(gzip_size "${file}")
+        br=$(brotli_size "${file}")
+
+        printf '%-24s %12s %12s %12s\n' "${variant}.${ext}" "${raw}" "${gz}" "${br}"
+
+        [ ${first} -eq 1 ] || echo "," >> "${REPORT}"
+        first=0
+        printf '  "%s": { "raw": %s, "gzip": %s, "brotli": %s }' \
+            "${variant}.${ext}" "${raw}" "${gz}" "${br}" >> "${REPORT}"
+    done
+done
+printf '\n}\n' >> "${REPORT}"
+
+echo "Size report written to ${REPORT}"
@@ -0,0 +1,17 @@
+#!/usr/bin/env node
+// RayforceDB snapshot builder
+// Starts a lean instance of dist/rayforce.js under Node and writes its
+// post-runtime_create memory to dist/rayforce.snapshot.bin, for
+// init({ snapshot }). The snapshot only fits the build it was taken from:
+// `make snapshot` regenerates it after every `make wasm`.
+import { writeFile } from 'node:fs/promises';
+
+const dist = new URL('../dist/', import.meta.url);
+const { init } = await import(new URL('index.js', dist));
+
+const rf = await init({ lean: true, singleton: false, cacheModule: false });
+const memory = rf.snapshot();
+const out = new URL(process.argv[2] || 'rayforce.snapshot.bin', dist);
+
+await writeFile(out, memory);
+console.log(`✅ Snapshot written: ${out.pathname} (${(memory.length / 1048576).toFixed(1)} MB)`);
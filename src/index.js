@@ -22,6 +22,7 @@
  */
 
 import { createRayforceSDK, Types, Expr } from './rayforce.sdk.js';
+import { createWorkerSDK } from './rayforce.proxy.js';
 
 // SDK version
 export const version = '0.1.0';
@@ -29,19 +30,51 @@ export const version = '0.1.0';
 // Re-export types and utilities
 export { Types, Expr };
 export * from './rayforce.sdk.js';
+export { createWorkerSDK, RayforceWorkerSDK, RemoteObject } from './rayforce.proxy.js';
+
+// WASM memory sizing (IMPORTED_MEMORY build; matches the Emscripten defaults)
+const WASM_PAGE_SIZE = 65536;
+const DEFAULT_INITIAL_MEMORY = 16 * 1024 * 1024;
+const DEFAULT_MAXIMUM_MEMORY = 4 * 1024 * 1024 * 1024;
+const DEFAULT_MAXIMUM_MEMORY_64 = 16 * 1024 * 1024 * 1024;
 
 // Global SDK instance (for singleton pattern)
 let _sdkInstance = null;
 let _initPromise = null;
 
+// Compiled modules by .wasm URL: later instances and workers skip the
+// download and compile
+const _modules = new Map();
+
 /**
  * Initialize the RayforceDB SDK.
  * 
  * @param {Object} [options] - Configuration options
  * @param {string} [options.wasmPath] - Custom path to rayforce.js WASM loader
+ * @param {number} [options.threads=1] - Rayforce pool size; values above 1
+ *   load the multi-threaded build when cross-origin isolation is available
+ * @param {string} [options.wasmMtPath] - Custom path to rayforce-mt.js loader
+ * @param {boolean} [options.memory64=false] - Load the wasm64 (Memory64) build
+ *   for heaps past 4GB; single-threaded, needs an engine with Memory64
+ * @param {string} [options.wasm64Path] - Custom path to rayforce-64.js loader
+ * @param {boolean} [options.lean=false] - Skip main()'s self-test, banner and
+ *   examples/ scan; onReady receives the version string
+ * @param {Uint8Array|ArrayBuffer|string|URL} [options.snapshot] - Memory from
+ *   sdk.snapshot() (or its URL, e.g. rayforce.snapshot.bin from `make snapshot`)
+ *   of the same build; the instance starts from it without running main()
+ * @param {WebAssembly.Module} [options.wasmModule] - Precompiled module
+ * @param {boolean} [options.cacheModule=true] - Compile the .wasm once with
+ *   WebAssembly.compileStreaming and reuse it for later instances and workers
+ * @param {number} [options.initialMemory] - Initial heap size in bytes (min 16MB);
+ *   sizing it for the workload avoids growth, which rebuilds every heap view
+ * @param {number} [options.maximumMemory] - Heap growth ceiling in bytes (max 4GB,
+ *   16GB with memory64)
+ * @param {boolean} [options.worker=false] - Host the engine in a Web Worker and
+ *   return an async proxy (every method returns a Promise)
+ * @param {string|URL} [options.workerPath] - Custom path to rayforce.worker.js
  * @param {boolean} [options.singleton=true] - Use singleton pattern (reuse instance)
  * @param {Function} [options.onReady] - Callback when WASM is fully initialized
- * @returns {Promise<RayforceSDK>} The initialized SDK instance
+ * @returns {Promise<RayforceSDK|RayforceWorkerSDK>} The initialized SDK instance
  * 
  * @example
  * // Basic usage
@@ -52,10 +85,39 @@ let _initPromise = null;
  * 
  * // Force new instance
  * const rf = await init({ singleton: false });
+ * 
+ * // Parallel pool (falls back to single-threaded without COOP/COEP)
+ * const rf = await init({ threads: navigator.hardwareConcurrency });
+ *
+ * // Preallocate 256MB, never grow past 1GB
+ * const rf = await init({ initialMemory: 256 << 20, maximumMemory: 1 << 30 });
+ *
+ * // Near-instant extra instances: lean start from a prebuilt snapshot,
+ * // reusing the module compiled by the first init()
+ * const rf2 = await init({ singleton: false, snapshot: './rayforce.snapshot.bin' });
+ *
+ * // wasm64 build with room for an 8GB heap
+ * const rf = await init({ memory64: true, maximumMemory: 8 * 2 ** 30 });
+ *
+ * // Off the main thread; columns arrive as transferred TypedArrays
+ * const rf = await init({ worker: true });
+ * const cols = await (await rf.readCsv(text)).columns();
  */
 export async function init(options = {}) {
   const {
     wasmPath = './rayforce.js',
+    wasmMtPath = './rayforce-mt.js',
+    memory64 = false,
+    wasm64Path = './rayforce-64.js',
+    lean = false,
+    snapshot,
+    wasmModule,
+    cacheModule = true,
+    threads = 1,
+    initialMemory,
+    maximumMemory,
+    worker = false,
+    workerPath,
     singleton = true,
     onReady = null,
   } = options;
@@ -72,20 +134,60 @@ export async function init(options = {}) {
 
   const initFn = async () => {
     try {
-      // Dynamic import of WASM module
-      const wasmModule = await import(wasmPath);
-      const createRayforce = wasmModule.default;
+      if (worker) {
+        // The worker gets this thread's compiled module (modules are
+        // structured-cloneable) instead of compiling its own
+        const loader = memory64 ? wasm64Path : threads > 1 && canUseThreads() ? wasmMtPath : wasmPath;
+        const module = wasmModule ?? (cacheModule ? await compileModule(loader).catch(() => undefined) : undefined);
+        const sdk = await createWorkerSDK({
+          wasmPath, wasmMtPath, memory64, wasm64Path, threads, initialMemory, maximumMemory,
+          lean, snapshot, wasmModule: module, cacheModule: false, workerPath, onReady,
+        });
+        if (singleton) {
+          _sdkInstance = sdk;
+        }
+        return sdk;
+      }
+
+      // Pthreads need SharedArrayBuffer, which browsers only expose to
+      // cross-origin isolated pages (Node always has it). The wasm64 build
+      // is single-threaded.
+      const multiThreaded = !memory64 && threads > 1 && canUseThreads();
+      const loader = memory64 ? wasm64Path : multiThreaded ? wasmMtPath : wasmPath;
+      const memory = snapshot === undefined ? null : await loadBytes(snapshot);
+      if (memory !== null && multiThreaded) {
+        throw new Error('snapshot needs the single-threaded build (threads: 1)');
+      }
+      
+      // Dynamic import of the Emscripten loader; the .wasm itself comes
+      // from the module cache when it can be compiled here
+      const [loaderModule, module] = await Promise.all([
+        import(loader),
+        wasmModule ?? (cacheModule ? compileModule(loader).catch(() => undefined) : undefined),
+      ]);
+      const createRayforce = loaderModule.default;
       
-      // Initialize WASM
-      const wasm = await createRayforce({
-        // Optional: configure WASM module
+      // Initialize WASM (a snapshot needs the memory to start at its size)
+      const wasmMemory = createMemory(
+        memory === null ? initialMemory : Math.max(initialMemory ?? DEFAULT_INITIAL_MEMORY, memory.length),
+        maximumMemory, multiThreaded, memory64, memory !== null);
+
+      const wasm = await instantiate(createRayforce, {
+        // Pool size (and the lean start) is read by main() from the arguments
+        arguments: ['-p', String(multiThreaded ? threads : 1), ...(lean ? ['--lean'] : [])],
+        // A snapshot already holds main()'s runtime
+        noInitialRun: memory !== null,
+        ...(wasmMemory && { wasmMemory }),
         rayforce_ready: (msg) => {
           if (onReady) onReady(msg);
         }
-      });
+      }, module);
+
+      if (memory !== null) wasm.HEAPU8.set(memory);
 
       // Create SDK wrapper
       const sdk = createRayforceSDK(wasm);
+      if (memory !== null && onReady) onReady(sdk.version);
       
       if (singleton) {
         _sdkInstance = sdk;
@@ -108,6 +210,120 @@ export async function init(options = {}) {
   return initFn();
 }
 
+/**
+ * Create the module memory when init() is given explicit sizes
+ * @param {number} [initialMemory] - Bytes
+ * @param {number} [maximumMemory] - Bytes
+ * @param {boolean} shared - Multi-threaded builds need shared memory
+ * @param {boolean} [memory64=false] - wasm64 builds take a 64-bit memory,
+ *   sized in BigInt pages
+ * @param {boolean} [required=false] - Create it even with default sizes
+ * @returns {WebAssembly.Memory|undefined}
+ */
+function createMemory(initialMemory, maximumMemory, shared, memory64 = false, required = false) {
+  if (initialMemory === undefined && maximumMemory === undefined && !required) {
+    return undefined;
+  }
+
+  const ceiling = memory64 ? DEFAULT_MAXIMUM_MEMORY_64 : DEFAULT_MAXIMUM_MEMORY;
+  const initial = Math.ceil((initialMemory ?? DEFAULT_INITIAL_MEMORY) / WASM_PAGE_SIZE);
+  const maximum = Math.ceil((maximumMemory ?? ceiling) / WASM_PAGE_SIZE);
+  if (initial > maximum) {
+    throw new Error('initialMemory exceeds maximumMemory');
+  }
+
+  if (memory64) {
+    return new WebAssembly.Memory({ address: 'i64', initial: BigInt(initial), maximum: BigInt(maximum) });
+  }
+  return new WebAssembly.Memory({ initial, maximum, shared });
+}
+
+/**
+ * Compile the .wasm binary next to an Emscripten loader, once per URL.
+ * Streams the download into the compiler when the server sends
+ * application/wasm.
+ * @param {string|URL} loaderPath - Path of rayforce.js (or -mt / -64),
+ *   resolved like init()'s wasmPath
+ * @returns {Promise<WebAssembly.Module>}
+ */
+export function compileModule(loaderPath) {
+  const url = new URL(String(loaderPath).replace(/\.js$/, '.wasm'), import.meta.url);
+  let compiled = _modules.get(url.href);
+  if (compiled === undefined) {
+    compiled = compileUrl(url);
+    _modules.set(url.href, compiled);
+    compiled.catch(() => _modules.delete(url.href));
+  }
+  return compiled;
+}
+
+async function compileUrl(url) {
+  if (url.protocol !== 'file:' && typeof WebAssembly.compileStreaming === 'function') {
+    try {
+      return await WebAssembly.compileStreaming(fetch(url));
+    } catch (error) {
+      // Wrong MIME type or no streaming support: compile from the bytes
+    }
+  }
+  return WebAssembly.compile(await loadBytes(url));
+}
+
+/**
+ * Bytes of a buffer, or of a file fetched (read from disk under Node)
+ * relative to this module
+ * @param {Uint8Array|ArrayBuffer|string|URL} source
+ * @returns {Promise<Uint8Array>}
+ */
+async function loadBytes(source) {
+  if (source instanceof ArrayBuffer) return new Uint8Array(source);
+  if (ArrayBuffer.isView(source)) {
+    return new Uint8Array(source.buffer, source.byteOffset, source.byteLength);
+  }
+
+  const url = new URL(String(source), import.meta.url);
+  if (url.protocol === 'file:') {
+    const { readFile } = await import('node:fs/promises');
+    return new Uint8Array(await readFile(url));
+  }
+
+  const response = await fetch(url);
+  if (!response.ok) throw new Error(`Failed to fetch ${url.href}: ${response.status}`);
+  return new Uint8Array(await response.arrayBuffer());
+}
+
+/**
+ * Run an Emscripten factory, instantiating a precompiled module when given
+ * @param {Function} createRayforce
+ * @param {Object} moduleOptions
+ * @param {WebAssembly.Module} [module]
+ * @returns {Promise<Object>} The Emscripten module
+ */
+function instantiate(createRayforce, moduleOptions, module) {
+  if (module === undefined) return createRayforce(moduleOptions);
+
+  // instantiateWasm errors never reach the factory's promise
+  let fail;
+  const failed = new Promise((resolve, reject) => { fail = reject; });
+  const instance = createRayforce({
+    ...moduleOptions,
+    instantiateWasm: (imports, receiveInstance) => {
+      WebAssembly.instantiate(module, imports)
+        .then((result) => receiveInstance(result, module), fail);
+      return {};
+    },
+  });
+  return Promise.race([instance, failed]);
+}
+
+/**
+ * Check if the multi-threaded build can run in this environment
+ * @returns {boolean}
+ */
+export function canUseThreads() {
+  return typeof SharedArrayBuffer !== 'undefined' &&
+    globalThis.crossOriginIsolated !== false;
+}
+
 /**
  * Get the singleton SDK instance (must call init() first)
  * @returns {RayforceSDK|null}
@@ -204,6 +420,9 @@ export const create = {
 
 export default {
   init,
+  canUseThreads,
+  compileModule,
+  createWorkerSDK,
   getInstance,
   isInitialized,
   reset,
@@ -8,10 +8,20 @@
  */
 
 // System headers (string.h is already included via def.h)
+#include <ctype.h>
+#ifndef WASM_NO_FS
 #include <dirent.h>
+#endif
 #include <emscripten.h>
+#include <emscripten/heap.h>
+#include <float.h>
+#include <malloc.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <strings.h>
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
 
 // Rayforce headers (from RAYFORCE_SRC via -I flag)
 #include "binary.h"
@@ -23,6 +33,7 @@
 #include "misc.h"
 #include "query.h"
 #include "runtime.h"
+#include "serde.h" // Include serde.h for header_t (IPC framing)
 #include "string.h"
 #include "sys.h"
 #include "update.h"
@@ -47,17 +58,40 @@ static i64_t __CMD_COUNTER = 0;
 // JavaScript callbacks
 // ============================================================================
 
-// Declare rayforce_ready callback on js side
+// Declare rayforce_ready callback on js side (quoted so closure builds keep
+// the name)
 EM_JS(nil_t, js_rayforce_ready, (str_p text), {
-  if (Module.rayforce_ready) {
-    Module.rayforce_ready(UTF8ToString(text));
+  if (Module['rayforce_ready']) {
+    Module['rayforce_ready'](UTF8ToString(text));
   }
 });
 
+// Pending interrupt, consumed by the first check that sees it. The SDK
+// answers from an Int32Array another thread can set while this one is busy
+// (sdk.interrupt(), or the worker proxy through shared memory).
+EM_JS(i32_t, js_rayforce_interrupted, (), {
+  return Module['rayforce_interrupted'] ? Module['rayforce_interrupted']() : 0;
+});
+
+// ============================================================================
+// Interrupts
+// ============================================================================
+
+// Long loops in this file (kernels, table_sort, mview_update) poll for an
+// interrupt every INTERRUPT_BLOCK elements and unwind with an "Interrupted"
+// error. Loops inside the core (ray_eval_str, select, update) have no such
+// check; sdk.evalAsync reads the same flag before each top-level form.
+#define INTERRUPT_BLOCK (1 << 16)
+
+static b8_t interrupted(nil_t) { return js_rayforce_interrupted() != 0; }
+
 // ============================================================================
 // Helper functions
 // ============================================================================
 
+// Size-optimized builds (-DWASM_NO_FS) link without Emscripten's FS and
+// have no examples/ to list
+#ifndef WASM_NO_FS
 static nil_t list_examples(obj_p *dst) {
   DIR *dir;
   struct dirent *entry;
@@ -86,6 +120,162 @@ static nil_t list_examples(obj_p *dst) {
 
   return;
 }
+#endif
+
+// ============================================================================
+// Profiler
+// ============================================================================
+
+// Opt-in timing of the evaluation entry points. While disabled an entry only
+// tests a flag; while enabled each call also samples the allocator, and
+// mallinfo walks the heap, so profiled runs are slower than normal ones.
+#define PROF_PARSE 0       // profile_cmd: source compiled to a lambda
+#define PROF_EVAL 1        // profile_cmd: the lambda applied
+#define PROF_FORMAT 2      // strof_obj and profile_cmd result formatting
+#define PROF_EVAL_CMD 3    // eval_cmd (ray_eval_str)
+#define PROF_EVAL_CACHED 4 // eval_cached
+#define PROF_EVAL_PLAN 5   // eval_plan
+#define PROF_SELECT 6      // query_select (ray_select)
+#define PROF_UPDATE 7      // query_update (ray_update)
+#define PROF_SLOTS 8
+
+// Stored as doubles so JS can read the struct through HEAPF64 directly
+typedef struct prof_slot_t {
+  f64_t calls;
+  f64_t ms;
+  f64_t bytes; // net allocator growth over the calls
+  f64_t start; // emscripten_get_now() at the last call (performance.now)
+  f64_t last;  // duration of the last call
+} prof_slot_t;
+
+typedef struct prof_stats_t {
+  prof_slot_t slots[PROF_SLOTS];
+  f64_t bytes;      // net allocator growth since profile_begin
+  // Largest in-use size right after an entry returned; not a true peak, as
+  // memory allocated and freed within a call is never sampled
+  f64_t max_end_bytes;
+} prof_stats_t;
+
+typedef struct prof_mark_t {
+  f64_t t; // negative when the profiler is off
+  f64_t used;
+} prof_mark_t;
+
+static b8_t __PROF_ON = B8_FALSE;
+static f64_t __PROF_BASE = 0;
+static prof_stats_t __PROF_STATS;
+
+static f64_t prof_used(nil_t) {
+  struct mallinfo mi = mallinfo();
+  return (f64_t)(u32_t)mi.uordblks;
+}
+
+static prof_mark_t prof_enter(nil_t) {
+  prof_mark_t m = {-1, 0};
+
+  if (__PROF_ON) {
+    m.used = prof_used();
+    m.t = emscripten_get_now();
+  }
+  return m;
+}
+
+static nil_t prof_leave(i32_t slot, prof_mark_t m) {
+  prof_slot_t *s;
+  f64_t now, used;
+
+  if (!__PROF_ON || m.t < 0)
+    return;
+  now = emscripten_get_now();
+  used = prof_used();
+  s = &__PROF_STATS.slots[slot];
+  s->calls += 1;
+  s->ms += now - m.t;
+  s->bytes += used - m.used;
+  s->start = m.t;
+  s->last = now - m.t;
+  if (used > __PROF_STATS.max_end_bytes)
+    __PROF_STATS.max_end_bytes = used;
+}
+
+// Reset the statistics and start profiling
+EMSCRIPTEN_KEEPALIVE nil_t profile_begin(nil_t) {
+  memset(&__PROF_STATS, 0, sizeof(__PROF_STATS));
+  __PROF_BASE = prof_used();
+  __PROF_STATS.max_end_bytes = __PROF_BASE;
+  __PROF_ON = B8_TRUE;
+}
+
+// Stop profiling and get the statistics gathered since profile_begin
+EMSCRIPTEN_KEEPALIVE prof_stats_t *profile_end(nil_t) {
+  if (__PROF_ON)
+    __PROF_STATS.bytes = prof_used() - __PROF_BASE;
+  __PROF_ON = B8_FALSE;
+  return &__PROF_STATS;
+}
+
+// ============================================================================
+// Heap Statistics
+// ============================================================================
+
+// Allocator state from mallinfo. With SYS_MALLOC every rayforce object is a
+// malloc chunk; pool builds (make wasm-pool) carve objects out of mmap'd
+// blocks, which Emscripten takes from malloc, so `used` then counts whole
+// blocks. Doubles for HEAPF64, like prof_stats_t.
+typedef struct heap_stats_t {
+  f64_t arena;         // bytes malloc obtained from sbrk
+  f64_t used;          // allocated chunk bytes
+  f64_t free;          // free chunk bytes inside the arena
+  f64_t free_chunks;   // number of free chunks
+  f64_t releasable;    // free bytes at the top of the arena
+  f64_t fragmentation; // free bytes below the top, as a fraction of the arena
+  f64_t pool;          // 1 when built with rayforce's own allocator
+} heap_stats_t;
+
+static heap_stats_t __HEAP_STATS;
+
+// Sample the allocator (walks the heap, so not for hot paths)
+EMSCRIPTEN_KEEPALIVE heap_stats_t *heap_stats(nil_t) {
+  struct mallinfo mi = mallinfo();
+  heap_stats_t *h = &__HEAP_STATS;
+
+  h->arena = (f64_t)(u32_t)mi.arena;
+  h->used = (f64_t)(u32_t)mi.uordblks;
+  h->free = (f64_t)(u32_t)mi.fordblks;
+  h->free_chunks = (f64_t)(u32_t)mi.ordblks;
+  h->releasable = (f64_t)(u32_t)mi.keepcost;
+  h->fragmentation = h->arena > 0 ? (h->free - h->releasable) / h->arena : 0;
+#ifdef SYS_MALLOC
+  h->pool = 0;
+#else
+  h->pool = 1;
+#endif
+  return h;
+}
+
+// Top of the sbrk heap. Memory below it is the whole module state (static
+// data, malloc arena and, in pool builds, the mmap'd blocks carved from it),
+// copied by sdk.snapshot() for pre-initialized instances.
+EMSCRIPTEN_KEEPALIVE raw_p heap_end(nil_t) {
+  return (raw_p)*emscripten_get_sbrk_ptr();
+}
+
+// ============================================================================
+// Split Build Features
+// ============================================================================
+
+// Subsystems the split build (make wasm-split, -DWASM_SPLIT) links into side
+// modules rather than the main module. Their symbols bind lazily, so the SDK
+// loads a module (sdk.loadFeature) before the first call that needs it.
+#define SPLIT_FEATURE_IO 1 // rayforce-io.wasm: CSV parser and serialization
+
+EMSCRIPTEN_KEEPALIVE i32_t split_features(nil_t) {
+#ifdef WASM_SPLIT
+  return SPLIT_FEATURE_IO;
+#else
+  return 0;
+#endif
+}
 
 // ============================================================================
 // Core WASM exports
@@ -106,12 +296,16 @@ EMSCRIPTEN_KEEPALIVE str_p version_str(nil_t) {
 
 // Format any object to a string for JS consumption
 EMSCRIPTEN_KEEPALIVE str_p strof_obj(obj_p obj) {
+  prof_mark_t m;
+
   // Free previous formatted result
   if (last_formatted != NULL) {
     drop_obj(last_formatted);
   }
   // Format the object (full=true for complete output)
+  m = prof_enter();
   last_formatted = obj_fmt(obj, B8_TRUE);
+  prof_leave(PROF_FORMAT, m);
   return AS_C8(last_formatted);
 }
 
@@ -119,16 +313,14 @@ EMSCRIPTEN_KEEPALIVE str_p strof_obj(obj_p obj) {
 // Source-tracking evaluation functions
 // ============================================================================
 
-// Evaluate a command with source tracking for proper error locations
-EMSCRIPTEN_KEEPALIVE obj_p eval_cmd(lit_p cmd, lit_p name) {
+// Evaluate `len` bytes of source under `name` (auto-named when empty)
+static obj_p eval_source(lit_p src, i64_t len, lit_p name) {
   obj_p str_obj, name_obj, result;
   c8_t auto_name[32];
-
-  if (cmd == NULL)
-    return NULL_OBJ;
+  prof_mark_t m;
 
   // Create string object from command
-  str_obj = string_from_str(cmd, strlen(cmd));
+  str_obj = string_from_str(src, len);
 
   // Create or auto-generate source name
   if (name != NULL && name[0] != '\0') {
@@ -140,7 +332,9 @@ EMSCRIPTEN_KEEPALIVE obj_p eval_cmd(lit_p cmd, lit_p name) {
   }
 
   // Evaluate with source tracking
+  m = prof_enter();
   result = ray_eval_str(str_obj, name_obj);
+  prof_leave(PROF_EVAL_CMD, m);
 
   // Cleanup input objects
   drop_obj(str_obj);
@@ -149,12 +343,292 @@ EMSCRIPTEN_KEEPALIVE obj_p eval_cmd(lit_p cmd, lit_p name) {
   return result;
 }
 
+// Evaluate a command with source tracking for proper error locations
+EMSCRIPTEN_KEEPALIVE obj_p eval_cmd(lit_p cmd, lit_p name) {
+  if (cmd == NULL)
+    return NULL_OBJ;
+  return eval_source(cmd, strlen(cmd), name);
+}
+
 // Get current command counter
 EMSCRIPTEN_KEEPALIVE i64_t get_cmd_counter(nil_t) { return __CMD_COUNTER; }
 
 // Reset command counter
 EMSCRIPTEN_KEEPALIVE nil_t reset_cmd_counter(nil_t) { __CMD_COUNTER = 0; }
 
+// ============================================================================
+// Stepped Evaluation
+// ============================================================================
+
+// sdk.evalAsync runs a program one top-level form at a time and returns to
+// the JS event loop in between, where an AbortSignal can stop it. The
+// scanner only finds form boundaries (brackets, string literals, comments);
+// each form still goes through the parser as written.
+
+// Skip whitespace and `;` line comments
+static i32_t skip_blank(lit_p s, i32_t i) {
+  for (;;) {
+    while (s[i] != '\0' && isspace((u8_t)s[i]))
+      i++;
+    if (s[i] != ';')
+      return i;
+    while (s[i] != '\0' && s[i] != '\n')
+      i++;
+  }
+}
+
+// Offset just past the string literal opening at s[i]
+static i32_t skip_string(lit_p s, i32_t i) {
+  for (i++; s[i] != '\0' && s[i] != '"'; i++) {
+    if (s[i] == '\\' && s[i + 1] != '\0')
+      i++;
+  }
+  return s[i] == '"' ? i + 1 : i;
+}
+
+// Offset of the next form at or after `start`, -1 once only blanks remain
+EMSCRIPTEN_KEEPALIVE i32_t eval_next_form(lit_p cmd, i32_t start) {
+  i32_t i = skip_blank(cmd, start);
+  return cmd[i] == '\0' ? -1 : i;
+}
+
+// End (exclusive) of the form at `start`. Unbalanced input runs to the end
+// of the source so the parser reports it.
+EMSCRIPTEN_KEEPALIVE i32_t eval_form_end(lit_p cmd, i32_t start) {
+  i32_t i = start, depth = 0;
+  c8_t c;
+
+  // Quote prefixes belong to the form they quote
+  while (cmd[i] == '\'')
+    i++;
+
+  while ((c = cmd[i]) != '\0') {
+    if (c == '"') {
+      i = skip_string(cmd, i);
+    } else if (c == ';') {
+      if (depth == 0)
+        break;
+      while (cmd[i] != '\0' && cmd[i] != '\n')
+        i++;
+    } else if (c == '(' || c == '[' || c == '{') {
+      depth++;
+      i++;
+    } else if (c == ')' || c == ']' || c == '}') {
+      i++;
+      if (--depth <= 0)
+        break;
+    } else if (depth == 0 && isspace((u8_t)c)) {
+      break;
+    } else {
+      i++;
+    }
+    // An atom ends where the next form opens
+    if (depth == 0 && i > start && (cmd[i] == '(' || cmd[i] == '[' ||
+                                     cmd[i] == '{' || cmd[i] == '"'))
+      break;
+  }
+
+  return i;
+}
+
+// Evaluate cmd[start, end) as its own command
+EMSCRIPTEN_KEEPALIVE obj_p eval_span(lit_p cmd, i32_t start, i32_t end,
+                                     lit_p name) {
+  if (cmd == NULL || end <= start)
+    return NULL_OBJ;
+  return eval_source(cmd + start, end - start, name);
+}
+
+// ============================================================================
+// Prepared Commands
+// ============================================================================
+
+// Commands are compiled once into a lambda `(fn [params] cmd)` and kept in a
+// bounded LRU keyed by a hash of the parameter list and source text, so
+// repeated evaluation skips string conversion and parsing.
+#define PREPARED_CACHE_SIZE 256
+
+typedef struct prepared_t {
+  u64_t hash;
+  str_p key; // "params\ncmd", compared when the hash matches
+  i64_t len;
+  obj_p fn;
+  i64_t tick; // last use, 0 for an empty slot
+} prepared_t;
+
+static prepared_t __PREPARED[PREPARED_CACHE_SIZE];
+static i64_t __PREPARED_TICK = 0;
+
+static u64_t fnv1a(lit_p s, i64_t n, u64_t h) {
+  i64_t i;
+  for (i = 0; i < n; i++) {
+    h ^= (u8_t)s[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+// Compile `cmd` into the lambda `(fn [params] cmd)`; `kind` prefixes the
+// source name used in error locations. The closing paren goes on its own
+// line so a trailing `;` comment in `cmd` cannot swallow it.
+static obj_p compile_cmd(lit_p cmd, lit_p params, lit_p kind) {
+  i64_t len = strlen(params) + strlen(cmd) + 16, n;
+  str_p src;
+  obj_p str_obj, name_obj, fn;
+  c8_t name[32];
+
+  src = (str_p)malloc(len);
+  if (src == NULL)
+    return err_user("Out of memory: failed to prepare command");
+  n = snprintf(src, len, "(fn [%s] %s\n)", params, cmd);
+  str_obj = string_from_str(src, n);
+  free(src);
+
+  snprintf(name, sizeof(name), "%s:%lld", kind, ++__CMD_COUNTER);
+  name_obj = string_from_str(name, strlen(name));
+  fn = ray_eval_str(str_obj, name_obj);
+  drop_obj(str_obj);
+  drop_obj(name_obj);
+
+  if (fn == NULL || IS_ERR(fn))
+    return fn != NULL ? fn : err_user("Failed to prepare command");
+  if (fn->type != TYPE_LAMBDA) {
+    drop_obj(fn);
+    return err_user("Prepared command did not compile to a lambda");
+  }
+  return fn;
+}
+
+// Compiled lambda for `cmd` over space-separated `params`. Lambdas are
+// borrowed from the cache; errors are returned as new objects.
+static obj_p prepared_lookup(lit_p cmd, lit_p params) {
+  i64_t i, slot = 0, clen = strlen(cmd), plen = strlen(params), len;
+  u64_t hash;
+  prepared_t *e;
+  obj_p fn;
+
+  len = plen + 1 + clen;
+  hash = fnv1a(cmd, clen, fnv1a("\n", 1, fnv1a(params, plen, 0xcbf29ce484222325ULL)));
+
+  for (i = 0; i < PREPARED_CACHE_SIZE; i++) {
+    e = &__PREPARED[i];
+    if (e->fn != NULL && e->hash == hash && e->len == len &&
+        memcmp(e->key, params, plen) == 0 &&
+        memcmp(e->key + plen + 1, cmd, clen) == 0) {
+      e->tick = ++__PREPARED_TICK;
+      return e->fn;
+    }
+    if (e->tick < __PREPARED[slot].tick)
+      slot = i;
+  }
+
+  fn = compile_cmd(cmd, params, "prepared");
+  if (IS_ERR(fn))
+    return fn;
+
+  e = &__PREPARED[slot];
+  if (e->fn != NULL) {
+    drop_obj(e->fn);
+    free(e->key);
+  }
+  e->key = (str_p)malloc(len);
+  if (e->key == NULL) {
+    e->fn = NULL;
+    e->tick = 0;
+    drop_obj(fn);
+    return err_user("Out of memory: failed to prepare command");
+  }
+  memcpy(e->key, params, plen);
+  e->key[plen] = '\n';
+  memcpy(e->key + plen + 1, cmd, clen);
+  e->hash = hash;
+  e->len = len;
+  e->fn = fn;
+  e->tick = ++__PREPARED_TICK;
+  return fn;
+}
+
+// Compile `cmd` into a lambda over space-separated parameter names
+// (cached). Returns a new reference to the lambda, or an error.
+EMSCRIPTEN_KEEPALIVE obj_p prepare_cmd(lit_p cmd, lit_p params) {
+  obj_p fn;
+
+  if (cmd == NULL)
+    return NULL_OBJ;
+  fn = prepared_lookup(cmd, params != NULL ? params : "");
+  return IS_ERR(fn) ? fn : clone_obj(fn);
+}
+
+// Evaluate a command through the prepared cache: parsed on first use only.
+// The command runs as a lambda body, so its local bindings do not persist.
+EMSCRIPTEN_KEEPALIVE obj_p eval_cached(lit_p cmd) {
+  obj_p fn, call, result;
+  prof_mark_t m;
+
+  if (cmd == NULL)
+    return NULL_OBJ;
+  fn = prepared_lookup(cmd, "");
+  if (IS_ERR(fn))
+    return fn;
+
+  call = LIST(1);
+  if (call == NULL)
+    return err_user("Failed to allocate call");
+  AS_LIST(call)[0] = clone_obj(fn);
+  m = prof_enter();
+  result = eval_obj(call);
+  prof_leave(PROF_EVAL_CACHED, m);
+  drop_obj(call);
+  return result;
+}
+
+// Drop every cached command
+EMSCRIPTEN_KEEPALIVE nil_t prepared_cache_clear(nil_t) {
+  i64_t i;
+
+  for (i = 0; i < PREPARED_CACHE_SIZE; i++) {
+    if (__PREPARED[i].fn != NULL) {
+      drop_obj(__PREPARED[i].fn);
+      free(__PREPARED[i].key);
+    }
+    memset(&__PREPARED[i], 0, sizeof(prepared_t));
+  }
+}
+
+// Evaluate `cmd` in separately profiled phases: compiled to a lambda (parse),
+// applied (eval) and formatted once (format, the text is discarded). Like
+// eval_cached the command runs as a lambda body and is never cached.
+EMSCRIPTEN_KEEPALIVE obj_p profile_cmd(lit_p cmd) {
+  obj_p fn, call, result, text;
+  prof_mark_t m;
+
+  if (cmd == NULL)
+    return NULL_OBJ;
+
+  m = prof_enter();
+  fn = compile_cmd(cmd, "", "profile");
+  prof_leave(PROF_PARSE, m);
+  if (IS_ERR(fn))
+    return fn;
+
+  call = LIST(1);
+  if (call == NULL) {
+    drop_obj(fn);
+    return err_user("Failed to allocate call");
+  }
+  AS_LIST(call)[0] = fn;
+  m = prof_enter();
+  result = eval_obj(call);
+  prof_leave(PROF_EVAL, m);
+  drop_obj(call);
+
+  m = prof_enter();
+  text = obj_fmt(result, B8_TRUE);
+  prof_leave(PROF_FORMAT, m);
+  drop_obj(text);
+  return result;
+}
+
 // ============================================================================
 // Type Code Constants (exported for JS)
 // ============================================================================
@@ -260,6 +734,44 @@ EMSCRIPTEN_KEEPALIVE u32_t get_obj_rc(obj_p obj) {
   return rc_obj(obj);
 }
 
+// Object header snapshot, read by the SDK through HEAP32 so wrapping an
+// object takes one call instead of one per field
+typedef struct obj_header_t {
+  i32_t type;  // type code, negative for atoms
+  i32_t attrs;
+  i32_t rc;
+  i32_t flags; // OBJ_HEADER_* bits
+  i64_t len;   // 1 for atoms
+  raw_p data;  // vector data, NULL for atoms
+} obj_header_t;
+
+#define OBJ_HEADER_ATOM 1
+#define OBJ_HEADER_VECTOR 2
+#define OBJ_HEADER_NULL 4
+#define OBJ_HEADER_ERR 8
+
+EMSCRIPTEN_KEEPALIVE nil_t obj_header(obj_p obj, obj_header_t *out) {
+  if (out == NULL)
+    return;
+
+  if (obj == NULL) {
+    memset(out, 0, sizeof(obj_header_t));
+    out->type = TYPE_NULL;
+    out->flags = OBJ_HEADER_NULL;
+    return;
+  }
+
+  out->type = (i32_t)obj->type;
+  out->attrs = (i32_t)obj->attrs;
+  out->rc = (i32_t)rc_obj(obj);
+  out->flags = (IS_ATOM(obj) ? OBJ_HEADER_ATOM : 0) |
+               (IS_VECTOR(obj) ? OBJ_HEADER_VECTOR : 0) |
+               (is_null(obj) ? OBJ_HEADER_NULL : 0) |
+               (IS_ERR(obj) ? OBJ_HEADER_ERR : 0);
+  out->len = IS_ATOM(obj) ? 1 : obj->len;
+  out->data = IS_ATOM(obj) ? NULL : (raw_p)AS_C8(obj);
+}
+
 // ============================================================================
 // Memory Access for Zero-Copy ArrayBuffer Views
 // ============================================================================
@@ -272,6 +784,10 @@ EMSCRIPTEN_KEEPALIVE raw_p get_data_ptr(obj_p obj) {
   return (raw_p)AS_C8(obj);
 }
 
+// Pointer width of this build: 4 for wasm32, 8 for wasm64 (-sMEMORY64),
+// where the SDK passes pointers and i64 values as BigInt
+EMSCRIPTEN_KEEPALIVE i32_t ptr_size(nil_t) { return (i32_t)sizeof(raw_p); }
+
 // Get byte size of element for a type
 EMSCRIPTEN_KEEPALIVE i32_t get_element_size(i8_t type) {
   switch (type < 0 ? -type : type) {
@@ -424,6 +940,76 @@ EMSCRIPTEN_KEEPALIVE obj_p init_vector(i8_t type, i64_t len) {
 
 EMSCRIPTEN_KEEPALIVE obj_p init_list(i64_t len) { return LIST(len); }
 
+// ============================================================================
+// Symbol Interning
+// ============================================================================
+
+// Intern a string as symbol and return ID
+EMSCRIPTEN_KEEPALIVE i64_t intern_symbol(lit_p str, i64_t len) {
+  obj_p sym = symbol(str, len);
+  i64_t id = sym->i64;
+  drop_obj(sym);
+  return id;
+}
+
+// Intern `n` packed UTF-8 strings into `out_ids`: string i spans
+// buf[offsets[i] .. offsets[i + 1]), so `offsets` holds n + 1 entries.
+// The i64 `n` comes last so wasm32 builds without WASM_BIGINT line up.
+EMSCRIPTEN_KEEPALIVE nil_t intern_symbols_bulk(lit_p buf, i32_t *offsets,
+                                               i64_t *out_ids, i64_t n) {
+  i64_t i;
+  if (buf == NULL || offsets == NULL || out_ids == NULL)
+    return;
+  for (i = 0; i < n; i++)
+    out_ids[i] = intern_symbol(buf + offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+// Reused result buffer of symbols_to_strs_bulk
+static str_p __SYMBOL_BLOB = NULL;
+static i64_t __SYMBOL_BLOB_CAP = 0;
+
+// Resolve `n` symbol ids to strings in one call. Returns a blob laid out as
+// n + 1 i32 offsets followed by the packed UTF-8 bytes (offsets are relative
+// to the bytes). The blob is reused: valid until the next call.
+EMSCRIPTEN_KEEPALIVE str_p symbols_to_strs_bulk(i64_t *ids, i64_t n) {
+  i64_t i, len, size, cap;
+  i32_t *offsets;
+  str_p bytes, blob, s;
+
+  if (ids == NULL || n < 0)
+    return NULL;
+
+  size = (n + 1) * (i64_t)sizeof(i32_t);
+  for (i = 0; i < n; i++) {
+    s = str_from_symbol(ids[i]);
+    size += s ? (i64_t)strlen(s) : 0;
+  }
+
+  if (size > __SYMBOL_BLOB_CAP) {
+    cap = __SYMBOL_BLOB_CAP ? __SYMBOL_BLOB_CAP : 4096;
+    while (cap < size)
+      cap *= 2;
+    blob = (str_p)realloc(__SYMBOL_BLOB, cap);
+    if (blob == NULL)
+      return NULL;
+    __SYMBOL_BLOB = blob;
+    __SYMBOL_BLOB_CAP = cap;
+  }
+
+  offsets = (i32_t *)__SYMBOL_BLOB;
+  bytes = __SYMBOL_BLOB + (n + 1) * sizeof(i32_t);
+  offsets[0] = 0;
+  for (i = 0; i < n; i++) {
+    s = str_from_symbol(ids[i]);
+    len = s ? (i64_t)strlen(s) : 0;
+    if (len > 0)
+      memcpy(bytes + offsets[i], s, len);
+    offsets[i + 1] = offsets[i] + (i32_t)len;
+  }
+
+  return __SYMBOL_BLOB;
+}
+
 // ============================================================================
 // Vector Operations
 // ============================================================================
@@ -435,8 +1021,9 @@ EMSCRIPTEN_KEEPALIVE obj_p vec_at_idx(obj_p obj, i64_t idx) {
   return at_idx(obj, idx);
 }
 
-// Set element at index
-EMSCRIPTEN_KEEPALIVE obj_p vec_set_idx(obj_p *obj, i64_t idx, obj_p val) {
+// Set element at index (`idx` last, as an i64 ahead of `val` would shift it
+// on wasm32 without WASM_BIGINT)
+EMSCRIPTEN_KEEPALIVE obj_p vec_set_idx(obj_p *obj, obj_p val, i64_t idx) {
   if (obj == NULL || *obj == NULL)
     return NULL_OBJ;
   return set_idx(obj, idx, val);
@@ -449,8 +1036,8 @@ EMSCRIPTEN_KEEPALIVE obj_p vec_push(obj_p *obj, obj_p val) {
   return push_obj(obj, val);
 }
 
-// Insert element at index
-EMSCRIPTEN_KEEPALIVE obj_p vec_insert(obj_p *obj, i64_t idx, obj_p val) {
+// Insert element at index (`idx` last, like vec_set_idx)
+EMSCRIPTEN_KEEPALIVE obj_p vec_insert(obj_p *obj, obj_p val, i64_t idx) {
   if (obj == NULL || *obj == NULL)
     return NULL_OBJ;
   return ins_obj(obj, idx, val);
@@ -491,373 +1078,5224 @@ EMSCRIPTEN_KEEPALIVE nil_t fill_f64_vec(obj_p obj, f64_t *data, i64_t len) {
   memcpy(AS_F64(obj), data, copy_len * sizeof(f64_t));
 }
 
-// ============================================================================
-// Dict Operations
-// ============================================================================
-
-EMSCRIPTEN_KEEPALIVE obj_p init_dict(obj_p keys, obj_p vals) {
-  return dict(keys, vals);
-}
-
-// Get dict keys
-EMSCRIPTEN_KEEPALIVE obj_p dict_keys(obj_p d) {
-  if (d == NULL || d->type != TYPE_DICT)
-    return NULL_OBJ;
-  return clone_obj(AS_LIST(d)[0]);
-}
-
-// Get dict values
-EMSCRIPTEN_KEEPALIVE obj_p dict_vals(obj_p d) {
-  if (d == NULL || d->type != TYPE_DICT)
-    return NULL_OBJ;
-  return clone_obj(AS_LIST(d)[1]);
+// Fill any fixed-width vector (B8 .. TIMESTAMP, GUID) from a raw buffer
+EMSCRIPTEN_KEEPALIVE nil_t fill_vec(obj_p obj, raw_p data, i64_t len) {
+  if (obj == NULL || data == NULL || IS_ATOM(obj) || obj->type == TYPE_LIST)
+    return;
+  i64_t copy_len = len < obj->len ? len : obj->len;
+  memcpy(AS_C8(obj), data, copy_len * get_element_size(obj->type));
 }
 
-// Get value by key
-EMSCRIPTEN_KEEPALIVE obj_p dict_get(obj_p d, obj_p key) {
-  if (d == NULL || d->type != TYPE_DICT)
-    return NULL_OBJ;
-  return at_obj(d, key);
+// Fill a symbol vector from packed UTF-8 strings: string i spans
+// bytes[offsets[i] .. offsets[i + 1]), so `offsets` holds len + 1 entries
+EMSCRIPTEN_KEEPALIVE nil_t fill_symbol_vec(obj_p obj, lit_p bytes,
+                                           i32_t *offsets, i64_t len) {
+  if (obj == NULL || bytes == NULL || offsets == NULL || obj->type != TYPE_SYMBOL)
+    return;
+  intern_symbols_bulk(bytes, offsets, AS_SYMBOL(obj), len < obj->len ? len : obj->len);
 }
 
 // ============================================================================
-// Table Operations
+// Vector Kernels
 // ============================================================================
 
-EMSCRIPTEN_KEEPALIVE obj_p init_table(obj_p cols, obj_p vals) {
-  return table(cols, vals);
+// Reductions, comparisons into B8 masks and mask compaction over fixed-width
+// vectors. Builds with -msimd128 (wasm, wasm-mt) run the wasm_simd128.h
+// loops, others (wasm-debug) only the scalar ones, which also finish the
+// tails. Reductions skip nulls; -ffinite-math-only folds `x != x`, so F64
+// nulls (NaN) are found on the bits.
+#define KERN_SUM 0
+#define KERN_MIN 1
+#define KERN_MAX 2
+#define KERN_AVG 3
+
+#define KERN_EQ 0
+#define KERN_NE 1
+#define KERN_LT 2
+#define KERN_LE 3
+#define KERN_GT 4
+#define KERN_GE 5
+
+#define KERN_F64_INF 0x7ff0000000000000LL // magnitude bits above it are NaN
+
+typedef struct kern_acc_t {
+  i64_t n; // non-null elements
+  i64_t i;
+  f64_t f;
+} kern_acc_t;
+
+static b8_t kern_f64_null(f64_t x) {
+  i64_t b;
+
+  memcpy(&b, &x, sizeof(b));
+  return (b & INT64_MAX) > KERN_F64_INF;
 }
 
-// Get table column names (symbol vector)
-EMSCRIPTEN_KEEPALIVE obj_p table_keys(obj_p t) {
-  if (t == NULL || t->type != TYPE_TABLE)
-    return NULL_OBJ;
-  return clone_obj(AS_LIST(t)[0]);
+static nil_t kern_sum_i64(const i64_t *x, i64_t len, kern_acc_t *a) {
+  i64_t i = 0, s = 0, n = 0;
+#ifdef __wasm_simd128__
+  v128_t nul = wasm_i64x2_splat(NULL_I64), vs = wasm_i64x2_splat(0);
+  v128_t vn = wasm_i64x2_splat(0), v, m;
+
+  for (; i + 2 <= len; i += 2) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i64x2_ne(v, nul);
+    vs = wasm_i64x2_add(vs, wasm_v128_and(v, m));
+    vn = wasm_i64x2_sub(vn, m);
+  }
+  s = wasm_i64x2_extract_lane(vs, 0) + wasm_i64x2_extract_lane(vs, 1);
+  n = wasm_i64x2_extract_lane(vn, 0) + wasm_i64x2_extract_lane(vn, 1);
+#endif
+  for (; i < len; i++) {
+    if (x[i] != NULL_I64) {
+      s += x[i];
+      n++;
+    }
+  }
+  a->i = s;
+  a->n = n;
 }
 
-// Get table values (list of vectors)
-EMSCRIPTEN_KEEPALIVE obj_p table_vals(obj_p t) {
-  if (t == NULL || t->type != TYPE_TABLE)
-    return NULL_OBJ;
-  return clone_obj(AS_LIST(t)[1]);
+static nil_t kern_minmax_i64(const i64_t *x, i64_t len, b8_t max,
+                             kern_acc_t *a) {
+  i64_t i = 0, r = max ? INT64_MIN : INT64_MAX, n = 0;
+#ifdef __wasm_simd128__
+  v128_t nul = wasm_i64x2_splat(NULL_I64), id = wasm_i64x2_splat(r);
+  v128_t vr = id, vn = wasm_i64x2_splat(0), v, m;
+  i64_t l;
+  i32_t j;
+
+  for (; i + 2 <= len; i += 2) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i64x2_ne(v, nul);
+    v = wasm_v128_bitselect(v, id, m);
+    vr = wasm_v128_bitselect(v, vr, max ? wasm_i64x2_gt(v, vr) : wasm_i64x2_lt(v, vr));
+    vn = wasm_i64x2_sub(vn, m);
+  }
+  for (j = 0; j < 2; j++) {
+    l = j == 0 ? wasm_i64x2_extract_lane(vr, 0) : wasm_i64x2_extract_lane(vr, 1);
+    if (max ? l > r : l < r)
+      r = l;
+  }
+  n += wasm_i64x2_extract_lane(vn, 0) + wasm_i64x2_extract_lane(vn, 1);
+#endif
+  for (; i < len; i++) {
+    if (x[i] == NULL_I64)
+      continue;
+    if (max ? x[i] > r : x[i] < r)
+      r = x[i];
+    n++;
+  }
+  a->i = r;
+  a->n = n;
 }
 
-// Get column by name
-EMSCRIPTEN_KEEPALIVE obj_p table_col(obj_p t, lit_p col_name, i64_t len) {
-  if (t == NULL || t->type != TYPE_TABLE)
-    return NULL_OBJ;
-  obj_p sym = symbol(col_name, len);
-  obj_p result = at_obj(t, sym);
-  drop_obj(sym);
-  return result;
+static nil_t kern_sum_i32(const i32_t *x, i64_t len, kern_acc_t *a) {
+  i64_t i = 0, s = 0, n = 0;
+#ifdef __wasm_simd128__
+  v128_t nul = wasm_i32x4_splat(NULL_I32), vs = wasm_i64x2_splat(0);
+  v128_t vn = wasm_i32x4_splat(0), v, m;
+
+  for (; i + 4 <= len; i += 4) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i32x4_ne(v, nul);
+    v = wasm_v128_and(v, m);
+    vs = wasm_i64x2_add(vs, wasm_i64x2_extend_low_i32x4(v));
+    vs = wasm_i64x2_add(vs, wasm_i64x2_extend_high_i32x4(v));
+    vn = wasm_i32x4_sub(vn, m);
+  }
+  s = wasm_i64x2_extract_lane(vs, 0) + wasm_i64x2_extract_lane(vs, 1);
+  n = (i64_t)wasm_i32x4_extract_lane(vn, 0) + wasm_i32x4_extract_lane(vn, 1) +
+      wasm_i32x4_extract_lane(vn, 2) + wasm_i32x4_extract_lane(vn, 3);
+#endif
+  for (; i < len; i++) {
+    if (x[i] != NULL_I32) {
+      s += x[i];
+      n++;
+    }
+  }
+  a->i = s;
+  a->n = n;
 }
 
-// Get row by index
-EMSCRIPTEN_KEEPALIVE obj_p table_row(obj_p t, i64_t idx) {
-  if (t == NULL || t->type != TYPE_TABLE)
-    return NULL_OBJ;
-  return at_idx(t, idx);
+static nil_t kern_minmax_i32(const i32_t *x, i64_t len, b8_t max,
+                             kern_acc_t *a) {
+  i64_t i = 0, n = 0;
+  i32_t r = max ? INT32_MIN : INT32_MAX;
+#ifdef __wasm_simd128__
+  v128_t nul = wasm_i32x4_splat(NULL_I32), id = wasm_i32x4_splat(r);
+  v128_t vr = id, vn = wasm_i32x4_splat(0), v, m;
+  i32_t l[4], j;
+
+  for (; i + 4 <= len; i += 4) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i32x4_ne(v, nul);
+    v = wasm_v128_bitselect(v, id, m);
+    vr = max ? wasm_i32x4_max(vr, v) : wasm_i32x4_min(vr, v);
+    vn = wasm_i32x4_sub(vn, m);
+  }
+  wasm_v128_store(l, vr);
+  for (j = 0; j < 4; j++)
+    if (max ? l[j] > r : l[j] < r)
+      r = l[j];
+  wasm_v128_store(l, vn);
+  n = (i64_t)l[0] + l[1] + l[2] + l[3];
+#endif
+  for (; i < len; i++) {
+    if (x[i] == NULL_I32)
+      continue;
+    if (max ? x[i] > r : x[i] < r)
+      r = x[i];
+    n++;
+  }
+  a->i = r;
+  a->n = n;
 }
 
-// Get table row count
-EMSCRIPTEN_KEEPALIVE i64_t table_count(obj_p t) {
-  if (t == NULL || t->type != TYPE_TABLE)
-    return 0;
-  obj_p vals = AS_LIST(t)[1];
-  if (vals == NULL || vals->len == 0)
-    return 0;
-  obj_p first_col = AS_LIST(vals)[0];
-  return first_col ? first_col->len : 0;
+static nil_t kern_sum_f64(const f64_t *x, i64_t len, kern_acc_t *a) {
+  i64_t i = 0, n = 0;
+  f64_t s = 0;
+#ifdef __wasm_simd128__
+  v128_t abs = wasm_i64x2_splat(INT64_MAX), inf = wasm_i64x2_splat(KERN_F64_INF);
+  v128_t vs = wasm_f64x2_splat(0), vn = wasm_i64x2_splat(0), v, m;
+
+  for (; i + 2 <= len; i += 2) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i64x2_le(wasm_v128_and(v, abs), inf);
+    vs = wasm_f64x2_add(vs, wasm_v128_and(v, m));
+    vn = wasm_i64x2_sub(vn, m);
+  }
+  s = wasm_f64x2_extract_lane(vs, 0) + wasm_f64x2_extract_lane(vs, 1);
+  n = wasm_i64x2_extract_lane(vn, 0) + wasm_i64x2_extract_lane(vn, 1);
+#endif
+  for (; i < len; i++) {
+    if (!kern_f64_null(x[i])) {
+      s += x[i];
+      n++;
+    }
+  }
+  a->f = s;
+  a->n = n;
 }
 
-// ============================================================================
-// Query Operations
-// ============================================================================
+static nil_t kern_minmax_f64(const f64_t *x, i64_t len, b8_t max,
+                             kern_acc_t *a) {
+  i64_t i = 0, n = 0;
+  f64_t r;
+#ifdef __wasm_simd128__
+  v128_t abs = wasm_i64x2_splat(INT64_MAX), inf = wasm_i64x2_splat(KERN_F64_INF);
+  v128_t id, vr, vn = wasm_i64x2_splat(0), v, m;
+  f64_t l;
+  i32_t j;
+#endif
+
+  // Seed with the first non-null element: a +-DBL_MAX identity caps columns
+  // of infinities, and -ffinite-math-only rules out infinite constants
+  while (i < len && kern_f64_null(x[i]))
+    i++;
+  if (i == len) {
+    a->f = 0;
+    a->n = 0;
+    return;
+  }
+  r = x[i++];
+  n = 1;
+
+#ifdef __wasm_simd128__
+  // Null lanes take the seed, which leaves the result unchanged
+  id = wasm_f64x2_splat(r);
+  vr = id;
+
+  for (; i + 2 <= len; i += 2) {
+    v = wasm_v128_load(x + i);
+    m = wasm_i64x2_le(wasm_v128_and(v, abs), inf);
+    v = wasm_v128_bitselect(v, id, m);
+    vr = max ? wasm_f64x2_max(vr, v) : wasm_f64x2_min(vr, v);
+    vn = wasm_i64x2_sub(vn, m);
+  }
+  for (j = 0; j < 2; j++) {
+    l = j == 0 ? wasm_f64x2_extract_lane(vr, 0) : wasm_f64x2_extract_lane(vr, 1);
+    if (max ? l > r : l < r)
+      r = l;
+  }
+  n += wasm_i64x2_extract_lane(vn, 0) + wasm_i64x2_extract_lane(vn, 1);
+#endif
+  for (; i < len; i++) {
+    if (kern_f64_null(x[i]))
+      continue;
+    if (max ? x[i] > r : x[i] < r)
+      r = x[i];
+    n++;
+  }
+  a->f = r;
+  a->n = n;
+}
 
-// Execute select query (takes dict as query)
-EMSCRIPTEN_KEEPALIVE obj_p query_select(obj_p query) {
-  if (query == NULL)
-    return NULL_OBJ;
-  return ray_select(query);
+static obj_p kern_int_atom(i8_t type, i64_t x) {
+  switch (type) {
+  case TYPE_I32:
+    return i32((i32_t)x);
+  case TYPE_DATE:
+    return adate((i32_t)x);
+  case TYPE_TIME:
+    return atime((i32_t)x);
+  case TYPE_TIMESTAMP:
+    return timestamp(x);
+  default:
+    return i64(x);
+  }
 }
 
-// Execute update query
-EMSCRIPTEN_KEEPALIVE obj_p query_update(obj_p query) {
-  if (query == NULL)
-    return NULL_OBJ;
-  return ray_update(query);
+// Reduce `v` one INTERRUPT_BLOCK at a time into `a`, merging the partial
+// results. B8_FALSE when interrupted.
+static b8_t kern_fold(obj_p v, i32_t op, kern_acc_t *a) {
+  kern_acc_t p;
+  b8_t minmax = op == KERN_MIN || op == KERN_MAX, max = op == KERN_MAX;
+  i64_t lo, n;
+
+  for (lo = 0; lo < v->len; lo += n) {
+    if (lo > 0 && interrupted())
+      return B8_FALSE;
+    n = v->len - lo < INTERRUPT_BLOCK ? v->len - lo : INTERRUPT_BLOCK;
+    p.n = 0;
+    p.i = 0;
+    p.f = 0;
+
+    switch (v->type) {
+    case TYPE_F64:
+      if (minmax)
+        kern_minmax_f64(AS_F64(v) + lo, n, max, &p);
+      else
+        kern_sum_f64(AS_F64(v) + lo, n, &p);
+      break;
+    case TYPE_I32:
+    case TYPE_DATE:
+    case TYPE_TIME:
+      if (minmax)
+        kern_minmax_i32(AS_I32(v) + lo, n, max, &p);
+      else
+        kern_sum_i32(AS_I32(v) + lo, n, &p);
+      break;
+    default: // I64, TIMESTAMP
+      if (minmax)
+        kern_minmax_i64(AS_I64(v) + lo, n, max, &p);
+      else
+        kern_sum_i64(AS_I64(v) + lo, n, &p);
+    }
+
+    if (p.n == 0)
+      continue;
+    if (!minmax) {
+      a->i += p.i;
+      a->f += p.f;
+    } else if (a->n == 0 ||
+               (v->type == TYPE_F64 ? (max ? p.f > a->f : p.f < a->f)
+                                    : (max ? p.i > a->i : p.i < a->i))) {
+      a->i = p.i;
+      a->f = p.f;
+    }
+    a->n += p.n;
+  }
+  return B8_TRUE;
 }
 
-// Insert into table
-// Arguments: t = table, data = data to insert
-EMSCRIPTEN_KEEPALIVE obj_p table_insert(obj_p t, obj_p data) {
-  if (t == NULL || data == NULL)
+// Reduce a numeric vector with KERN_SUM .. KERN_AVG, skipping nulls. Sums
+// of I32 widen to I64 and avg is F64; min/max also take DATE, TIME and
+// TIMESTAMP and keep the type. An all-null input gives a null atom (sum 0).
+EMSCRIPTEN_KEEPALIVE obj_p kern_reduce(obj_p v, i32_t op) {
+  kern_acc_t a = {0, 0, 0};
+  b8_t minmax = op == KERN_MIN || op == KERN_MAX;
+  i8_t type;
+
+  if (v == NULL || IS_ATOM(v))
+    return err_user("Reduction expects a vector");
+  if (op < KERN_SUM || op > KERN_AVG)
+    return err_user("Unknown reduction");
+  type = v->type;
+
+  switch (type) {
+  case TYPE_I64:
+  case TYPE_TIMESTAMP:
+    if (!minmax && type != TYPE_I64)
+      break;
+    if (!kern_fold(v, op, &a))
+      return err_user("Interrupted");
+    if (op == KERN_AVG)
+      return f64(a.n > 0 ? (f64_t)a.i / a.n : NULL_F64);
+    return kern_int_atom(minmax ? type : TYPE_I64, minmax && a.n == 0 ? NULL_I64 : a.i);
+
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    if (!minmax && type != TYPE_I32)
+      break;
+    if (!kern_fold(v, op, &a))
+      return err_user("Interrupted");
+    if (op == KERN_AVG)
+      return f64(a.n > 0 ? (f64_t)a.i / a.n : NULL_F64);
+    if (!minmax)
+      return i64(a.i);
+    return kern_int_atom(type, a.n == 0 ? NULL_I32 : a.i);
+
+  case TYPE_F64:
+    if (!kern_fold(v, op, &a))
+      return err_user("Interrupted");
+    if (op == KERN_AVG)
+      return f64(a.n > 0 ? a.f / a.n : NULL_F64);
+    return f64(minmax && a.n == 0 ? NULL_F64 : a.f);
+  }
+
+  return err_user("Reduction expects an I64, I32 or F64 vector");
+}
+
+#ifdef __wasm_simd128__
+// Lane masks of 16 elements (four i32x4) as 16 bytes of 0 / 1
+static v128_t kern_pack32(v128_t a, v128_t b, v128_t c, v128_t d) {
+  return wasm_v128_and(wasm_i8x16_narrow_i16x8(wasm_i16x8_narrow_i32x4(a, b),
+                                               wasm_i16x8_narrow_i32x4(c, d)),
+                       wasm_i8x16_splat(1));
+}
+
+// Two i64x2 lane masks as one i32x4
+static v128_t kern_pack64(v128_t a, v128_t b) {
+  return wasm_i32x4_shuffle(a, b, 0, 2, 4, 6);
+}
+
+static v128_t kern_cmp_i64x2(v128_t v, v128_t b, i32_t op) {
+  switch (op) {
+  case KERN_EQ:
+    return wasm_i64x2_eq(v, b);
+  case KERN_NE:
+    return wasm_i64x2_ne(v, b);
+  case KERN_LT:
+    return wasm_i64x2_lt(v, b);
+  case KERN_LE:
+    return wasm_i64x2_le(v, b);
+  case KERN_GT:
+    return wasm_i64x2_gt(v, b);
+  default:
+    return wasm_i64x2_ge(v, b);
+  }
+}
+
+static v128_t kern_cmp_i32x4(v128_t v, v128_t b, i32_t op) {
+  switch (op) {
+  case KERN_EQ:
+    return wasm_i32x4_eq(v, b);
+  case KERN_NE:
+    return wasm_i32x4_ne(v, b);
+  case KERN_LT:
+    return wasm_i32x4_lt(v, b);
+  case KERN_LE:
+    return wasm_i32x4_le(v, b);
+  case KERN_GT:
+    return wasm_i32x4_gt(v, b);
+  default:
+    return wasm_i32x4_ge(v, b);
+  }
+}
+
+static v128_t kern_cmp_f64x2(v128_t v, v128_t b, i32_t op) {
+  switch (op) {
+  case KERN_EQ:
+    return wasm_f64x2_eq(v, b);
+  case KERN_NE:
+    return wasm_f64x2_ne(v, b);
+  case KERN_LT:
+    return wasm_f64x2_lt(v, b);
+  case KERN_LE:
+    return wasm_f64x2_le(v, b);
+  case KERN_GT:
+    return wasm_f64x2_gt(v, b);
+  default:
+    return wasm_f64x2_ge(v, b);
+  }
+}
+#endif
+
+#define KERN_CMP(x, b, op)                                                     \
+  ((op) == KERN_EQ   ? (x) == (b)                                              \
+   : (op) == KERN_NE ? (x) != (b)                                              \
+   : (op) == KERN_LT ? (x) < (b)                                               \
+   : (op) == KERN_LE ? (x) <= (b)                                              \
+   : (op) == KERN_GT ? (x) > (b)                                               \
+                     : (x) >= (b))
+
+static nil_t kern_cmp_i64(const i64_t *x, i64_t len, i32_t op, i64_t b,
+                          u8_t *out) {
+  i64_t i = 0;
+#ifdef __wasm_simd128__
+  v128_t vb = wasm_i64x2_splat(b), q[4];
+  i32_t k;
+
+  for (; i + 16 <= len; i += 16) {
+    for (k = 0; k < 4; k++)
+      q[k] = kern_pack64(kern_cmp_i64x2(wasm_v128_load(x + i + k * 4), vb, op),
+                         kern_cmp_i64x2(wasm_v128_load(x + i + k * 4 + 2), vb, op));
+    wasm_v128_store(out + i, kern_pack32(q[0], q[1], q[2], q[3]));
+  }
+#endif
+  for (; i < len; i++)
+    out[i] = KERN_CMP(x[i], b, op);
+}
+
+static nil_t kern_cmp_i32(const i32_t *x, i64_t len, i32_t op, i32_t b,
+                          u8_t *out) {
+  i64_t i = 0;
+#ifdef __wasm_simd128__
+  v128_t vb = wasm_i32x4_splat(b), q[4];
+  i32_t k;
+
+  for (; i + 16 <= len; i += 16) {
+    for (k = 0; k < 4; k++)
+      q[k] = kern_cmp_i32x4(wasm_v128_load(x + i + k * 4), vb, op);
+    wasm_v128_store(out + i, kern_pack32(q[0], q[1], q[2], q[3]));
+  }
+#endif
+  for (; i < len; i++)
+    out[i] = KERN_CMP(x[i], b, op);
+}
+
+static nil_t kern_cmp_f64(const f64_t *x, i64_t len, i32_t op, f64_t b,
+                          u8_t *out) {
+  i64_t i = 0;
+#ifdef __wasm_simd128__
+  v128_t vb = wasm_f64x2_splat(b), q[4];
+  i32_t k;
+
+  for (; i + 16 <= len; i += 16) {
+    for (k = 0; k < 4; k++)
+      q[k] = kern_pack64(kern_cmp_f64x2(wasm_v128_load(x + i + k * 4), vb, op),
+                         kern_cmp_f64x2(wasm_v128_load(x + i + k * 4 + 2), vb, op));
+    wasm_v128_store(out + i, kern_pack32(q[0], q[1], q[2], q[3]));
+  }
+#endif
+  for (; i < len; i++)
+    out[i] = KERN_CMP(x[i], b, op);
+}
+
+// Rewrite `x <op> t` over integers in [lo, hi] as an integer test. Returns
+// 0 / 1 when every element compares the same way, else -1 with *op and *b
+// set (fractional thresholds round towards the side that keeps the result).
+static i32_t kern_int_bound(obj_p t, i64_t lo, i64_t hi, i32_t *op, i64_t *b) {
+  f64_t f;
+  i64_t k;
+  i32_t side = 0;
+
+  switch (t->type) {
+  case -TYPE_I64:
+  case -TYPE_TIMESTAMP:
+    k = t->i64;
+    break;
+  case -TYPE_I32:
+  case -TYPE_DATE:
+  case -TYPE_TIME:
+    k = t->i32;
+    break;
+  case -TYPE_I16:
+    k = t->i16;
+    break;
+  default: // -TYPE_F64
+    f = t->f64;
+    if (!(f > -9.2e18 && f < 9.2e18)) {
+      side = f < 0 ? -1 : 1;
+      k = 0;
+      break;
+    }
+    k = (i64_t)f;
+    if ((f64_t)k != f) {
+      if (*op == KERN_EQ || *op == KERN_NE)
+        return *op == KERN_NE;
+      if (*op == KERN_LT || *op == KERN_LE) {
+        *op = KERN_LE;
+        k -= f < 0; // floor
+      } else {
+        *op = KERN_GE;
+        k += f > 0; // ceil
+      }
+    }
+  }
+
+  if (side == 0 && k > hi)
+    side = 1;
+  if (side == 0 && k < lo)
+    side = -1;
+  if (side != 0) {
+    if (*op == KERN_EQ || *op == KERN_NE)
+      return *op == KERN_NE;
+    return (*op == KERN_LT || *op == KERN_LE) == (side > 0);
+  }
+  *b = k;
+  return -1;
+}
+
+// Compare every element with the atom `t` (KERN_EQ .. KERN_GE) into a B8
+// mask. Integer and temporal vectors take integer or F64 atoms, F64 vectors
+// any numeric atom. Nulls compare as stored (the smallest integer, NaN).
+EMSCRIPTEN_KEEPALIVE obj_p kern_compare(obj_p v, i32_t op, obj_p t) {
+  obj_p out;
+  i64_t b = 0, lo, n;
+  i32_t c = -1;
+  f64_t f;
+
+  if (v == NULL || t == NULL || IS_ATOM(v) || !IS_ATOM(t))
+    return err_user("Comparison expects a vector and an atom");
+  if (op < KERN_EQ || op > KERN_GE)
+    return err_user("Unknown comparison");
+  if (t->type != -TYPE_I64 && t->type != -TYPE_I32 && t->type != -TYPE_I16 &&
+      t->type != -TYPE_F64 && t->type != -TYPE_DATE && t->type != -TYPE_TIME &&
+      t->type != -TYPE_TIMESTAMP)
+    return err_user("Comparison expects a numeric atom");
+
+  switch (v->type) {
+  case TYPE_I64:
+  case TYPE_TIMESTAMP:
+    c = kern_int_bound(t, INT64_MIN, INT64_MAX, &op, &b);
+    break;
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    c = kern_int_bound(t, INT32_MIN, INT32_MAX, &op, &b);
+    break;
+  case TYPE_F64:
+    break;
+  default:
+    return err_user("Comparison expects an I64, I32 or F64 vector");
+  }
+
+  out = vector(TYPE_B8, v->len);
+  if (out == NULL)
+    return err_user("Failed to allocate mask");
+  if (c >= 0) {
+    memset(AS_U8(out), c, v->len);
+    return out;
+  }
+
+  f = t->type == -TYPE_F64   ? t->f64
+      : t->type == -TYPE_I64 || t->type == -TYPE_TIMESTAMP ? (f64_t)t->i64
+      : t->type == -TYPE_I16 ? (f64_t)t->i16
+                             : (f64_t)t->i32;
+  for (lo = 0; lo < v->len; lo += n) {
+    if (lo > 0 && interrupted()) {
+      drop_obj(out);
+      return err_user("Interrupted");
+    }
+    n = v->len - lo < INTERRUPT_BLOCK ? v->len - lo : INTERRUPT_BLOCK;
+    switch (v->type) {
+    case TYPE_F64:
+      kern_cmp_f64(AS_F64(v) + lo, n, op, f, AS_U8(out) + lo);
+      break;
+    case TYPE_I64:
+    case TYPE_TIMESTAMP:
+      kern_cmp_i64(AS_I64(v) + lo, n, op, b, AS_U8(out) + lo);
+      break;
+    default:
+      kern_cmp_i32(AS_I32(v) + lo, n, op, (i32_t)b, AS_U8(out) + lo);
+    }
+  }
+  return out;
+}
+
+static i64_t kern_mask_count(const u8_t *m, i64_t len) {
+  i64_t i = 0, n = 0;
+#ifdef __wasm_simd128__
+  v128_t zero = wasm_i8x16_splat(0);
+
+  for (; i + 16 <= len; i += 16)
+    n += __builtin_popcount(
+        wasm_i8x16_bitmask(wasm_i8x16_ne(wasm_v128_load(m + i), zero)));
+#endif
+  for (; i < len; i++)
+    n += m[i] != 0;
+  return n;
+}
+
+// Copy element `i` of `size` bytes; fixed sizes so memcpy is inlined
+static nil_t kern_put(u8_t *dst, const u8_t *src, i64_t i, i64_t size) {
+  switch (size) {
+  case 8:
+    memcpy(dst, src + i * 8, 8);
+    break;
+  case 4:
+    memcpy(dst, src + i * 4, 4);
+    break;
+  case 2:
+    memcpy(dst, src + i * 2, 2);
+    break;
+  case 1:
+    *dst = src[i];
+    break;
+  default:
+    memcpy(dst, src + i * size, size);
+  }
+}
+
+// Elements of a fixed-width vector where the B8 `mask` (same length) is set,
+// in order. Mask blocks of 16 that are all clear or all set cost one test.
+EMSCRIPTEN_KEEPALIVE obj_p kern_compact(obj_p v, obj_p mask) {
+  obj_p out;
+  const u8_t *m, *src;
+  u8_t *dst;
+  i64_t i = 0, hi, size;
+#ifdef __wasm_simd128__
+  v128_t zero = wasm_i8x16_splat(0);
+  u32_t bits;
+#endif
+
+  if (v == NULL || mask == NULL || IS_ATOM(v) || v->type == TYPE_LIST)
+    return err_user("Compaction expects a fixed-width vector");
+  if (mask->type != TYPE_B8 || mask->len != v->len)
+    return err_user("Compaction mask must be a B8 vector of the same length");
+  size = get_element_size(v->type);
+  if (size == 0)
+    return err_user("Compaction expects a fixed-width vector");
+
+  m = AS_U8(mask);
+  out = vector(v->type, kern_mask_count(m, v->len));
+  if (out == NULL)
+    return err_user("Failed to allocate compacted vector");
+  src = (const u8_t *)AS_C8(v);
+  dst = (u8_t *)AS_C8(out);
+
+  while (i < v->len) {
+    if (i > 0 && interrupted()) {
+      drop_obj(out);
+      return err_user("Interrupted");
+    }
+    hi = v->len - i < INTERRUPT_BLOCK ? v->len : i + INTERRUPT_BLOCK;
+#ifdef __wasm_simd128__
+    for (; i + 16 <= hi; i += 16) {
+      bits = wasm_i8x16_bitmask(wasm_i8x16_ne(wasm_v128_load(m + i), zero));
+      if (bits == 0)
+        continue;
+      if (bits == 0xFFFF) {
+        memcpy(dst, src + i * size, 16 * size);
+        dst += 16 * size;
+        continue;
+      }
+      while (bits != 0) {
+        kern_put(dst, src, i + __builtin_ctz(bits), size);
+        dst += size;
+        bits &= bits - 1;
+      }
+    }
+#endif
+    for (; i < hi; i++) {
+      if (m[i] != 0) {
+        kern_put(dst, src, i, size);
+        dst += size;
+      }
+    }
+  }
+  return out;
+}
+
+// 1 when the kernels above were compiled with -msimd128 (see WASM_SIMD)
+EMSCRIPTEN_KEEPALIVE i32_t kern_simd(nil_t) {
+#ifdef __wasm_simd128__
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+// ============================================================================
+// Temporal Conversion
+// ============================================================================
+
+// Bulk conversion between DATE/TIME/TIMESTAMP vectors and Unix epoch
+// milliseconds in one pass, for charting code that would otherwise build a
+// Date per element. TIME is milliseconds since midnight in both directions.
+// Nulls map to NaN (f64) or NULL_I64 (i64) and back.
+
+#define TEMPORAL_DAY_MS 86400000LL
+#define TEMPORAL_DATE_SHIFT 10957         // days 1970-01-01 .. 2000-01-01
+#define TEMPORAL_MS_SHIFT 946684800000LL  // ms 1970-01-01 .. 2000-01-01
+#define TEMPORAL_MAX_MS 8200000000000.0   // ~260 years each way fit i64 ns
+
+// Floor of a finite f64 known to fit an i64
+static i64_t temporal_floor(f64_t x) {
+  i64_t w = (i64_t)x;
+  return (f64_t)w > x ? w - 1 : w;
+}
+
+// Floor division for the negative side of the epoch
+static i64_t temporal_div(i64_t a, i64_t b) {
+  i64_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Epoch ms of a vector into `out` (len elements); -1 for other types
+EMSCRIPTEN_KEEPALIVE i64_t temporal_to_ms_f64(obj_p v, f64_t *out) {
+  i64_t i, q;
+  const i32_t *d;
+  const i64_t *t;
+
+  if (v == NULL || IS_ATOM(v))
+    return -1;
+
+  switch (v->type) {
+  case TYPE_DATE:
+    d = AS_I32(v);
+    for (i = 0; i < v->len; i++)
+      out[i] = d[i] == NULL_I32
+                   ? NULL_F64
+                   : (f64_t)(d[i] + TEMPORAL_DATE_SHIFT) * TEMPORAL_DAY_MS;
+    return v->len;
+  case TYPE_TIME:
+    d = AS_I32(v);
+    for (i = 0; i < v->len; i++)
+      out[i] = d[i] == NULL_I32 ? NULL_F64 : (f64_t)d[i];
+    return v->len;
+  case TYPE_TIMESTAMP:
+    // Whole ms and the ns remainder separately, so sub-ms digits survive
+    t = AS_I64(v);
+    for (i = 0; i < v->len; i++) {
+      if (t[i] == NULL_I64) {
+        out[i] = NULL_F64;
+        continue;
+      }
+      q = temporal_div(t[i], 1000000);
+      out[i] = (f64_t)(q + TEMPORAL_MS_SHIFT) +
+               (f64_t)(t[i] - q * 1000000) / 1e6;
+    }
+    return v->len;
+  default:
+    return -1;
+  }
+}
+
+// Integer epoch ms (TIMESTAMP rounded down) into `out`; -1 for other types
+EMSCRIPTEN_KEEPALIVE i64_t temporal_to_ms_i64(obj_p v, i64_t *out) {
+  i64_t i;
+  const i32_t *d;
+  const i64_t *t;
+
+  if (v == NULL || IS_ATOM(v))
+    return -1;
+
+  switch (v->type) {
+  case TYPE_DATE:
+    d = AS_I32(v);
+    for (i = 0; i < v->len; i++)
+      out[i] = d[i] == NULL_I32
+                   ? NULL_I64
+                   : ((i64_t)d[i] + TEMPORAL_DATE_SHIFT) * TEMPORAL_DAY_MS;
+    return v->len;
+  case TYPE_TIME:
+    d = AS_I32(v);
+    for (i = 0; i < v->len; i++)
+      out[i] = d[i] == NULL_I32 ? NULL_I64 : (i64_t)d[i];
+    return v->len;
+  case TYPE_TIMESTAMP:
+    t = AS_I64(v);
+    for (i = 0; i < v->len; i++)
+      out[i] = t[i] == NULL_I64
+                   ? NULL_I64
+                   : temporal_div(t[i], 1000000) + TEMPORAL_MS_SHIFT;
+    return v->len;
+  default:
+    return -1;
+  }
+}
+
+// DATE/TIME/TIMESTAMP vector of `n` epoch ms; NaN and values out of the
+// type's range become nulls
+EMSCRIPTEN_KEEPALIVE obj_p temporal_from_ms_f64(i32_t type, const f64_t *ms,
+                                                i64_t n) {
+  obj_p v;
+  i64_t i, w;
+  i32_t *d;
+  i64_t *t;
+
+  if (type != TYPE_DATE && type != TYPE_TIME && type != TYPE_TIMESTAMP)
+    return err_user("Epoch conversion needs DATE, TIME or TIMESTAMP");
+
+  v = vector((i8_t)type, n);
+  if (IS_ERR(v))
+    return v;
+
+  if (type == TYPE_TIMESTAMP) {
+    t = AS_I64(v);
+    for (i = 0; i < n; i++) {
+      if (kern_f64_null(ms[i]) || ms[i] > TEMPORAL_MAX_MS ||
+          ms[i] < -TEMPORAL_MAX_MS) {
+        t[i] = NULL_I64;
+        continue;
+      }
+      w = temporal_floor(ms[i]);
+      t[i] = (w - TEMPORAL_MS_SHIFT) * 1000000 +
+             (i64_t)(((ms[i] - (f64_t)w) * 1e6) + 0.5);
+    }
+    return v;
+  }
+
+  d = AS_I32(v);
+  for (i = 0; i < n; i++) {
+    if (kern_f64_null(ms[i]) || ms[i] > TEMPORAL_MAX_MS ||
+        ms[i] < -TEMPORAL_MAX_MS) {
+      d[i] = NULL_I32;
+      continue;
+    }
+    w = temporal_floor(ms[i]);
+    if (type == TYPE_DATE)
+      w = temporal_div(w, TEMPORAL_DAY_MS) - TEMPORAL_DATE_SHIFT;
+    d[i] = (i64_t)(i32_t)w == w ? (i32_t)w : NULL_I32;
+  }
+  return v;
+}
+
+// Same from integer epoch ms; NULL_I64 becomes null
+EMSCRIPTEN_KEEPALIVE obj_p temporal_from_ms_i64(i32_t type, const i64_t *ms,
+                                                i64_t n) {
+  obj_p v;
+  i64_t i, w;
+  i32_t *d;
+  i64_t *t;
+
+  if (type != TYPE_DATE && type != TYPE_TIME && type != TYPE_TIMESTAMP)
+    return err_user("Epoch conversion needs DATE, TIME or TIMESTAMP");
+
+  v = vector((i8_t)type, n);
+  if (IS_ERR(v))
+    return v;
+
+  if (type == TYPE_TIMESTAMP) {
+    t = AS_I64(v);
+    for (i = 0; i < n; i++)
+      t[i] = ms[i] == NULL_I64 || ms[i] > (i64_t)TEMPORAL_MAX_MS ||
+                     ms[i] < -(i64_t)TEMPORAL_MAX_MS
+                 ? NULL_I64
+                 : (ms[i] - TEMPORAL_MS_SHIFT) * 1000000;
+    return v;
+  }
+
+  d = AS_I32(v);
+  for (i = 0; i < n; i++) {
+    if (ms[i] == NULL_I64) {
+      d[i] = NULL_I32;
+      continue;
+    }
+    w = type == TYPE_DATE
+            ? temporal_div(ms[i], TEMPORAL_DAY_MS) - TEMPORAL_DATE_SHIFT
+            : ms[i];
+    d[i] = (i64_t)(i32_t)w == w ? (i32_t)w : NULL_I32;
+  }
+  return v;
+}
+
+// ============================================================================
+// Dict Operations
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE obj_p init_dict(obj_p keys, obj_p vals) {
+  return dict(keys, vals);
+}
+
+// Get dict keys
+EMSCRIPTEN_KEEPALIVE obj_p dict_keys(obj_p d) {
+  if (d == NULL || d->type != TYPE_DICT)
     return NULL_OBJ;
-  obj_p args[2] = {t, data};
-  return ray_insert(args, 2);
+  return clone_obj(AS_LIST(d)[0]);
+}
+
+// Get dict values
+EMSCRIPTEN_KEEPALIVE obj_p dict_vals(obj_p d) {
+  if (d == NULL || d->type != TYPE_DICT)
+    return NULL_OBJ;
+  return clone_obj(AS_LIST(d)[1]);
+}
+
+// Get value by key
+EMSCRIPTEN_KEEPALIVE obj_p dict_get(obj_p d, obj_p key) {
+  if (d == NULL || d->type != TYPE_DICT)
+    return NULL_OBJ;
+  return at_obj(d, key);
+}
+
+// ============================================================================
+// Table Operations
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE obj_p init_table(obj_p cols, obj_p vals) {
+  return table(cols, vals);
+}
+
+// Build a whole table in one call from staged column buffers
+// - `names`/`name_offs`: packed UTF-8 column names (ncols + 1 offsets)
+// - `types[i]`: column type; `datas[i]`: raw column bytes for fixed-width
+//   types, or packed UTF-8 strings for TYPE_SYMBOL with `sym_offs[i]`
+//   holding rows + 1 offsets (`sym_offs` may be NULL without symbols)
+// `rows` comes last: without WASM_BIGINT an i64 parameter takes two wasm
+// slots, which only lines up with the JS arguments at the end of the list
+EMSCRIPTEN_KEEPALIVE obj_p init_table_bulk(i32_t ncols, lit_p names,
+                                           i32_t *name_offs, i8_t *types,
+                                           raw_p *datas, i32_t **sym_offs,
+                                           i64_t rows) {
+  obj_p keys, vals, col, t;
+  lit_p err;
+  i64_t i;
+
+  if (ncols <= 0 || rows < 0 || names == NULL || name_offs == NULL ||
+      types == NULL || datas == NULL)
+    return err_user("Invalid bulk table arguments");
+
+  keys = vector(TYPE_SYMBOL, ncols);
+  vals = LIST(ncols);
+  if (keys == NULL || vals == NULL) {
+    if (keys != NULL)
+      drop_obj(keys);
+    if (vals != NULL) {
+      vals->len = 0;
+      drop_obj(vals);
+    }
+    return err_user("Failed to allocate table structure");
+  }
+
+  fill_symbol_vec(keys, names, name_offs, ncols);
+
+  for (i = 0; i < ncols; i++) {
+    err = NULL;
+    col = NULL;
+    if (types[i] == TYPE_SYMBOL && (sym_offs == NULL || sym_offs[i] == NULL))
+      err = "Symbol column without offsets";
+    else if (types[i] <= TYPE_LIST || get_element_size(types[i]) == 0)
+      err = "Unsupported bulk column type";
+    else if ((col = vector(types[i], rows)) == NULL)
+      err = "Failed to allocate column data - table too large for memory";
+
+    if (err != NULL) {
+      // Only the first i columns were built
+      vals->len = i;
+      drop_obj(keys);
+      drop_obj(vals);
+      return err_user(err);
+    }
+
+    if (types[i] == TYPE_SYMBOL)
+      fill_symbol_vec(col, datas[i], sym_offs[i], rows);
+    else
+      fill_vec(col, datas[i], rows);
+
+    AS_LIST(vals)[i] = col;
+  }
+
+  t = table(keys, vals);
+  if (t == NULL) {
+    drop_obj(keys);
+    drop_obj(vals);
+    return err_user("Failed to allocate table structure");
+  }
+  return t;
+}
+
+// Get table column names (symbol vector)
+EMSCRIPTEN_KEEPALIVE obj_p table_keys(obj_p t) {
+  if (t == NULL || t->type != TYPE_TABLE)
+    return NULL_OBJ;
+  return clone_obj(AS_LIST(t)[0]);
+}
+
+// Get table values (list of vectors)
+EMSCRIPTEN_KEEPALIVE obj_p table_vals(obj_p t) {
+  if (t == NULL || t->type != TYPE_TABLE)
+    return NULL_OBJ;
+  return clone_obj(AS_LIST(t)[1]);
+}
+
+// Get column by name
+EMSCRIPTEN_KEEPALIVE obj_p table_col(obj_p t, lit_p col_name, i64_t len) {
+  if (t == NULL || t->type != TYPE_TABLE)
+    return NULL_OBJ;
+  obj_p sym = symbol(col_name, len);
+  obj_p result = at_obj(t, sym);
+  drop_obj(sym);
+  return result;
+}
+
+// Get row by index
+EMSCRIPTEN_KEEPALIVE obj_p table_row(obj_p t, i64_t idx) {
+  if (t == NULL || t->type != TYPE_TABLE)
+    return NULL_OBJ;
+  return at_idx(t, idx);
+}
+
+// Get table row count
+EMSCRIPTEN_KEEPALIVE i64_t table_count(obj_p t) {
+  if (t == NULL || t->type != TYPE_TABLE)
+    return 0;
+  obj_p vals = AS_LIST(t)[1];
+  if (vals == NULL || vals->len == 0)
+    return 0;
+  obj_p first_col = AS_LIST(vals)[0];
+  return first_col ? first_col->len : 0;
+}
+
+// ============================================================================
+// Result Cache
+// ============================================================================
+
+// query_select results kept in an LRU bounded by RESULT_CACHE_SLOTS and a
+// byte budget (0, the default, disables it). Entries are keyed by the
+// serialized query without its `from` table plus the table itself. An entry
+// holds a reference to that table, so its address names one version of it:
+// table_insert, table_upsert and query_update evict a table's entries before
+// changing it. Queries whose `from` is not a table (a symbol naming a global)
+// are not cached. The cache keeps a private copy of each result and hands
+// out fresh copies, so callers writing to theirs cannot corrupt it. Entries
+// are charged for their key and result, and one entry per table also for
+// the table it keeps alive.
+#define RESULT_CACHE_SLOTS 64
+
+typedef struct result_entry_t {
+  u64_t hash;
+  obj_p key;   // ser_obj of the query minus `from` (U8 vector)
+  obj_p table; // held `from` table
+  obj_p result; // private copy
+  i64_t bytes;  // key and result
+  i64_t pinned; // result_bytes(table) on one entry per table, else 0
+  i64_t tick;   // last use, 0 for an empty slot
+} result_entry_t;
+
+// Counters since the last result_cache_clear. Doubles for HEAPF64, like
+// heap_stats_t.
+typedef struct result_cache_stats_t {
+  f64_t hits;
+  f64_t misses;
+  f64_t bypassed;      // not cacheable (no table in `from`, or disabled)
+  f64_t evictions;     // dropped for space
+  f64_t invalidations; // dropped because their table changed
+  f64_t entries;
+  f64_t bytes;
+  f64_t budget;
+} result_cache_stats_t;
+
+static result_entry_t __RESULTS[RESULT_CACHE_SLOTS];
+static i64_t __RESULTS_TICK = 0;
+static i64_t __RESULTS_BYTES = 0;
+static i64_t __RESULTS_BUDGET = 0;
+static result_cache_stats_t __RESULTS_STATS;
+
+// Approximate footprint of an object: headers plus vector data
+static i64_t result_bytes(obj_p r) {
+  i64_t i, n = (i64_t)sizeof(*r);
+
+  if (r == NULL || IS_ATOM(r))
+    return n;
+  switch (r->type) {
+  case TYPE_TABLE:
+  case TYPE_DICT:
+    return n + result_bytes(AS_LIST(r)[0]) + result_bytes(AS_LIST(r)[1]);
+  case TYPE_LIST:
+    for (i = 0; i < r->len; i++)
+      n += (i64_t)sizeof(obj_p) + result_bytes(AS_LIST(r)[i]);
+    return n;
+  default:
+    return n + get_data_byte_size(r);
+  }
+}
+
+// Deep copy of a result: vectors get their own data, so a caller's writes
+// never reach the cached copy. NULL when out of memory.
+static obj_p result_copy(obj_p r) {
+  obj_p out, a, b;
+  i64_t i;
+
+  if (r == NULL || IS_ATOM(r))
+    return clone_obj(r);
+  switch (r->type) {
+  case TYPE_TABLE:
+  case TYPE_DICT:
+    a = result_copy(AS_LIST(r)[0]);
+    b = a != NULL ? result_copy(AS_LIST(r)[1]) : NULL;
+    if (b == NULL) {
+      if (a != NULL)
+        drop_obj(a);
+      return NULL;
+    }
+    return r->type == TYPE_TABLE ? table(a, b) : dict(a, b);
+  case TYPE_LIST:
+    out = LIST(r->len);
+    if (out == NULL)
+      return NULL;
+    for (i = 0; i < r->len; i++) {
+      AS_LIST(out)[i] = result_copy(AS_LIST(r)[i]);
+      if (AS_LIST(out)[i] == NULL) {
+        out->len = i;
+        drop_obj(out);
+        return NULL;
+      }
+    }
+    return out;
+  default:
+    if (!IS_VECTOR(r))
+      return clone_obj(r);
+    out = vector(r->type, r->len);
+    if (out != NULL)
+      memcpy(AS_C8(out), AS_C8(r), get_data_byte_size(r));
+    return out;
+  }
+}
+
+// Position of the `from` entry of a query dict, -1 if it has none
+static i64_t query_from(obj_p query) {
+  obj_p keys;
+  i64_t i, id;
+
+  if (query == NULL || query->type != TYPE_DICT)
+    return -1;
+  keys = AS_LIST(query)[0];
+  if (keys->type != TYPE_SYMBOL || AS_LIST(query)[1]->type != TYPE_LIST)
+    return -1;
+  id = intern_symbol("from", 4);
+  for (i = 0; i < keys->len; i++)
+    if (AS_SYMBOL(keys)[i] == id)
+      return i;
+  return -1;
+}
+
+// Table a query reads, or NULL when `from` is missing or not a table
+static obj_p query_table(obj_p query) {
+  i64_t at = query_from(query);
+  obj_p t;
+
+  if (at < 0)
+    return NULL;
+  t = AS_LIST(AS_LIST(query)[1])[at];
+  return t != NULL && t->type == TYPE_TABLE ? t : NULL;
+}
+
+// Serialized query with its `from` value left out: the key list holds the
+// key vector, then every other value in order. NULL if it cannot be built.
+static obj_p result_key(obj_p query) {
+  obj_p vals = AS_LIST(query)[1], list, key;
+  i64_t i, j, at = query_from(query);
+
+  list = LIST(vals->len);
+  if (list == NULL)
+    return NULL;
+  AS_LIST(list)[0] = clone_obj(AS_LIST(query)[0]);
+  for (i = 0, j = 1; i < vals->len; i++)
+    if (i != at)
+      AS_LIST(list)[j++] = clone_obj(AS_LIST(vals)[i]);
+  key = ser_obj(list);
+  drop_obj(list);
+
+  if (key != NULL && IS_ERR(key)) {
+    drop_obj(key);
+    return NULL;
+  }
+  return key;
+}
+
+static nil_t result_entry_free(result_entry_t *e) {
+  i64_t i;
+
+  // Another entry over the same table takes over its charge
+  for (i = 0; e->pinned > 0 && i < RESULT_CACHE_SLOTS; i++) {
+    if (&__RESULTS[i] != e && __RESULTS[i].tick != 0 &&
+        __RESULTS[i].table == e->table) {
+      __RESULTS[i].pinned = e->pinned;
+      e->pinned = 0;
+    }
+  }
+  __RESULTS_BYTES -= e->bytes + e->pinned;
+  drop_obj(e->key);
+  drop_obj(e->table);
+  drop_obj(e->result);
+  memset(e, 0, sizeof(result_entry_t));
+}
+
+// Evict the least recently used entry; B8_FALSE when the cache is empty
+static b8_t result_cache_evict(nil_t) {
+  i64_t i, lru = -1;
+
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++)
+    if (__RESULTS[i].tick != 0 &&
+        (lru < 0 || __RESULTS[i].tick < __RESULTS[lru].tick))
+      lru = i;
+  if (lru < 0)
+    return B8_FALSE;
+  result_entry_free(&__RESULTS[lru]);
+  __RESULTS_STATS.evictions++;
+  return B8_TRUE;
+}
+
+// Bytes a new entry over `t` adds by holding it: the table's footprint,
+// unless another entry already holds (and is charged for) it
+static i64_t result_pinned(obj_p t) {
+  i64_t i;
+
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++)
+    if (__RESULTS[i].tick != 0 && __RESULTS[i].table == t)
+      return 0;
+  return result_bytes(t);
+}
+
+// Copy of the cached result for `key` over `t`, or NULL
+static obj_p result_cache_get(obj_p key, u64_t hash, obj_p t) {
+  i64_t i;
+  result_entry_t *e;
+
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++) {
+    e = &__RESULTS[i];
+    if (e->tick != 0 && e->hash == hash && e->table == t &&
+        e->key->len == key->len &&
+        memcmp(AS_U8(e->key), AS_U8(key), key->len) == 0) {
+      e->tick = ++__RESULTS_TICK;
+      return result_copy(e->result);
+    }
+  }
+  return NULL;
+}
+
+// Store a copy of `result` under `key` (taking the key), evicting down to
+// the budget
+static nil_t result_cache_put(obj_p key, u64_t hash, obj_p t, obj_p result) {
+  i64_t i, bytes = result_bytes(result) + key->len, pinned = result_pinned(t);
+  result_entry_t *e;
+  obj_p copy = NULL;
+
+  if (bytes + pinned <= __RESULTS_BUDGET) {
+    for (i = 0; i < RESULT_CACHE_SLOTS && __RESULTS[i].tick != 0; i++)
+      ;
+    if (i == RESULT_CACHE_SLOTS)
+      result_cache_evict();
+    // Evicting the last entry over `t` moves its charge to this one
+    pinned = result_pinned(t);
+    while (__RESULTS_BYTES + bytes + pinned > __RESULTS_BUDGET && result_cache_evict())
+      pinned = result_pinned(t);
+    if (__RESULTS_BYTES + bytes + pinned <= __RESULTS_BUDGET)
+      copy = result_copy(result);
+  }
+  if (copy == NULL) {
+    drop_obj(key);
+    return;
+  }
+  for (i = 0; __RESULTS[i].tick != 0; i++)
+    ;
+
+  e = &__RESULTS[i];
+  e->hash = hash;
+  e->key = key;
+  e->table = clone_obj(t);
+  e->result = copy;
+  e->bytes = bytes;
+  e->pinned = pinned;
+  e->tick = ++__RESULTS_TICK;
+  __RESULTS_BYTES += bytes + pinned;
+}
+
+// Evict the entries over table `t`, or every entry when `t` is NULL
+static nil_t result_cache_invalidate(obj_p t) {
+  i64_t i;
+
+  if (__RESULTS_BYTES == 0)
+    return;
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++) {
+    if (__RESULTS[i].tick != 0 && (t == NULL || __RESULTS[i].table == t)) {
+      result_entry_free(&__RESULTS[i]);
+      __RESULTS_STATS.invalidations++;
+    }
+  }
+}
+
+// Set the byte budget (0 disables caching) and evict down to it
+EMSCRIPTEN_KEEPALIVE nil_t result_cache_set_budget(i64_t bytes) {
+  __RESULTS_BUDGET = bytes > 0 ? bytes : 0;
+  while (__RESULTS_BYTES > __RESULTS_BUDGET && result_cache_evict())
+    ;
+}
+
+// Current counters, entry count and sizes
+EMSCRIPTEN_KEEPALIVE result_cache_stats_t *result_cache_stats(nil_t) {
+  i64_t i, n = 0;
+
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++)
+    n += __RESULTS[i].tick != 0;
+  __RESULTS_STATS.entries = (f64_t)n;
+  __RESULTS_STATS.bytes = (f64_t)__RESULTS_BYTES;
+  __RESULTS_STATS.budget = (f64_t)__RESULTS_BUDGET;
+  return &__RESULTS_STATS;
+}
+
+// Drop every cached result and reset the counters
+EMSCRIPTEN_KEEPALIVE nil_t result_cache_clear(nil_t) {
+  i64_t i;
+
+  for (i = 0; i < RESULT_CACHE_SLOTS; i++)
+    if (__RESULTS[i].tick != 0)
+      result_entry_free(&__RESULTS[i]);
+  memset(&__RESULTS_STATS, 0, sizeof(result_cache_stats_t));
+}
+
+// ============================================================================
+// Column Indexes
+// ============================================================================
+
+// Equality indexes over one SYMBOL, boolean, integer or temporal column of a
+// table. An ascending column is probed by binary search (INDEX_SORTED); any
+// other gets a hash of its distinct values, each chaining its rows in order
+// (INDEX_HASH), so the chains are also the groups of a `by`. An index holds
+// a reference to its table and follows table_insert / table_upsert to the
+// table they return: appended rows are folded in, anything else rebuilds it.
+#define INDEX_SORTED 1
+#define INDEX_HASH 2
+
+typedef struct col_index_t {
+  struct col_index_t *next; // live indexes, walked by index_follow
+  obj_p table;              // held reference
+  i64_t sym;                // column name, to find it again after a rebind
+  i64_t col;                // column position
+  i8_t type;
+  i32_t kind;
+  i64_t rows; // rows indexed so far
+  i64_t ngroups;
+  i64_t gcap;
+  i64_t *keys;   // ngroups distinct keys
+  i64_t *first;  // first row of each group
+  i64_t *last;   // last row of each group
+  i64_t *count;  // rows of each group
+  i64_t *link;   // next row of the same group, -1 at the end
+  i64_t lcap;
+  i32_t *slots;  // open addressing over 1-based group ids
+  i64_t scap;
+} *col_index_p;
+
+static col_index_p __INDEXES = NULL;
+
+static b8_t index_type_ok(i8_t type) {
+  switch (type) {
+  case TYPE_B8:
+  case TYPE_U8:
+  case TYPE_I16:
+  case TYPE_I32:
+  case TYPE_I64:
+  case TYPE_SYMBOL:
+  case TYPE_DATE:
+  case TYPE_TIME:
+  case TYPE_TIMESTAMP:
+    return B8_TRUE;
+  default:
+    return B8_FALSE;
+  }
+}
+
+// Element `i` widened to an order-preserving i64 (nulls sort first; F64 by
+// its bits with NaN lowest, for table_sort)
+static i64_t index_key(obj_p col, i64_t i) {
+  const u8_t *p = (const u8_t *)AS_C8(col);
+  i64_t k;
+
+  switch (col->type) {
+  case TYPE_B8:
+  case TYPE_U8:
+    return p[i];
+  case TYPE_I16:
+    return ((const i16_t *)p)[i];
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    return ((const i32_t *)p)[i];
+  case TYPE_F64:
+    if (kern_f64_null(((const f64_t *)p)[i]))
+      return NULL_I64;
+    memcpy(&k, p + i * 8, 8);
+    return k < 0 ? (i64_t)((u64_t)k ^ 0x7fffffffffffffffULL) : k;
+  default: // I64, TIMESTAMP, SYMBOL
+    return ((const i64_t *)p)[i];
+  }
+}
+
+// Stable ascending permutation of `n` keys (bottom-up merge sort).
+// B8_FALSE when interrupted.
+static b8_t index_argsort(const i64_t *k, i64_t *perm, i64_t *tmp, i64_t n) {
+  i64_t w, lo, mid, hi, i, j, o, done = 0, *a = perm, *b = tmp, *s;
+
+  for (i = 0; i < n; i++)
+    perm[i] = i;
+  for (w = 1; w < n; w *= 2) {
+    for (lo = 0; lo < n; lo += 2 * w) {
+      mid = lo + w < n ? lo + w : n;
+      hi = lo + 2 * w < n ? lo + 2 * w : n;
+      if ((done += hi - lo) >= INTERRUPT_BLOCK) {
+        done = 0;
+        if (interrupted())
+          return B8_FALSE;
+      }
+      i = lo;
+      j = mid;
+      o = lo;
+      while (i < mid && j < hi)
+        b[o++] = k[a[j]] < k[a[i]] ? a[j++] : a[i++];
+      while (i < mid)
+        b[o++] = a[i++];
+      while (j < hi)
+        b[o++] = a[j++];
+    }
+    s = a;
+    a = b;
+    b = s;
+  }
+  if (a != perm)
+    memcpy(perm, a, n * sizeof(i64_t));
+  return B8_TRUE;
+}
+
+// Rows `rows[0..n)` of a column, or NULL for unsupported column types
+static obj_p index_take(obj_p col, const i64_t *rows, i64_t n) {
+  obj_p out;
+  const u8_t *src;
+  u8_t *dst;
+  i64_t i, size;
+
+  if (col->type == TYPE_LIST) {
+    out = LIST(n);
+    if (out == NULL)
+      return NULL;
+    for (i = 0; i < n; i++)
+      AS_LIST(out)[i] = clone_obj(AS_LIST(col)[rows[i]]);
+    return out;
+  }
+
+  size = get_element_size(col->type);
+  if (IS_ATOM(col) || size == 0)
+    return NULL;
+  out = vector(col->type, n);
+  if (out == NULL)
+    return NULL;
+  src = (const u8_t *)AS_C8(col);
+  dst = (u8_t *)AS_C8(out);
+  for (i = 0; i < n; i++, dst += size)
+    kern_put(dst, src, rows[i], size);
+  return out;
+}
+
+// Rows `rows[0..n)` of a table
+static obj_p index_gather(obj_p t, const i64_t *rows, i64_t n) {
+  obj_p vals = AS_LIST(t)[1], out, col;
+  i64_t i;
+
+  out = LIST(vals->len);
+  if (out == NULL)
+    return err_user("Failed to allocate gathered table");
+  for (i = 0; i < vals->len; i++) {
+    col = index_take(AS_LIST(vals)[i], rows, n);
+    if (col == NULL) {
+      out->len = i;
+      drop_obj(out);
+      return err_user("Cannot gather rows of this column type");
+    }
+    AS_LIST(out)[i] = col;
+  }
+  return table(clone_obj(AS_LIST(t)[0]), out);
+}
+
+// Position of the column named `sym` in table `t`, -1 if absent
+static i64_t index_column(obj_p t, i64_t sym) {
+  obj_p keys = AS_LIST(t)[0];
+  i64_t i;
+
+  for (i = 0; i < keys->len; i++)
+    if (AS_SYMBOL(keys)[i] == sym)
+      return i;
+  return -1;
+}
+
+// Column of table `t` named by `name`, or NULL
+static obj_p index_named(obj_p t, lit_p name, i64_t len, i64_t *at) {
+  if (t == NULL || t->type != TYPE_TABLE || name == NULL)
+    return NULL;
+  *at = index_column(t, intern_symbol(name, len));
+  return *at < 0 ? NULL : AS_LIST(AS_LIST(t)[1])[*at];
+}
+
+// 1 when the vector is ascending (nulls first), 0 otherwise
+EMSCRIPTEN_KEEPALIVE i32_t vec_is_sorted(obj_p v) {
+  i64_t i;
+
+  if (v == NULL || IS_ATOM(v) || v->type == TYPE_SYMBOL ||
+      (!index_type_ok(v->type) && v->type != TYPE_F64))
+    return 0;
+  for (i = 1; i < v->len; i++)
+    if (index_key(v, i) < index_key(v, i - 1))
+      return 0;
+  return 1;
+}
+
+// Copy of the table ordered by column `name` (stable, ascending, nulls
+// first). Symbols order by id, which groups equal values but is not
+// alphabetical, so symbol columns are rejected.
+EMSCRIPTEN_KEEPALIVE obj_p table_sort(obj_p t, lit_p name, i64_t len) {
+  obj_p col, out;
+  i64_t i, at, n, *keys, *perm, *tmp;
+
+  col = index_named(t, name, len, &at);
+  if (col == NULL)
+    return err_user("Sort expects a table and one of its column names");
+  if (IS_ATOM(col) || col->type == TYPE_SYMBOL ||
+      (!index_type_ok(col->type) && col->type != TYPE_F64))
+    return err_user("Sort column must be boolean, numeric or temporal");
+
+  n = col->len;
+  keys = (i64_t *)malloc((n + 1) * sizeof(i64_t));
+  perm = (i64_t *)malloc((n + 1) * sizeof(i64_t));
+  tmp = (i64_t *)malloc((n + 1) * sizeof(i64_t));
+  if (keys == NULL || perm == NULL || tmp == NULL) {
+    free(keys);
+    free(perm);
+    free(tmp);
+    return err_user("Out of memory: failed to sort table");
+  }
+  for (i = 0; i < n; i++)
+    keys[i] = index_key(col, i);
+  out = index_argsort(keys, perm, tmp, n) ? index_gather(t, perm, n)
+                                          : err_user("Interrupted");
+  free(keys);
+  free(perm);
+  free(tmp);
+#ifdef ATTR_ASC
+  if (!IS_ERR(out))
+    AS_LIST(AS_LIST(out)[1])[at]->attrs |= ATTR_ASC;
+#endif
+  return out;
+}
+
+static u64_t index_hash(i64_t k) {
+  u64_t h = (u64_t)k * 0x9e3779b97f4a7c15ULL;
+  return h ^ (h >> 29);
+}
+
+static nil_t index_reset(col_index_p x) {
+  x->rows = 0;
+  x->ngroups = 0;
+  if (x->slots != NULL)
+    memset(x->slots, 0, x->scap * sizeof(i32_t));
+}
+
+static nil_t index_release(col_index_p x) {
+  free(x->keys);
+  free(x->first);
+  free(x->last);
+  free(x->count);
+  free(x->link);
+  free(x->slots);
+  if (x->table != NULL)
+    drop_obj(x->table);
+  free(x);
+}
+
+// Grow group storage and rehash so slots stay at most half full
+static b8_t index_grow(col_index_p x) {
+  i64_t g, cap = x->gcap ? x->gcap * 2 : 1024, scap = cap * 2;
+  u64_t h;
+  i64_t *p;
+  i32_t *slots;
+
+  if ((p = (i64_t *)realloc(x->keys, cap * sizeof(i64_t))) == NULL)
+    return B8_FALSE;
+  x->keys = p;
+  if ((p = (i64_t *)realloc(x->first, cap * sizeof(i64_t))) == NULL)
+    return B8_FALSE;
+  x->first = p;
+  if ((p = (i64_t *)realloc(x->last, cap * sizeof(i64_t))) == NULL)
+    return B8_FALSE;
+  x->last = p;
+  if ((p = (i64_t *)realloc(x->count, cap * sizeof(i64_t))) == NULL)
+    return B8_FALSE;
+  x->count = p;
+  slots = (i32_t *)calloc(scap, sizeof(i32_t));
+  if (slots == NULL)
+    return B8_FALSE;
+
+  for (g = 0; g < x->ngroups; g++) {
+    h = index_hash(x->keys[g]) & (scap - 1);
+    while (slots[h])
+      h = (h + 1) & (scap - 1);
+    slots[h] = (i32_t)(g + 1);
+  }
+
+  free(x->slots);
+  x->slots = slots;
+  x->scap = scap;
+  x->gcap = cap;
+  return B8_TRUE;
+}
+
+// Group of `k`, or -1 when it has none
+static i64_t index_group(col_index_p x, i64_t k) {
+  u64_t h;
+
+  if (x->scap == 0)
+    return -1;
+  h = index_hash(k) & (x->scap - 1);
+  while (x->slots[h]) {
+    if (x->keys[x->slots[h] - 1] == k)
+      return x->slots[h] - 1;
+    h = (h + 1) & (x->scap - 1);
+  }
+  return -1;
+}
+
+// Index the rows of the bound column past those already seen. A sorted
+// index whose new rows break the order turns into a hash index.
+static b8_t index_fold(col_index_p x) {
+  obj_p col = AS_LIST(AS_LIST(x->table)[1])[x->col];
+  i64_t i, g, k, cap, *link;
+  u64_t h;
+
+  if (x->kind == INDEX_SORTED) {
+    for (i = x->rows > 0 ? x->rows : 1; i < col->len; i++)
+      if (index_key(col, i) < index_key(col, i - 1))
+        break;
+    if (i >= col->len) {
+      x->rows = col->len;
+      return B8_TRUE;
+    }
+    x->kind = INDEX_HASH;
+    index_reset(x);
+  }
+
+  if (col->len > x->lcap) {
+    cap = x->lcap ? x->lcap : 1024;
+    while (cap < col->len)
+      cap *= 2;
+    link = (i64_t *)realloc(x->link, cap * sizeof(i64_t));
+    if (link == NULL)
+      return B8_FALSE;
+    x->link = link;
+    x->lcap = cap;
+  }
+
+  for (i = x->rows; i < col->len; i++) {
+    k = index_key(col, i);
+    g = index_group(x, k);
+    if (g < 0) {
+      if (x->ngroups * 2 >= x->scap && !index_grow(x))
+        return B8_FALSE;
+      g = x->ngroups++;
+      x->keys[g] = k;
+      x->first[g] = i;
+      x->count[g] = 0;
+      h = index_hash(k) & (x->scap - 1);
+      while (x->slots[h])
+        h = (h + 1) & (x->scap - 1);
+      x->slots[h] = (i32_t)(g + 1);
+    } else {
+      x->link[x->last[g]] = i;
+    }
+    x->last[g] = i;
+    x->link[i] = -1;
+    x->count[g]++;
+    x->rows = i + 1;
+  }
+  return B8_TRUE;
+}
+
+// Point the index at table `t` and bring it up to date: `append` when `t`
+// only has rows added past the old ones, otherwise rebuilt. B8_FALSE when
+// the column is gone or changed type (the index then stays unbound).
+static b8_t index_bind(col_index_p x, obj_p t, b8_t append) {
+  i64_t at;
+  obj_p col, old = x->table;
+
+  at = t != NULL && t->type == TYPE_TABLE ? index_column(t, x->sym) : -1;
+  col = at >= 0 ? AS_LIST(AS_LIST(t)[1])[at] : NULL;
+  x->table = col == NULL || IS_ATOM(col) || col->type != x->type ? NULL : clone_obj(t);
+  if (old != NULL)
+    drop_obj(old);
+  if (x->table == NULL)
+    return B8_FALSE;
+
+  x->col = at;
+  if (!append || col->len < x->rows) {
+    index_reset(x);
+    x->kind = vec_is_sorted(col) ? INDEX_SORTED : INDEX_HASH;
+  }
+  return index_fold(x);
+}
+
+// Rebind every index over `from` to `to` (the result of a table change)
+static nil_t index_follow(obj_p from, obj_p to, b8_t append) {
+  col_index_p x;
+
+  if (to == NULL || to->type != TYPE_TABLE)
+    return;
+  for (x = __INDEXES; x != NULL; x = x->next)
+    if (x->table == from)
+      index_bind(x, to, append);
+}
+
+// Build an index over column `name` of table `t`. NULL when the column is
+// missing or not SYMBOL/boolean/integer/temporal, or out of memory.
+EMSCRIPTEN_KEEPALIVE col_index_p index_new(obj_p t, lit_p name, i64_t len) {
+  col_index_p x;
+  obj_p col;
+  i64_t at;
+
+  col = index_named(t, name, len, &at);
+  if (col == NULL || IS_ATOM(col) || !index_type_ok(col->type))
+    return NULL;
+  x = (col_index_p)calloc(1, sizeof(struct col_index_t));
+  if (x == NULL)
+    return NULL;
+  x->sym = intern_symbol(name, len);
+  x->type = col->type;
+  if (!index_bind(x, t, B8_FALSE)) {
+    index_release(x);
+    return NULL;
+  }
+  x->next = __INDEXES;
+  __INDEXES = x;
+  return x;
+}
+
+// INDEX_SORTED or INDEX_HASH; 0 once its column left the table
+EMSCRIPTEN_KEEPALIVE i32_t index_kind(col_index_p x) {
+  return x != NULL && x->table != NULL ? x->kind : 0;
+}
+
+// Table the index currently covers (borrowed), NULL when unbound
+EMSCRIPTEN_KEEPALIVE obj_p index_source(col_index_p x) {
+  return x != NULL ? x->table : NULL;
+}
+
+// Rebuild the index from its table's current column, after writes made in
+// place (Vector views) that it cannot see. Returns index_kind().
+EMSCRIPTEN_KEEPALIVE i32_t index_rebuild(col_index_p x) {
+  if (x == NULL || x->table == NULL)
+    return 0;
+  index_bind(x, x->table, B8_FALSE);
+  return index_kind(x);
+}
+
+// Rows holding `key` (a symbol id or the widened value; the i64 null finds
+// the nulls of narrower types too) into a malloc'd array; returns the count
+// or -1 on failure
+static i64_t index_probe(col_index_p x, i64_t key, i64_t **out) {
+  obj_p col;
+  i64_t lo, hi, mid, n, i, r, g;
+
+  *out = NULL;
+  if (x == NULL || x->table == NULL)
+    return -1;
+  col = AS_LIST(AS_LIST(x->table)[1])[x->col];
+  if (key == NULL_I64 && x->type == TYPE_I16)
+    key = NULL_I16;
+  else if (key == NULL_I64 && (x->type == TYPE_I32 || x->type == TYPE_DATE ||
+                               x->type == TYPE_TIME))
+    key = NULL_I32;
+
+  if (x->kind == INDEX_SORTED) {
+    lo = 0;
+    hi = col->len;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (index_key(col, mid) < key)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    for (n = 0; lo + n < col->len && index_key(col, lo + n) == key; n++)
+      ;
+    *out = (i64_t *)malloc((n + 1) * sizeof(i64_t));
+    if (*out == NULL)
+      return -1;
+    for (i = 0; i < n; i++)
+      (*out)[i] = lo + i;
+    return n;
+  }
+
+  g = index_group(x, key);
+  n = g < 0 ? 0 : x->count[g];
+  *out = (i64_t *)malloc((n + 1) * sizeof(i64_t));
+  if (*out == NULL)
+    return -1;
+  for (i = 0, r = n > 0 ? x->first[g] : -1; i < n; i++, r = x->link[r])
+    (*out)[i] = r;
+  return n;
+}
+
+// Positions (I64 vector, ascending) of the rows holding `*key`. Keys come
+// through memory so timestamps and symbol ids past 2^53 stay exact.
+EMSCRIPTEN_KEEPALIVE obj_p index_rows(col_index_p x, const i64_t *key) {
+  obj_p out;
+  i64_t *rows, n = index_probe(x, *key, &rows);
+
+  if (n < 0) {
+    free(rows);
+    return err_user("Index is not bound to a table");
+  }
+  out = vector(TYPE_I64, n);
+  if (out != NULL)
+    memcpy(AS_I64(out), rows, n * sizeof(i64_t));
+  free(rows);
+  return out != NULL ? out : err_user("Failed to allocate index rows");
+}
+
+// The rows of the indexed table holding `*key`, as a table
+EMSCRIPTEN_KEEPALIVE obj_p index_where(col_index_p x, const i64_t *key) {
+  obj_p out;
+  i64_t *rows, n = index_probe(x, *key, &rows);
+
+  if (n < 0) {
+    free(rows);
+    return err_user("Index is not bound to a table");
+  }
+  out = index_gather(x->table, rows, n);
+  free(rows);
+  return out;
+}
+
+// Groups of the indexed column as a dict: the distinct values (column type,
+// in first-seen order for hash indexes, ascending for sorted ones) to I64
+// vectors of their rows
+EMSCRIPTEN_KEEPALIVE obj_p index_groups(col_index_p x) {
+  obj_p col, keys, vals, rows;
+  i64_t g, i, r, n, ng, size, *starts = NULL;
+
+  if (x == NULL || x->table == NULL)
+    return err_user("Index is not bound to a table");
+  col = AS_LIST(AS_LIST(x->table)[1])[x->col];
+  size = get_element_size(col->type);
+
+  // Sorted columns: groups are the runs of equal keys
+  if (x->kind == INDEX_SORTED) {
+    starts = (i64_t *)malloc((col->len + 1) * sizeof(i64_t));
+    if (starts == NULL)
+      return err_user("Out of memory: failed to group index");
+    for (ng = 0, i = 0; i < col->len; i++)
+      if (i == 0 || index_key(col, i) != index_key(col, i - 1))
+        starts[ng++] = i;
+    starts[ng] = col->len;
+  } else {
+    ng = x->ngroups;
+  }
+
+  keys = vector(col->type, ng);
+  vals = LIST(ng);
+  if (keys == NULL || vals == NULL) {
+    free(starts);
+    if (keys != NULL)
+      drop_obj(keys);
+    if (vals != NULL) {
+      vals->len = 0;
+      drop_obj(vals);
+    }
+    return err_user("Failed to allocate index groups");
+  }
+  for (g = 0; g < ng; g++) {
+    r = starts != NULL ? starts[g] : x->first[g];
+    n = starts != NULL ? starts[g + 1] - starts[g] : x->count[g];
+    kern_put((u8_t *)AS_C8(keys) + g * size, (const u8_t *)AS_C8(col), r, size);
+    rows = vector(TYPE_I64, n);
+    if (rows == NULL) {
+      free(starts);
+      vals->len = g;
+      drop_obj(vals);
+      drop_obj(keys);
+      return err_user("Failed to allocate index groups");
+    }
+    for (i = 0; i < n; i++, r = starts != NULL ? r + 1 : x->link[r])
+      AS_I64(rows)[i] = r;
+    AS_LIST(vals)[g] = rows;
+  }
+  free(starts);
+  return dict(keys, vals);
+}
+
+// Free an index and stop maintaining it
+EMSCRIPTEN_KEEPALIVE nil_t index_free(col_index_p x) {
+  col_index_p *p;
+
+  if (x == NULL)
+    return;
+  for (p = &__INDEXES; *p != NULL; p = &(*p)->next) {
+    if (*p == x) {
+      *p = x->next;
+      break;
+    }
+  }
+  index_release(x);
+}
+
+// ============================================================================
+// Query Operations
+// ============================================================================
+
+// Execute select query without consulting or filling the result cache, for
+// selects over throwaway tables (index probes, paged-in splayed columns)
+EMSCRIPTEN_KEEPALIVE obj_p query_select_uncached(obj_p query) {
+  obj_p result;
+  prof_mark_t m;
+
+  if (query == NULL)
+    return NULL_OBJ;
+  m = prof_enter();
+  result = ray_select(query);
+  prof_leave(PROF_SELECT, m);
+  return result;
+}
+
+// Execute select query (takes dict as query), through the result cache
+// when it has a budget
+EMSCRIPTEN_KEEPALIVE obj_p query_select(obj_p query) {
+  obj_p result, t, key = NULL;
+  u64_t hash = 0;
+  prof_mark_t m;
+
+  if (query == NULL)
+    return NULL_OBJ;
+  m = prof_enter();
+
+  t = __RESULTS_BUDGET > 0 ? query_table(query) : NULL;
+  if (t != NULL)
+    key = result_key(query);
+  if (key == NULL) {
+    __RESULTS_STATS.bypassed++;
+    result = ray_select(query);
+    prof_leave(PROF_SELECT, m);
+    return result;
+  }
+
+  hash = fnv1a((lit_p)AS_U8(key), key->len, 0xcbf29ce484222325ULL);
+  result = result_cache_get(key, hash, t);
+  if (result != NULL) {
+    __RESULTS_STATS.hits++;
+    drop_obj(key);
+    prof_leave(PROF_SELECT, m);
+    return result;
+  }
+
+  __RESULTS_STATS.misses++;
+  result = ray_select(query);
+  if (result != NULL && !IS_ERR(result))
+    result_cache_put(key, hash, t, result);
+  else
+    drop_obj(key);
+  prof_leave(PROF_SELECT, m);
+  return result;
+}
+
+// Execute update query. Cached selects over its table are evicted first
+// (all of them when `from` names a global).
+EMSCRIPTEN_KEEPALIVE obj_p query_update(obj_p query) {
+  obj_p result;
+  prof_mark_t m;
+
+  if (query == NULL)
+    return NULL_OBJ;
+  result_cache_invalidate(query_table(query));
+  m = prof_enter();
+  result = ray_update(query);
+  prof_leave(PROF_UPDATE, m);
+  return result;
+}
+
+// Insert into table, evicting its cached selects and moving its indexes to
+// the result
+// Arguments: t = table, data = data to insert
+EMSCRIPTEN_KEEPALIVE obj_p table_insert(obj_p t, obj_p data) {
+  if (t == NULL || data == NULL)
+    return NULL_OBJ;
+  result_cache_invalidate(t);
+  obj_p args[2] = {t, data};
+  obj_p result = ray_insert(args, 2);
+  index_follow(t, result, B8_TRUE);
+  return result;
+}
+
+// Upsert into table, evicting its cached selects and moving its indexes to
+// the result (rebuilt, as matched rows may change in place)
+// Arguments: t = table, match_count = number of key columns, data = data
+EMSCRIPTEN_KEEPALIVE obj_p table_upsert(obj_p t, obj_p match_count,
+                                        obj_p data) {
+  if (t == NULL || data == NULL)
+    return NULL_OBJ;
+  result_cache_invalidate(t);
+  obj_p args[3] = {t, match_count, data};
+  obj_p result = ray_upsert(args, 3);
+  index_follow(t, result, B8_FALSE);
+  return result;
+}
+
+// ============================================================================
+// Query Plans
+// ============================================================================
+
+// Plans are assembled in one call from a postfix program over object
+// handles, so query values and call arguments reach the evaluator by
+// pointer instead of being formatted and re-parsed. Each instruction is an
+// (op, arg) i32 pair; the handles in `objs` stay owned by the caller.
+#define PLAN_PUSH 0  // push objs[arg]
+#define PLAN_QUOTE 1 // push objs[arg] quoted (literal symbols and lists)
+#define PLAN_CALL 2  // pop `arg` items into a call list, head first
+#define PLAN_DICT 3  // pop `arg` (key symbol, value) pairs into a dict
+
+#define PLAN_MAX_DEPTH 256
+
+static obj_p plan_fail(obj_p *stack, i64_t sp, lit_p msg) {
+  while (sp > 0)
+    drop_obj(stack[--sp]);
+  return err_user(msg);
+}
+
+// Build a plan (call list or query dict) from `n` instructions. The counts
+// are i32: an i64 before `objs` would shift it on wasm32 without WASM_BIGINT
+EMSCRIPTEN_KEEPALIVE obj_p build_plan(i32_t *code, i32_t n, obj_p *objs,
+                                      i32_t nobjs) {
+  obj_p stack[PLAN_MAX_DEPTH], item, keys, vals;
+  i64_t i, j, sp = 0, arg, base;
+
+  if (code == NULL || n <= 0)
+    return err_user("Empty plan");
+
+  for (i = 0; i < n; i++) {
+    arg = code[i * 2 + 1];
+
+    switch (code[i * 2]) {
+    case PLAN_PUSH:
+    case PLAN_QUOTE:
+      if (objs == NULL || arg < 0 || arg >= nobjs)
+        return plan_fail(stack, sp, "Plan references an unknown object");
+      if (sp == PLAN_MAX_DEPTH)
+        return plan_fail(stack, sp, "Plan is nested too deeply");
+      if (objs[arg] == NULL)
+        stack[sp++] = NULL_OBJ;
+      else
+        stack[sp++] = code[i * 2] == PLAN_QUOTE ? ray_quote(objs[arg])
+                                                : clone_obj(objs[arg]);
+      break;
+
+    case PLAN_CALL:
+      if (arg <= 0 || arg > sp)
+        return plan_fail(stack, sp, "Plan call has too few items");
+      item = LIST(arg);
+      if (item == NULL)
+        return plan_fail(stack, sp, "Failed to allocate plan");
+      base = sp - arg;
+      for (j = 0; j < arg; j++)
+        AS_LIST(item)[j] = stack[base + j];
+      sp = base;
+      stack[sp++] = item;
+      break;
+
+    case PLAN_DICT:
+      if (arg <= 0 || arg * 2 > sp)
+        return plan_fail(stack, sp, "Plan dict has too few items");
+      base = sp - arg * 2;
+      for (j = 0; j < arg; j++) {
+        item = stack[base + j * 2];
+        if (item == NULL || item->type != -TYPE_SYMBOL)
+          return plan_fail(stack, sp, "Plan dict keys must be symbols");
+      }
+      keys = vector(TYPE_SYMBOL, arg);
+      vals = LIST(arg);
+      if (keys == NULL || vals == NULL) {
+        if (keys != NULL)
+          drop_obj(keys);
+        if (vals != NULL) {
+          vals->len = 0;
+          drop_obj(vals);
+        }
+        return plan_fail(stack, sp, "Failed to allocate plan");
+      }
+      for (j = 0; j < arg; j++) {
+        AS_SYMBOL(keys)[j] = stack[base + j * 2]->i64;
+        drop_obj(stack[base + j * 2]);
+        AS_LIST(vals)[j] = stack[base + j * 2 + 1];
+      }
+      sp = base;
+      stack[sp++] = dict(keys, vals);
+      break;
+
+    default:
+      return plan_fail(stack, sp, "Unknown plan instruction");
+    }
+  }
+
+  if (sp != 1)
+    return plan_fail(stack, sp, "Plan must leave exactly one object");
+  return stack[0];
+}
+
+// Evaluate a call plan (function application) without re-parsing
+EMSCRIPTEN_KEEPALIVE obj_p eval_plan(obj_p plan) {
+  obj_p result;
+  prof_mark_t m;
+
+  if (plan == NULL)
+    return NULL_OBJ;
+  m = prof_enter();
+  result = eval_obj(plan);
+  prof_leave(PROF_EVAL_PLAN, m);
+  return result;
+}
+
+// ============================================================================
+// Binary Set/Get (global variable assignment)
+// ============================================================================
+
+// Cached selects may refer to the global, so they are all evicted first
+EMSCRIPTEN_KEEPALIVE obj_p global_set(obj_p name, obj_p val) {
+  if (name == NULL)
+    return NULL_OBJ;
+  result_cache_invalidate(NULL);
+  return binary_set(name, val);
+}
+
+// Quote object (wrap in reference)
+EMSCRIPTEN_KEEPALIVE obj_p quote_obj(obj_p obj) {
+  if (obj == NULL)
+    return NULL_OBJ;
+  return ray_quote(obj);
+}
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+// Serialize object to bytes
+EMSCRIPTEN_KEEPALIVE obj_p serialize(obj_p obj) {
+  if (obj == NULL)
+    return NULL_OBJ;
+  return ser_obj(obj);
+}
+
+// Deserialize bytes to object
+EMSCRIPTEN_KEEPALIVE obj_p deserialize(obj_p buf) {
+  if (buf == NULL)
+    return NULL_OBJ;
+  return de_obj(buf);
+}
+
+// ============================================================================
+// IPC Messages
+// ============================================================================
+
+// The WASM build has no event loop (epoll/kqueue/iocp are excluded), so the
+// remote transport lives in JS over a WebSocket. These helpers give it the
+// wire format of rayforce's IPC: every message is a ser_obj buffer whose
+// header carries the message type and the payload size.
+
+// Version byte sent in the connection handshake
+EMSCRIPTEN_KEEPALIVE i32_t ipc_version(nil_t) {
+  sys_info_t info = sys_info(1);
+  return info.major_version;
+}
+
+// Bytes to buffer before ipc_msg_len can frame a message
+EMSCRIPTEN_KEEPALIVE i32_t ipc_header_size(nil_t) {
+  return (i32_t)sizeof(header_t);
+}
+
+// Serialize an object as an IPC message of the given type
+EMSCRIPTEN_KEEPALIVE obj_p ipc_encode(obj_p obj, i32_t msgtype) {
+  obj_p buf;
+
+  // A bare NULL (RayNull on the JS side) goes out as the null object
+  buf = ser_obj(obj == NULL ? NULL_OBJ : obj);
+  if (IS_ERR(buf))
+    return buf;
+
+  ((header_t *)AS_U8(buf))->msgtype = (u8_t)msgtype;
+  return buf;
+}
+
+// Total length (header included) of the message starting with `hdr`, or -1
+// if the bytes are not a rayforce message header
+EMSCRIPTEN_KEEPALIVE i64_t ipc_msg_len(const u8_t *hdr) {
+  const header_t *h = (const header_t *)hdr;
+
+  if (h->prefix != SERDE_PREFIX || h->size < 0)
+    return -1;
+  return (i64_t)sizeof(header_t) + h->size;
+}
+
+// Message type of the message starting with `hdr`
+EMSCRIPTEN_KEEPALIVE i32_t ipc_msg_type(const u8_t *hdr) {
+  return ((const header_t *)hdr)->msgtype;
+}
+
+// ============================================================================
+// Splayed Tables
+// ============================================================================
+
+// Enumerate the symbol columns of a table against one shared symbol
+// vector, the layout native splayed tables keep in their `sym` file.
+// Returns a list of ncols + 1 items: the distinct symbols in first-seen
+// order, then per column an I32 vector of positions into them for symbol
+// columns, or the column itself for any other type.
+EMSCRIPTEN_KEEPALIVE obj_p splay_enum(obj_p t) {
+  obj_p vals, col, syms, idx, out;
+  i64_t i, j, id, ncols, rows = 0, n = 0, cap = 16;
+  i64_t *ids;
+  i32_t *slots;
+  u64_t h;
+
+  if (t == NULL || t->type != TYPE_TABLE)
+    return err_user("Expected a table");
+
+  vals = AS_LIST(t)[1];
+  ncols = vals->len;
+  for (j = 0; j < ncols; j++)
+    if (AS_LIST(vals)[j]->type == TYPE_SYMBOL)
+      rows += AS_LIST(vals)[j]->len;
+
+  while (cap < rows * 2)
+    cap *= 2;
+
+  out = LIST(ncols + 1);
+  slots = (i32_t *)calloc(cap, sizeof(i32_t));
+  ids = (i64_t *)malloc((rows ? rows : 1) * sizeof(i64_t));
+  if (out == NULL || slots == NULL || ids == NULL) {
+    if (out != NULL) {
+      out->len = 0;
+      drop_obj(out);
+    }
+    free(slots);
+    free(ids);
+    return err_user("Out of memory: failed to enumerate symbols");
+  }
+  for (j = 0; j <= ncols; j++)
+    AS_LIST(out)[j] = NULL_OBJ;
+
+  for (j = 0; j < ncols; j++) {
+    col = AS_LIST(vals)[j];
+    if (col->type != TYPE_SYMBOL) {
+      AS_LIST(out)[j + 1] = clone_obj(col);
+      continue;
+    }
+
+    idx = vector(TYPE_I32, col->len);
+    if (idx == NULL) {
+      drop_obj(out);
+      free(slots);
+      free(ids);
+      return err_user("Out of memory: failed to enumerate symbols");
+    }
+
+    // Open addressing over 1-based positions (0 = empty slot)
+    for (i = 0; i < col->len; i++) {
+      id = AS_SYMBOL(col)[i];
+      h = (u64_t)id * 0x9E3779B97F4A7C15ULL;
+      h = (h ^ (h >> 32)) & (cap - 1);
+      while (slots[h] && ids[slots[h] - 1] != id)
+        h = (h + 1) & (cap - 1);
+      if (!slots[h]) {
+        ids[n] = id;
+        slots[h] = (i32_t)++n;
+      }
+      AS_I32(idx)[i] = slots[h] - 1;
+    }
+    AS_LIST(out)[j + 1] = idx;
+  }
+
+  free(slots);
+  syms = vector(TYPE_SYMBOL, n);
+  if (syms == NULL) {
+    drop_obj(out);
+    free(ids);
+    return err_user("Out of memory: failed to enumerate symbols");
+  }
+  memcpy(AS_SYMBOL(syms), ids, n * sizeof(i64_t));
+  free(ids);
+  AS_LIST(out)[0] = syms;
+
+  return out;
+}
+
+// Rebuild a symbol column from positions into a symbol vector (splay_enum)
+EMSCRIPTEN_KEEPALIVE obj_p splay_unenum(obj_p idx, obj_p syms) {
+  obj_p col;
+  i64_t i;
+  i32_t k;
+
+  if (idx == NULL || idx->type != TYPE_I32 || syms == NULL || syms->type != TYPE_SYMBOL)
+    return err_user("Expected I32 positions and a symbol vector");
+
+  col = vector(TYPE_SYMBOL, idx->len);
+  if (col == NULL)
+    return err_user("Out of memory: failed to load symbol column");
+
+  for (i = 0; i < idx->len; i++) {
+    k = AS_I32(idx)[i];
+    if (k < 0 || k >= syms->len) {
+      drop_obj(col);
+      return err_user("Corrupt splayed column: symbol position out of range");
+    }
+    AS_SYMBOL(col)[i] = AS_SYMBOL(syms)[k];
+  }
+
+  return col;
+}
+
+// ============================================================================
+// Type Name
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE str_p get_type_name(i8_t type) { return type_name(type); }
+
+// ============================================================================
+// CSV Parsing
+// ============================================================================
+
+// Ingest tracing goes through stdout (console.log under Emscripten), so it
+// is only compiled into debug builds
+#ifdef DEBUG
+#define CSV_TRACE(...) printf(__VA_ARGS__)
+#else
+#define CSV_TRACE(...) ((nil_t)0)
+#endif
+
+// Statistics of the last CSV ingest (read_csv* or a finished stream).
+// Stored as doubles so JS can read the struct through HEAPF64 directly.
+typedef struct ingest_stats_t {
+  f64_t rows;
+  f64_t cols;
+  f64_t bytes;
+  f64_t count_ms;  // line counting
+  f64_t header_ms; // header parsing and type inference
+  f64_t alloc_ms;  // column allocation
+  f64_t parse_ms;  // io_read_csv
+  f64_t total_ms;
+} ingest_stats_t;
+
+static ingest_stats_t __INGEST_STATS;
+
+// Get statistics of the last CSV ingest
+EMSCRIPTEN_KEEPALIVE ingest_stats_t *last_ingest_stats(nil_t) {
+  return &__INGEST_STATS;
+}
+
+// Number of data rows sampled for column type inference
+#define CSV_INFER_ROWS 1024
+
+// Classify a single field. Returns TYPE_NULL for empty fields so they
+// don't influence the inferred column type.
+static i8_t csv_field_type(lit_p s, i64_t n) {
+  i64_t i = 0, digits = 0;
+  b8_t dot = B8_FALSE, exp = B8_FALSE;
+
+  // Trim surrounding whitespace and quotes
+  while (n > 0 && (s[n - 1] == ' ' || s[n - 1] == '\r' || s[n - 1] == '"'))
+    n--;
+  while (n > 0 && (s[0] == ' ' || s[0] == '"')) {
+    s++;
+    n--;
+  }
+
+  if (n == 0)
+    return TYPE_NULL;
+
+  if ((n == 4 && strncasecmp(s, "true", 4) == 0) ||
+      (n == 5 && strncasecmp(s, "false", 5) == 0))
+    return TYPE_B8;
+
+  // Date: YYYY.MM.DD or YYYY-MM-DD, optionally followed by a time part
+  if (n >= 10 && isdigit(s[0]) && isdigit(s[1]) && isdigit(s[2]) &&
+      isdigit(s[3]) && (s[4] == '.' || s[4] == '-') && isdigit(s[5]) &&
+      isdigit(s[6]) && s[7] == s[4] && isdigit(s[8]) && isdigit(s[9])) {
+    if (n == 10)
+      return TYPE_DATE;
+    if ((s[10] == 'D' || s[10] == 'T' || s[10] == ' ') && n >= 19 &&
+        s[13] == ':' && s[16] == ':')
+      return TYPE_TIMESTAMP;
+    return TYPE_SYMBOL;
+  }
+
+  if (s[0] == '-' || s[0] == '+')
+    i++;
+
+  for (; i < n; i++) {
+    if (isdigit(s[i])) {
+      digits++;
+    } else if (s[i] == '.' && !dot && !exp) {
+      dot = B8_TRUE;
+    } else if ((s[i] == 'e' || s[i] == 'E') && digits > 0 && !exp) {
+      exp = B8_TRUE;
+      if (i + 1 < n && (s[i + 1] == '-' || s[i + 1] == '+'))
+        i++;
+    } else {
+      return TYPE_SYMBOL;
+    }
+  }
+
+  if (digits == 0)
+    return TYPE_SYMBOL;
+
+  return (dot || exp) ? TYPE_F64 : TYPE_I64;
+}
+
+// Widen the type seen so far for a column with the type of a new field
+static i8_t csv_merge_type(i8_t acc, i8_t t) {
+  if (t == TYPE_NULL || acc == t)
+    return acc;
+  if (acc == TYPE_NULL)
+    return t;
+  if ((acc == TYPE_I64 && t == TYPE_F64) || (acc == TYPE_F64 && t == TYPE_I64))
+    return TYPE_F64;
+  if ((acc == TYPE_DATE && t == TYPE_TIMESTAMP) ||
+      (acc == TYPE_TIMESTAMP && t == TYPE_DATE))
+    return TYPE_TIMESTAMP;
+  return TYPE_SYMBOL;
+}
+
+// Infer column types from the first CSV_INFER_ROWS data lines.
+// Columns that stay empty over the whole sample fall back to SYMBOL.
+static nil_t csv_infer_types(lit_p data, i64_t len, c8_t sep, i64_t ncols,
+                             i8_t *types) {
+  i64_t i, col, row;
+  lit_p pos = data, end = data + len, field;
+  b8_t quoted;
+
+  for (i = 0; i < ncols; i++)
+    types[i] = TYPE_NULL;
+
+  for (row = 0; row < CSV_INFER_ROWS && pos < end; row++) {
+    col = 0;
+    field = pos;
+    quoted = B8_FALSE;
+
+    for (; pos < end; pos++) {
+      if (*pos == '"') {
+        quoted = !quoted;
+      } else if (!quoted && (*pos == sep || *pos == '\n')) {
+        if (col < ncols)
+          types[col] = csv_merge_type(types[col],
+                                      csv_field_type(field, pos - field));
+        col++;
+        field = pos + 1;
+        if (*pos == '\n')
+          break;
+      }
+    }
+
+    // Last line without trailing newline
+    if (pos == end && field < end && col < ncols)
+      types[col] =
+          csv_merge_type(types[col], csv_field_type(field, end - field));
+
+    pos++;
+  }
+
+  for (i = 0; i < ncols; i++)
+    if (types[i] == TYPE_NULL)
+      types[i] = TYPE_SYMBOL;
+}
+
+// Parse a header line into a symbol vector of column names
+static obj_p csv_parse_header(lit_p buf, i64_t header_len, c8_t sep) {
+  i64_t i, l, remaining;
+  lit_p pos, prev, next_sep;
+  obj_p names;
+
+  // Count columns based on separator
+  l = 1;
+  pos = buf;
+  while ((pos = (lit_p)memchr(pos, sep, header_len - (pos - buf)))) {
+    ++l;
+    ++pos;
+  }
+
+  names = SYMBOL(l);
+  if (names == NULL)
+    return NULL;
+
+  pos = buf;
+  remaining = header_len;
+
+  for (i = 0; i < l; i++) {
+    prev = pos;
+    next_sep = (lit_p)memchr(pos, sep, remaining);
+
+    if (next_sep == NULL) {
+      // Last column
+      if (remaining > 0 && prev[remaining - 1] == '\r') {
+        AS_SYMBOL(names)
+        [i] = io_symbol_from_str_trimmed(prev, remaining - 1);
+      } else {
+        AS_SYMBOL(names)[i] = io_symbol_from_str_trimmed(prev, remaining);
+      }
+      pos += remaining;
+      remaining = 0;
+    } else {
+      AS_SYMBOL(names)
+      [i] = io_symbol_from_str_trimmed(prev, next_sep - prev);
+      remaining -= (next_sep - prev + 1);
+      pos = next_sep + 1;
+    }
+  }
+
+  return names;
+}
+
+// Allocate a CSV column: strings are kept as a list of C8 vectors,
+// everything else is a native vector
+static obj_p csv_alloc_col(i8_t type, i64_t rows) {
+  return (type == TYPE_C8) ? LIST(rows) : vector(type, rows);
+}
+
+// Read CSV from string content
+// - Infers column names from first line
+// - Column types are inferred by sampling the first CSV_INFER_ROWS rows;
+//   `types` (length `ntypes`) overrides them per column position, where a
+//   zero entry keeps the inferred type. Pass TYPE_C8 to keep raw strings.
+// - `len` comes last: an i64 ahead of `types` would shift it on wasm32
+//   without WASM_BIGINT
+EMSCRIPTEN_KEEPALIVE obj_p read_csv_typed(lit_p content, i8_t *types,
+                                          i32_t ntypes, i64_t len) {
+  i64_t i, l, lines;
+  str_p buf, pos, line;
+  obj_p names, cols, res;
+  c8_t sep = ',';
+  f64_t t0, t1;
+
+  memset(&__INGEST_STATS, 0, sizeof(__INGEST_STATS));
+  t0 = emscripten_get_now();
+
+  if (content == NULL) {
+    CSV_TRACE("ERROR: read_csv content is NULL\n");
+    return err_user("CSV content is NULL");
+  }
+
+  // We receive a heap pointer and byte length from JS.
+  // Trust the length passed in.
+  if (len <= 0) {
+    CSV_TRACE("ERROR: read_csv len <= 0\n");
+    return err_user("CSV length is zero or negative");
+  }
+
+  CSV_TRACE("INFO: read_csv starting, len=%lld bytes (%.1f MB)\n", len, len / (1024.0 * 1024.0));
+
+  // Since we receive a JS string pointer, we shouldn't modify it.
+  // However, parse_csv_lines expects a buffer it can read.
+  // We treat 'content' as the buffer.
+  buf = (str_p)content;
+
+  // Count lines
+  lines = 0;
+  pos = buf;
+  while ((pos = (str_p)memchr(pos, '\n', buf + len - pos))) {
+    ++lines;
+    ++pos;
+  }
+
+  if (len > 0 && buf[len - 1] != '\n') {
+    ++lines;
+  }
+
+  if (lines == 0) {
+    CSV_TRACE("ERROR: read_csv no lines found\n");
+    return err_user("CSV has no lines");
+  }
+
+  CSV_TRACE("INFO: read_csv found %lld lines\n", lines);
+
+  t1 = emscripten_get_now();
+  __INGEST_STATS.bytes = (f64_t)len;
+  __INGEST_STATS.count_ms = t1 - t0;
+
+  // Parse header
+  pos = (str_p)memchr(buf, '\n', len);
+  i64_t header_len = (pos == NULL) ? len : (pos - buf);
+  line = (pos == NULL) ? NULL : (pos + 1);
+
+  names = csv_parse_header(buf, header_len, sep);
+  if (names == NULL) {
+    CSV_TRACE("ERROR: read_csv failed to allocate names vector\n");
+    return err_user("Failed to allocate column names");
+  }
+  l = names->len;
+
+  CSV_TRACE("INFO: read_csv found %lld columns\n", l);
+
+  // Alloc types - inferred from a sample of the data, then overridden
+  i8_t *type_arr = (i8_t *)malloc(l * sizeof(i8_t));
+  if (type_arr == NULL) {
+    CSV_TRACE("ERROR: read_csv failed to allocate type_arr\n");
+    drop_obj(names);
+    return err_user("Failed to allocate type array");
+  }
+  if (line != NULL)
+    csv_infer_types(line, len - (line - buf), sep, l, type_arr);
+  else
+    for (i = 0; i < l; i++)
+      type_arr[i] = TYPE_SYMBOL;
+
+  if (types != NULL) {
+    for (i = 0; i < l && i < ntypes; i++) {
+      if (types[i] != 0)
+        type_arr[i] = types[i];
+    }
+  }
+
+  // Exclude header from data lines
+  lines--;
+  if (lines < 0)
+    lines = 0;
+
+  __INGEST_STATS.rows = (f64_t)lines;
+  __INGEST_STATS.cols = (f64_t)l;
+  __INGEST_STATS.header_ms = emscripten_get_now() - t1;
+  t1 = emscripten_get_now();
+
+  CSV_TRACE("INFO: read_csv allocating %lld columns x %lld rows\n", l, lines);
+
+  // Allocate columns
+  cols = LIST(l);
+  if (cols == NULL) {
+    CSV_TRACE("ERROR: read_csv failed to allocate cols list\n");
+    free(type_arr);
+    drop_obj(names);
+    return err_user("Failed to allocate columns list");
+  }
+
+  for (i = 0; i < l; i++) {
+    AS_LIST(cols)[i] = csv_alloc_col(type_arr[i], lines);
+    if (AS_LIST(cols)[i] == NULL) {
+      CSV_TRACE("ERROR: read_csv failed to allocate column %lld (lines=%lld)\n", i, lines);
+      free(type_arr);
+      drop_obj(names);
+      drop_obj(cols);
+      return err_user("Failed to allocate column data - file too large for memory");
+    }
+  }
+
+  CSV_TRACE("INFO: read_csv column allocation successful, parsing data...\n");
+
+  __INGEST_STATS.alloc_ms = emscripten_get_now() - t1;
+  t1 = emscripten_get_now();
+
+  // parse lines
+  // If line is NULL (only header), we skip parsing
+  if (lines > 0 && line != NULL) {
+    CSV_TRACE("INFO: read_csv calling io_read_csv for %lld lines...\n", lines);
+    res = io_read_csv(type_arr, l, line, len - (line - buf), lines, cols, sep);
+    CSV_TRACE("INFO: read_csv io_read_csv returned: %p, type=%d\n", res, res ? res->type : -999);
+
+    if (res && res->type == TYPE_ERR) {
+      CSV_TRACE("ERROR: read_csv io_read_csv returned error\n");
+      free(type_arr);
+      drop_obj(names);
+      drop_obj(cols);
+      return res;
+    }
+  }
+
+  free(type_arr);
+
+  __INGEST_STATS.parse_ms = emscripten_get_now() - t1;
+  
+  // Verify objects are still valid before creating table
+  CSV_TRACE("INFO: read_csv verifying objects - names=%p type=%d len=%lld, cols=%p type=%d len=%lld\n", 
+         names, names ? names->type : -1, names ? names->len : -1,
+         cols, cols ? cols->type : -1, cols ? cols->len : -1);
+  
+  if (names == NULL || cols == NULL) {
+    CSV_TRACE("ERROR: read_csv names or cols became NULL!\n");
+    if (names) drop_obj(names);
+    if (cols) drop_obj(cols);
+    return err_user("Memory corruption - names or cols became NULL");
+  }
+  
+  CSV_TRACE("INFO: read_csv creating table...\n");
+  obj_p t = table(names, cols);
+  CSV_TRACE("INFO: read_csv table() returned: %p\n", t);
+  if (t == NULL) {
+    CSV_TRACE("ERROR: read_csv table() returned NULL - out of memory!\n");
+    drop_obj(names);
+    drop_obj(cols);
+    return err_user("Out of memory: failed to allocate table structure");
+  }
+
+  __INGEST_STATS.total_ms = emscripten_get_now() - t0;
+
+  CSV_TRACE("INFO: read_csv success. Table: %p, rows=%lld, cols=%lld\n", t, lines, l);
+  return t;
+}
+
+// Read CSV with fully inferred column types
+EMSCRIPTEN_KEEPALIVE obj_p read_csv(lit_p content, i64_t len) {
+  return read_csv_typed(content, NULL, 0, len);
+}
+
+// ============================================================================
+// Streaming CSV Ingest
+// ============================================================================
+
+// Chunked CSV ingest session. Each fed chunk is parsed up to its last
+// complete line and appended to growing column vectors; the partial tail
+// line is carried over into the next feed. Columns are over-allocated
+// geometrically and trimmed to the row count in csv_end.
+typedef struct csv_stream_t {
+  c8_t sep;
+  i8_t *types;  // per-position overrides, then the resolved column types
+  i64_t ntypes; // number of overrides
+  b8_t typed;   // column types resolved from the first data block
+  obj_p names;  // column names (NULL until the header line is complete)
+  obj_p cols;   // list of column vectors, each of length `cap`
+  i64_t rows;
+  i64_t cap;
+  str_p buf;    // carried partial line followed by the current chunk
+  i64_t buf_len;
+  i64_t buf_cap;
+  obj_p err;
+  f64_t started;
+  ingest_stats_t stats; // published to last_ingest_stats() by csv_end
+} *csv_stream_p;
+
+// Minimum column capacity for a streaming session
+#define CSV_STREAM_MIN_ROWS 1024
+
+static nil_t csv_stream_free(csv_stream_p s) {
+  if (s->names != NULL)
+    drop_obj(s->names);
+  if (s->cols != NULL)
+    drop_obj(s->cols);
+  if (s->err != NULL)
+    drop_obj(s->err);
+  free(s->types);
+  free(s->buf);
+  free(s);
+}
+
+// Grow every column to hold at least `rows` rows
+static b8_t csv_stream_reserve(csv_stream_p s, i64_t rows) {
+  i64_t i, j, cap;
+  obj_p *col;
+
+  if (rows <= s->cap)
+    return B8_TRUE;
+
+  cap = s->cap < CSV_STREAM_MIN_ROWS ? CSV_STREAM_MIN_ROWS : s->cap;
+  while (cap < rows)
+    cap *= 2;
+
+  for (i = 0; i < s->names->len; i++) {
+    col = &AS_LIST(s->cols)[i];
+    if (*col == NULL_OBJ)
+      *col = csv_alloc_col(s->types[i], cap);
+    else
+      resize_obj(col, cap);
+    if (*col == NULL || IS_ERR(*col))
+      return B8_FALSE;
+    // Unfilled list slots must stay droppable
+    if ((*col)->type == TYPE_LIST)
+      for (j = s->cap; j < cap; j++)
+        AS_LIST(*col)[j] = NULL_OBJ;
+  }
+
+  s->cap = cap;
+  return B8_TRUE;
+}
+
+// Resolve column types from the first data block, keeping the overrides
+static b8_t csv_stream_resolve(csv_stream_p s, lit_p data, i64_t len) {
+  i64_t i, l = s->names->len;
+  i8_t *inferred = (i8_t *)malloc(l * sizeof(i8_t));
+
+  if (inferred == NULL) {
+    s->err = err_user("Failed to allocate type array");
+    return B8_FALSE;
+  }
+
+  csv_infer_types(data, len, s->sep, l, inferred);
+  for (i = 0; i < l; i++)
+    if (s->types[i] == 0)
+      s->types[i] = inferred[i];
+
+  free(inferred);
+  s->typed = B8_TRUE;
+  return B8_TRUE;
+}
+
+// Parse `lines` complete lines from `data` and append them to the columns.
+// io_read_csv fills vectors from their first element, so the chunk is parsed
+// into scratch columns and copied to the tail; string cells are moved.
+static b8_t csv_stream_parse(csv_stream_p s, str_p data, i64_t len,
+                             i64_t lines) {
+  i64_t i, j, l, esz;
+  obj_p tmp, res, src, dst;
+  f64_t t0 = emscripten_get_now(), t1;
+
+  l = s->names->len;
+
+  if (!s->typed && !csv_stream_resolve(s, data, len))
+    return B8_FALSE;
+
+  t1 = emscripten_get_now();
+  s->stats.header_ms += t1 - t0;
+
+  tmp = LIST(l);
+  if (tmp == NULL) {
+    s->err = err_user("Failed to allocate CSV chunk columns");
+    return B8_FALSE;
+  }
+
+  for (i = 0; i < l; i++) {
+    AS_LIST(tmp)[i] = csv_alloc_col(s->types[i], lines);
+    if (AS_LIST(tmp)[i] == NULL) {
+      tmp->len = i;
+      drop_obj(tmp);
+      s->err = err_user("Failed to allocate CSV chunk columns");
+      return B8_FALSE;
+    }
+  }
+
+  t0 = emscripten_get_now();
+  s->stats.alloc_ms += t0 - t1;
+
+  res = io_read_csv(s->types, l, data, len, lines, tmp, s->sep);
+  if (res && res->type == TYPE_ERR) {
+    drop_obj(tmp);
+    s->err = res;
+    return B8_FALSE;
+  }
+
+  t1 = emscripten_get_now();
+  s->stats.parse_ms += t1 - t0;
+
+  if (!csv_stream_reserve(s, s->rows + lines)) {
+    drop_obj(tmp);
+    s->err = err_user("Out of memory: failed to grow CSV columns");
+    return B8_FALSE;
+  }
+
+  for (i = 0; i < l; i++) {
+    src = AS_LIST(tmp)[i];
+    dst = AS_LIST(s->cols)[i];
+    if (src->type == TYPE_LIST) {
+      for (j = 0; j < lines; j++) {
+        AS_LIST(dst)[s->rows + j] = AS_LIST(src)[j];
+        AS_LIST(src)[j] = NULL_OBJ;
+      }
+    } else {
+      esz = get_element_size(src->type);
+      memcpy(AS_C8(dst) + s->rows * esz, AS_C8(src), lines * esz);
+    }
+  }
+
+  drop_obj(tmp);
+  s->rows += lines;
+  s->stats.alloc_ms += emscripten_get_now() - t1;
+  return B8_TRUE;
+}
+
+// Start a streaming CSV session. `types`/`ntypes` are optional per-position
+// type overrides as in read_csv_typed (copied, the caller keeps ownership).
+EMSCRIPTEN_KEEPALIVE csv_stream_p csv_begin(i8_t *types, i64_t ntypes) {
+  csv_stream_p s = (csv_stream_p)calloc(1, sizeof(struct csv_stream_t));
+  if (s == NULL)
+    return NULL;
+
+  s->sep = ',';
+  s->started = emscripten_get_now();
+  if (types != NULL && ntypes > 0) {
+    s->types = (i8_t *)malloc(ntypes);
+    if (s->types == NULL) {
+      free(s);
+      return NULL;
+    }
+    memcpy(s->types, types, ntypes);
+    s->ntypes = ntypes;
+  }
+
+  return s;
+}
+
+// Feed a chunk of CSV bytes. Returns the number of rows ingested so far,
+// or -1 once the session has failed (the error is returned by csv_end).
+EMSCRIPTEN_KEEPALIVE i64_t csv_feed(csv_stream_p s, lit_p chunk, i64_t len) {
+  i64_t i, cap, lines, header_len, used;
+  str_p pos, last, data;
+  i8_t *types;
+  f64_t t0;
+
+  if (s == NULL)
+    return -1;
+  if (s->err != NULL)
+    return -1;
+  if (chunk == NULL || len <= 0)
+    return s->rows;
+
+  // Append the chunk after the carried partial line
+  if (s->buf_len + len > s->buf_cap) {
+    cap = s->buf_cap ? s->buf_cap : 4096;
+    while (cap < s->buf_len + len)
+      cap *= 2;
+    pos = (str_p)realloc(s->buf, cap);
+    if (pos == NULL) {
+      s->err = err_user("Out of memory: failed to grow CSV chunk buffer");
+      return -1;
+    }
+    s->buf = pos;
+    s->buf_cap = cap;
+  }
+  memcpy(s->buf + s->buf_len, chunk, len);
+  s->buf_len += len;
+  s->stats.bytes += (f64_t)len;
+
+  data = s->buf;
+  used = 0;
+
+  // Header: wait until the first line is complete
+  if (s->names == NULL) {
+    pos = (str_p)memchr(s->buf, '\n', s->buf_len);
+    if (pos == NULL)
+      return 0;
+
+    header_len = pos - s->buf;
+    s->names = csv_parse_header(s->buf, header_len, s->sep);
+    if (s->names == NULL) {
+      s->err = err_user("Failed to allocate column names");
+      return -1;
+    }
+
+    types = (i8_t *)calloc(s->names->len, sizeof(i8_t));
+    s->cols = LIST(s->names->len);
+    if (types == NULL || s->cols == NULL) {
+      free(types);
+      s->err = err_user("Failed to allocate columns list");
+      return -1;
+    }
+    for (i = 0; i < s->names->len; i++)
+      AS_LIST(s->cols)[i] = NULL_OBJ;
+
+    // Overrides are applied after inference in csv_stream_parse
+    if (s->types != NULL)
+      memcpy(types, s->types,
+             s->ntypes < s->names->len ? s->ntypes : s->names->len);
+    free(s->types);
+    s->types = types;
+
+    used = header_len + 1;
+    data = s->buf + used;
+  }
+
+  // Parse all complete lines in place
+  t0 = emscripten_get_now();
+  last = NULL;
+  lines = 0;
+  pos = data;
+  while ((pos = (str_p)memchr(pos, '\n', s->buf + s->buf_len - pos))) {
+    last = pos;
+    ++lines;
+    ++pos;
+  }
+  s->stats.count_ms += emscripten_get_now() - t0;
+
+  if (lines > 0) {
+    if (!csv_stream_parse(s, data, last + 1 - data, lines))
+      return -1;
+    used = last + 1 - s->buf;
+  }
+
+  // Carry the partial tail over to the next feed
+  s->buf_len -= used;
+  memmove(s->buf, s->buf + used, s->buf_len);
+
+  return s->rows;
+}
+
+// Finish the session: parse the trailing line, trim the columns and
+// return the table (or the first error). The session is freed.
+EMSCRIPTEN_KEEPALIVE obj_p csv_end(csv_stream_p s) {
+  i64_t i;
+  obj_p t, col, err;
+
+  if (s == NULL)
+    return err_user("CSV stream is NULL");
+
+  // Treat a trailing line without newline as the last row
+  if (s->err == NULL && s->buf_len > 0)
+    csv_feed(s, "\n", 1);
+
+  if (s->err == NULL && s->names == NULL)
+    s->err = err_user("CSV has no lines");
+
+  if (s->err != NULL) {
+    err = s->err;
+    s->err = NULL;
+    csv_stream_free(s);
+    return err;
+  }
+
+  // Header only: allocate empty columns
+  if (!s->typed) {
+    for (i = 0; i < s->names->len; i++)
+      if (s->types[i] == 0)
+        s->types[i] = TYPE_SYMBOL;
+  }
+
+  // Trim every column, lists included, from its capacity to the row count
+  for (i = 0; i < s->names->len; i++) {
+    col = AS_LIST(s->cols)[i];
+    if (col == NULL_OBJ)
+      AS_LIST(s->cols)[i] = csv_alloc_col(s->types[i], 0);
+    else
+      resize_obj(&AS_LIST(s->cols)[i], s->rows);
+  }
+
+  t = table(s->names, s->cols);
+  s->names = NULL;
+  s->cols = NULL;
+
+  s->stats.rows = (f64_t)s->rows;
+  s->stats.cols = (f64_t)i;
+  s->stats.total_ms = emscripten_get_now() - s->started;
+  __INGEST_STATS = s->stats;
+  csv_stream_free(s);
+
+  if (t == NULL)
+    return err_user("Out of memory: failed to allocate table structure");
+
+  return t;
+}
+
+// Abandon a session without building a table
+EMSCRIPTEN_KEEPALIVE nil_t csv_abort(csv_stream_p s) {
+  if (s != NULL)
+    csv_stream_free(s);
+}
+
+// ============================================================================
+// Append Sessions
+// ============================================================================
+
+// Row batches are written into spare capacity past the published length
+// of each column and flush() publishes them by bumping the lengths, so
+// while nothing else references the session's table both are O(batch) and
+// columns grow geometrically in place. Once a snapshot is shared, growing
+// or flushing first moves the session to a private copy: the rows a
+// snapshot holder sees never change.
+
+typedef struct append_session_t {
+  obj_p table;   // published snapshot, every column backed by `cap` rows
+  i64_t rows;    // published rows
+  i64_t pending; // rows appended since the last flush
+  i64_t cap;
+  obj_p err;
+} *append_session_p;
+
+// Minimum column capacity once a session starts growing
+#define APPEND_MIN_ROWS 1024
+
+static nil_t append_session_free(append_session_p s) {
+  if (s->table != NULL)
+    drop_obj(s->table);
+  if (s->err != NULL)
+    drop_obj(s->err);
+  free(s);
+}
+
+// Only the session references its table and columns
+static b8_t append_exclusive(append_session_p s) {
+  obj_p vals = AS_LIST(s->table)[1];
+  i64_t i;
+
+  if (rc_obj(s->table) != 1 || rc_obj(vals) != 1)
+    return B8_FALSE;
+  for (i = 0; i < vals->len; i++)
+    if (rc_obj(AS_LIST(vals)[i]) != 1)
+      return B8_FALSE;
+  return B8_TRUE;
+}
+
+// Move the published and pending rows into a private table of `cap` rows
+static b8_t append_private(append_session_p s, i64_t cap) {
+  obj_p vals = AS_LIST(s->table)[1], nvals, keys, col, t;
+  i64_t i, live = s->rows + s->pending;
+
+  nvals = LIST(vals->len);
+  if (nvals == NULL)
+    return B8_FALSE;
+  for (i = 0; i < vals->len; i++)
+    AS_LIST(nvals)[i] = NULL_OBJ;
+
+  for (i = 0; i < vals->len; i++) {
+    col = vector(AS_LIST(vals)[i]->type, cap);
+    if (col == NULL) {
+      drop_obj(nvals);
+      return B8_FALSE;
+    }
+    memcpy(AS_C8(col), AS_C8(AS_LIST(vals)[i]), live * get_element_size(col->type));
+    col->len = s->rows;
+    AS_LIST(nvals)[i] = col;
+  }
+
+  keys = clone_obj(AS_LIST(s->table)[0]);
+  t = table(keys, nvals);
+  if (t == NULL) {
+    drop_obj(keys);
+    drop_obj(nvals);
+    return B8_FALSE;
+  }
+  if (IS_ERR(t)) {
+    drop_obj(t);
+    return B8_FALSE;
+  }
+
+  drop_obj(s->table);
+  s->table = t;
+  s->cap = cap;
+  return B8_TRUE;
+}
+
+// Grow every column to hold at least `rows` rows. A column is swapped in
+// only once its resize succeeded, so a failure leaves the session usable
+// (columns already grown just keep the extra capacity).
+static b8_t append_reserve(append_session_p s, i64_t rows) {
+  obj_p vals, col;
+  i64_t i, cap;
+
+  if (rows <= s->cap)
+    return B8_TRUE;
+
+  cap = s->cap < APPEND_MIN_ROWS ? APPEND_MIN_ROWS : s->cap;
+  while (cap < rows)
+    cap *= 2;
+
+  if (!append_exclusive(s))
+    return append_private(s, cap);
+
+  vals = AS_LIST(s->table)[1];
+  for (i = 0; i < vals->len; i++) {
+    col = AS_LIST(vals)[i];
+    // Resize over the live rows so pending ones are carried over
+    col->len = s->rows + s->pending;
+    resize_obj(&col, cap);
+    if (col == NULL || IS_ERR(col)) {
+      if (col != NULL)
+        drop_obj(col);
+      AS_LIST(vals)[i]->len = s->rows;
+      return B8_FALSE;
+    }
+    col->len = s->rows;
+    AS_LIST(vals)[i] = col;
+  }
+
+  s->cap = cap;
+  return B8_TRUE;
+}
+
+// Start appending to a table (which is left unchanged). Columns must be
+// fixed-width or symbols; returns NULL otherwise.
+EMSCRIPTEN_KEEPALIVE append_session_p append_begin(obj_p t) {
+  append_session_p s;
+  obj_p vals;
+  i64_t i;
+
+  if (t == NULL || t->type != TYPE_TABLE)
+    return NULL;
+
+  vals = AS_LIST(t)[1];
+  for (i = 0; i < vals->len; i++)
+    if (AS_LIST(vals)[i]->type <= TYPE_LIST || IS_ATOM(AS_LIST(vals)[i]) ||
+        get_element_size(AS_LIST(vals)[i]->type) == 0)
+      return NULL;
+
+  s = (append_session_p)calloc(1, sizeof(struct append_session_t));
+  if (s == NULL)
+    return NULL;
+
+  s->table = clone_obj(t);
+  s->rows = table_count(t);
+  s->cap = s->rows;
+  return s;
+}
+
+// Append `n` rows: `datas[i]` holds n packed values of column i, or for a
+// symbol column packed UTF-8 strings with n + 1 offsets in `sym_offs[i]`
+// (`sym_offs` may be NULL without symbol columns). Returns the number of
+// pending rows, or -1 once the session has failed (the error is returned
+// by append_flush).
+EMSCRIPTEN_KEEPALIVE i64_t append_rows(append_session_p s, raw_p *datas,
+                                       i32_t **sym_offs, i64_t n) {
+  obj_p vals, col;
+  i64_t i, at, size;
+
+  if (s == NULL || s->err != NULL)
+    return -1;
+  if (n <= 0)
+    return s->pending;
+
+  vals = AS_LIST(s->table)[1];
+  for (i = 0; i < vals->len; i++) {
+    if (datas == NULL || datas[i] == NULL) {
+      s->err = err_user("Missing append column data");
+      return -1;
+    }
+    if (AS_LIST(vals)[i]->type == TYPE_SYMBOL && (sym_offs == NULL || sym_offs[i] == NULL)) {
+      s->err = err_user("Symbol column without offsets");
+      return -1;
+    }
+  }
+
+  if (!append_reserve(s, s->rows + s->pending + n)) {
+    s->err = err_user("Out of memory: failed to grow append columns");
+    return -1;
+  }
+
+  // Columns may have moved while growing
+  vals = AS_LIST(s->table)[1];
+  at = s->rows + s->pending;
+  for (i = 0; i < vals->len; i++) {
+    col = AS_LIST(vals)[i];
+    if (col->type == TYPE_SYMBOL) {
+      intern_symbols_bulk((lit_p)datas[i], sym_offs[i], AS_SYMBOL(col) + at, n);
+    } else {
+      size = get_element_size(col->type);
+      memcpy(AS_C8(col) + at * size, datas[i], n * size);
+    }
+  }
+
+  s->pending += n;
+  return s->pending;
+}
+
+// Publish pending rows and return the table as a consistent snapshot.
+// Drop the previous snapshot first to keep this O(pending rows).
+EMSCRIPTEN_KEEPALIVE obj_p append_flush(append_session_p s) {
+  obj_p vals;
+  i64_t i;
+
+  if (s == NULL)
+    return err_user("Invalid append session");
+  if (s->err != NULL)
+    return clone_obj(s->err);
+
+  if (s->pending > 0) {
+    if (!append_exclusive(s) && !append_private(s, s->cap)) {
+      s->err = err_user("Out of memory: failed to publish appended rows");
+      return clone_obj(s->err);
+    }
+    vals = AS_LIST(s->table)[1];
+    for (i = 0; i < vals->len; i++)
+      AS_LIST(vals)[i]->len = s->rows + s->pending;
+    s->rows += s->pending;
+    s->pending = 0;
+  }
+
+  return clone_obj(s->table);
+}
+
+// Flush and close a session, returning the final table
+EMSCRIPTEN_KEEPALIVE obj_p append_end(append_session_p s) {
+  obj_p t;
+
+  if (s == NULL)
+    return err_user("Invalid append session");
+
+  t = append_flush(s);
+  append_session_free(s);
+  return t;
+}
+
+// ============================================================================
+// Materialized Views
+// ============================================================================
+
+// Group-by aggregations maintained incrementally: mview_update() folds only
+// the rows appended since the last call into per-group accumulators, and
+// mview_read() builds the result from the accumulators in O(groups).
+
+#define MVIEW_SUM 0
+#define MVIEW_AVG 1
+#define MVIEW_MIN 2
+#define MVIEW_MAX 3
+#define MVIEW_COUNT 4
+#define MVIEW_FIRST 5
+#define MVIEW_LAST 6
+
+typedef union mview_acc_t {
+  i64_t i;
+  f64_t f;
+} mview_acc_t;
+
+typedef struct mview_t {
+  i64_t nkeys;
+  i64_t naggs;
+  i32_t *key_cols; // source column positions
+  i8_t *key_types;
+  i64_t *key_offs; // byte offset of each key in a packed group key
+  i64_t key_width;
+  i32_t *agg_ops;
+  i32_t *agg_cols;
+  i8_t *agg_types; // source column types
+  i64_t rows;      // source rows folded in so far
+  i64_t ngroups;
+  i64_t gcap;
+  u8_t *keys;        // ngroups packed group keys
+  mview_acc_t *acc;  // ngroups * naggs accumulators
+  i64_t *cnt;        // ngroups * naggs non-null counts (rows for count,
+                     // first and last)
+  i32_t *slots;      // open addressing over 1-based group ids
+  i64_t scap;
+} *mview_p;
+
+static nil_t mview_release(mview_p v) {
+  free(v->key_cols);
+  free(v->key_types);
+  free(v->key_offs);
+  free(v->agg_ops);
+  free(v->agg_cols);
+  free(v->agg_types);
+  free(v->keys);
+  free(v->acc);
+  free(v->cnt);
+  free(v->slots);
+  free(v);
+}
+
+static b8_t mview_float(i8_t type) { return type == TYPE_F64; }
+
+// Element `i` of a numeric, temporal or symbol column, widened; `null` is
+// set for the NULL_* sentinels (NaN for F64)
+static mview_acc_t mview_value(obj_p col, i64_t i, b8_t *null) {
+  mview_acc_t v;
+  u8_t *p = (u8_t *)AS_C8(col);
+
+  *null = B8_FALSE;
+  switch (col->type) {
+  case TYPE_B8:
+  case TYPE_U8:
+    v.i = p[i];
+    break;
+  case TYPE_I16:
+    v.i = ((i16_t *)p)[i];
+    *null = v.i == NULL_I16;
+    break;
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    v.i = ((i32_t *)p)[i];
+    *null = v.i == NULL_I32;
+    break;
+  case TYPE_F64:
+    v.f = ((f64_t *)p)[i];
+    *null = kern_f64_null(v.f);
+    break;
+  default: // I64, TIMESTAMP, SYMBOL
+    v.i = ((i64_t *)p)[i];
+    *null = col->type != TYPE_SYMBOL && v.i == NULL_I64;
+    break;
+  }
+  return v;
+}
+
+// Output type of an aggregate over a source column type
+static i8_t mview_out_type(i32_t op, i8_t type) {
+  switch (op) {
+  case MVIEW_SUM:
+    return mview_float(type) ? TYPE_F64 : TYPE_I64;
+  case MVIEW_AVG:
+    return TYPE_F64;
+  case MVIEW_COUNT:
+    return TYPE_I64;
+  default:
+    return type;
+  }
+}
+
+// Create a view over a table: `keys` holds the group-by column positions,
+// `aggs` (op, column position) pairs. Returns NULL for unsupported specs
+// (sum/avg of non-numeric columns, min/max of symbols, non fixed-width
+// columns).
+EMSCRIPTEN_KEEPALIVE mview_p mview_new(obj_p t, i32_t *keys, i32_t nkeys,
+                                       i32_t *aggs, i32_t naggs) {
+  mview_p v;
+  obj_p vals, col;
+  i64_t i;
+  i32_t op;
+  i8_t type;
+
+  if (t == NULL || t->type != TYPE_TABLE || nkeys <= 0 || naggs <= 0 ||
+      keys == NULL || aggs == NULL)
+    return NULL;
+
+  vals = AS_LIST(t)[1];
+  v = (mview_p)calloc(1, sizeof(struct mview_t));
+  if (v == NULL)
+    return NULL;
+
+  v->nkeys = nkeys;
+  v->naggs = naggs;
+  v->key_cols = (i32_t *)malloc(nkeys * sizeof(i32_t));
+  v->key_types = (i8_t *)malloc(nkeys);
+  v->key_offs = (i64_t *)malloc(nkeys * sizeof(i64_t));
+  v->agg_ops = (i32_t *)malloc(naggs * sizeof(i32_t));
+  v->agg_cols = (i32_t *)malloc(naggs * sizeof(i32_t));
+  v->agg_types = (i8_t *)malloc(naggs);
+  if (v->key_cols == NULL || v->key_types == NULL || v->key_offs == NULL ||
+      v->agg_ops == NULL || v->agg_cols == NULL || v->agg_types == NULL) {
+    mview_release(v);
+    return NULL;
+  }
+
+  for (i = 0; i < nkeys; i++) {
+    if (keys[i] < 0 || keys[i] >= vals->len) {
+      mview_release(v);
+      return NULL;
+    }
+    col = AS_LIST(vals)[keys[i]];
+    if (col->type <= TYPE_LIST || IS_ATOM(col) || get_element_size(col->type) == 0) {
+      mview_release(v);
+      return NULL;
+    }
+    v->key_cols[i] = keys[i];
+    v->key_types[i] = col->type;
+    v->key_offs[i] = v->key_width;
+    v->key_width += get_element_size(col->type);
+  }
+
+  for (i = 0; i < naggs; i++) {
+    op = aggs[2 * i];
+    if (op < MVIEW_SUM || op > MVIEW_LAST || aggs[2 * i + 1] < 0 ||
+        aggs[2 * i + 1] >= vals->len) {
+      mview_release(v);
+      return NULL;
+    }
+    type = AS_LIST(vals)[aggs[2 * i + 1]]->type;
+    if (IS_ATOM(AS_LIST(vals)[aggs[2 * i + 1]]) || type <= TYPE_LIST ||
+        type == TYPE_GUID || type == TYPE_C8 || type > TYPE_GUID ||
+        ((op == MVIEW_SUM || op == MVIEW_AVG) && (type == TYPE_SYMBOL || type == TYPE_DATE ||
+                                                   type == TYPE_TIME || type == TYPE_TIMESTAMP)) ||
+        ((op == MVIEW_MIN || op == MVIEW_MAX) && type == TYPE_SYMBOL)) {
+      mview_release(v);
+      return NULL;
+    }
+    v->agg_ops[i] = op;
+    v->agg_cols[i] = aggs[2 * i + 1];
+    v->agg_types[i] = type;
+  }
+
+  return v;
+}
+
+static u64_t mview_hash(mview_p v, u8_t *key) {
+  return fnv1a((lit_p)key, v->key_width, 0xcbf29ce484222325ULL);
+}
+
+// Grow group storage and rehash so slots stay at most half full
+static b8_t mview_grow(mview_p v) {
+  i64_t g, cap = v->gcap ? v->gcap * 2 : 1024, scap = cap * 2;
+  u64_t h;
+  u8_t *keys;
+  mview_acc_t *acc;
+  i64_t *cnt;
+  i32_t *slots;
+
+  keys = (u8_t *)realloc(v->keys, cap * v->key_width);
+  if (keys == NULL)
+    return B8_FALSE;
+  v->keys = keys;
+  acc = (mview_acc_t *)realloc(v->acc, cap * v->naggs * sizeof(mview_acc_t));
+  if (acc == NULL)
+    return B8_FALSE;
+  v->acc = acc;
+  cnt = (i64_t *)realloc(v->cnt, cap * v->naggs * sizeof(i64_t));
+  if (cnt == NULL)
+    return B8_FALSE;
+  v->cnt = cnt;
+  slots = (i32_t *)calloc(scap, sizeof(i32_t));
+  if (slots == NULL)
+    return B8_FALSE;
+
+  for (g = 0; g < v->ngroups; g++) {
+    h = mview_hash(v, v->keys + g * v->key_width) & (scap - 1);
+    while (slots[h])
+      h = (h + 1) & (scap - 1);
+    slots[h] = (i32_t)(g + 1);
+  }
+
+  free(v->slots);
+  v->slots = slots;
+  v->scap = scap;
+  v->gcap = cap;
+  return B8_TRUE;
+}
+
+// Fold one value into an accumulator
+static nil_t mview_fold(mview_p v, i64_t k, i64_t g, obj_p col, i64_t row) {
+  mview_acc_t *a = &v->acc[g * v->naggs + k];
+  i64_t *n = &v->cnt[g * v->naggs + k];
+  b8_t null, fl = mview_float(v->agg_types[k]);
+  mview_acc_t x;
+
+  if (v->agg_ops[k] == MVIEW_COUNT) {
+    (*n)++;
+    return;
+  }
+
+  x = mview_value(col, row, &null);
+
+  // Like the engine's first/last: the value of the first or last row, null
+  // or not (a null keeps its sentinel through mview_store)
+  if (v->agg_ops[k] == MVIEW_FIRST || v->agg_ops[k] == MVIEW_LAST) {
+    if (v->agg_ops[k] == MVIEW_LAST || !*n)
+      *a = x;
+    (*n)++;
+    return;
+  }
+
+  if (null)
+    return;
+
+  switch (v->agg_ops[k]) {
+  case MVIEW_SUM:
+  case MVIEW_AVG:
+    if (fl)
+      a->f = *n ? a->f + x.f : x.f;
+    else
+      a->i = *n ? a->i + x.i : x.i;
+    break;
+  case MVIEW_MIN:
+    if (!*n || (fl ? x.f < a->f : x.i < a->i))
+      *a = x;
+    break;
+  case MVIEW_MAX:
+    if (!*n || (fl ? x.f > a->f : x.i > a->i))
+      *a = x;
+    break;
+  }
+  (*n)++;
+}
+
+// Fold the rows of `t` past those already seen. `t` must be the view's
+// source table or a later snapshot of it (same columns, only appended to).
+// Returns the number of groups, -1 if the table does not match, or -2 when
+// interrupted (the rows folded so far are kept; the next update resumes).
+EMSCRIPTEN_KEEPALIVE i64_t mview_update(mview_p v, obj_p t) {
+  obj_p vals, col;
+  i64_t i, k, g, rows, size;
+  u8_t key[256];
+  u8_t *kp;
+  u64_t h;
+
+  if (v == NULL || t == NULL || t->type != TYPE_TABLE)
+    return -1;
+
+  vals = AS_LIST(t)[1];
+  for (i = 0; i < v->nkeys; i++)
+    if (v->key_cols[i] >= vals->len || AS_LIST(vals)[v->key_cols[i]]->type != v->key_types[i])
+      return -1;
+  for (i = 0; i < v->naggs; i++)
+    if (v->agg_cols[i] >= vals->len || AS_LIST(vals)[v->agg_cols[i]]->type != v->agg_types[i])
+      return -1;
+
+  rows = table_count(t);
+  if (rows < v->rows)
+    return -1;
+  kp = v->key_width <= (i64_t)sizeof(key) ? key : (u8_t *)malloc(v->key_width);
+  if (kp == NULL)
+    return -1;
+
+  for (i = v->rows; i < rows; i++) {
+    if (i > v->rows && (i - v->rows) % INTERRUPT_BLOCK == 0 && interrupted()) {
+      if (kp != key)
+        free(kp);
+      v->rows = i;
+      return -2;
+    }
+    for (k = 0; k < v->nkeys; k++) {
+      col = AS_LIST(vals)[v->key_cols[k]];
+      size = get_element_size(col->type);
+      memcpy(kp + v->key_offs[k], (u8_t *)AS_C8(col) + i * size, size);
+    }
+
+    if (v->ngroups * 2 >= v->scap && !mview_grow(v)) {
+      if (kp != key)
+        free(kp);
+      return -1;
+    }
+
+    h = mview_hash(v, kp) & (v->scap - 1);
+    while (v->slots[h] &&
+           memcmp(v->keys + (v->slots[h] - 1) * v->key_width, kp, v->key_width) != 0)
+      h = (h + 1) & (v->scap - 1);
+    if (!v->slots[h]) {
+      g = v->ngroups++;
+      memcpy(v->keys + g * v->key_width, kp, v->key_width);
+      memset(v->acc + g * v->naggs, 0, v->naggs * sizeof(mview_acc_t));
+      memset(v->cnt + g * v->naggs, 0, v->naggs * sizeof(i64_t));
+      v->slots[h] = (i32_t)(g + 1);
+    }
+    g = v->slots[h] - 1;
+
+    for (k = 0; k < v->naggs; k++)
+      mview_fold(v, k, g, AS_LIST(vals)[v->agg_cols[k]], i);
+  }
+
+  if (kp != key)
+    free(kp);
+  v->rows = rows;
+  return v->ngroups;
+}
+
+// Store a widened value into element `i` of an output column
+static nil_t mview_store(obj_p col, i64_t i, mview_acc_t x, b8_t null) {
+  u8_t *p = (u8_t *)AS_C8(col);
+
+  switch (col->type) {
+  case TYPE_B8:
+  case TYPE_U8:
+    p[i] = null ? 0 : (u8_t)x.i;
+    break;
+  case TYPE_I16:
+    ((i16_t *)p)[i] = null ? NULL_I16 : (i16_t)x.i;
+    break;
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    ((i32_t *)p)[i] = null ? NULL_I32 : (i32_t)x.i;
+    break;
+  case TYPE_F64:
+    ((f64_t *)p)[i] = null ? NULL_F64 : x.f;
+    break;
+  default:
+    ((i64_t *)p)[i] = null ? NULL_I64 : x.i;
+    break;
+  }
+}
+
+// Current result as a table: the key columns, then one column per
+// aggregate, named by `names` (nkeys + naggs symbols)
+EMSCRIPTEN_KEEPALIVE obj_p mview_read(mview_p v, obj_p names) {
+  obj_p vals, col;
+  i64_t i, k, g, size;
+  i8_t type;
+  mview_acc_t x;
+  i64_t n;
+
+  if (v == NULL)
+    return err_user("Invalid materialized view");
+  if (names == NULL || names->type != TYPE_SYMBOL || names->len != v->nkeys + v->naggs)
+    return err_user("Expected one name per key and aggregate");
+
+  vals = LIST(v->nkeys + v->naggs);
+  if (vals == NULL)
+    return err_user("Failed to allocate view result");
+  for (i = 0; i < vals->len; i++)
+    AS_LIST(vals)[i] = NULL_OBJ;
+
+  for (k = 0; k < v->nkeys; k++) {
+    col = vector(v->key_types[k], v->ngroups);
+    if (col == NULL) {
+      drop_obj(vals);
+      return err_user("Failed to allocate view result");
+    }
+    size = get_element_size(col->type);
+    for (g = 0; g < v->ngroups; g++)
+      memcpy((u8_t *)AS_C8(col) + g * size, v->keys + g * v->key_width + v->key_offs[k], size);
+    AS_LIST(vals)[k] = col;
+  }
+
+  for (k = 0; k < v->naggs; k++) {
+    type = mview_out_type(v->agg_ops[k], v->agg_types[k]);
+    col = vector(type, v->ngroups);
+    if (col == NULL) {
+      drop_obj(vals);
+      return err_user("Failed to allocate view result");
+    }
+    for (g = 0; g < v->ngroups; g++) {
+      x = v->acc[g * v->naggs + k];
+      n = v->cnt[g * v->naggs + k];
+      if (v->agg_ops[k] == MVIEW_COUNT) {
+        x.i = n;
+        n = 1;
+      } else if (v->agg_ops[k] == MVIEW_AVG) {
+        x.f = n ? (mview_float(v->agg_types[k]) ? x.f : (f64_t)x.i) / (f64_t)n : 0;
+      } else if (v->agg_ops[k] == MVIEW_SUM && n == 0) {
+        // Sum over no values is zero (all-zero bits for I64 and F64 alike)
+        x.i = 0;
+        n = 1;
+      }
+      mview_store(col, g, x, n == 0);
+    }
+    AS_LIST(vals)[v->nkeys + k] = col;
+  }
+
+  return table(clone_obj(names), vals);
+}
+
+// Free a view
+EMSCRIPTEN_KEEPALIVE nil_t mview_free(mview_p v) {
+  if (v != NULL)
+    mview_release(v);
+}
+
+// ============================================================================
+// Arrow IPC
+// ============================================================================
+
+// Tables are exchanged with Apache Arrow as an IPC stream: a Schema message,
+// one DictionaryBatch per symbol column, a single RecordBatch and the
+// end-of-stream marker. Message metadata are flatbuffers written back to
+// front by the minimal builder below; message bodies are 8-byte aligned.
+
+#define ARROW_CONTINUATION ((i32_t)0xFFFFFFFF)
+#define ARROW_V5 4
+
+// MessageHeader union tags
+#define ARROW_MSG_NONE 0
+#define ARROW_MSG_SCHEMA 1
+#define ARROW_MSG_DICTIONARY 2
+#define ARROW_MSG_RECORD_BATCH 3
+
+// Type union tags
+#define ARROW_TYPE_INT 2
+#define ARROW_TYPE_FLOAT 3
+#define ARROW_TYPE_UTF8 5
+#define ARROW_TYPE_BOOL 6
+#define ARROW_TYPE_DATE 8
+#define ARROW_TYPE_TIME 9
+#define ARROW_TYPE_TIMESTAMP 10
+#define ARROW_TYPE_FIXED_BINARY 15
+
+// Rayforce epochs start at 2000-01-01, Arrow ones at 1970-01-01
+#define ARROW_DATE_SHIFT 10957
+#define ARROW_TIMESTAMP_SHIFT 946684800000000000LL
+
+#define FB_MAX_SLOTS 8
+
+// Flatbuffer builder. Data grows down from the end of `buf`; offsets are
+// measured from that end, so they stay valid when the buffer is regrown.
+typedef struct fb_t {
+  u8_t *buf;
+  i64_t cap;
+  i64_t head;     // first used byte
+  i64_t minalign; // largest alignment requested so far
+  i64_t table;    // size when the open table was started
+  i64_t slots[FB_MAX_SLOTS];
+  i64_t nslots;
+  b8_t oom;
+} fb_t;
+
+static i64_t fb_size(fb_t *fb) { return fb->cap - fb->head; }
+
+static nil_t fb_reset(fb_t *fb) {
+  fb->head = fb->cap;
+  fb->minalign = 1;
+  fb->nslots = 0;
+}
+
+static b8_t fb_grow(fb_t *fb, i64_t need) {
+  i64_t cap, size;
+  u8_t *buf;
+
+  if (fb->head >= need)
+    return B8_TRUE;
+
+  size = fb_size(fb);
+  cap = fb->cap ? fb->cap : 1024;
+  while (cap - size < need)
+    cap *= 2;
+
+  buf = (u8_t *)malloc(cap);
+  if (buf == NULL) {
+    fb->oom = B8_TRUE;
+    return B8_FALSE;
+  }
+  if (size > 0)
+    memcpy(buf + cap - size, fb->buf + fb->head, size);
+  free(fb->buf);
+  fb->buf = buf;
+  fb->head = cap - size;
+  fb->cap = cap;
+  return B8_TRUE;
+}
+
+static nil_t fb_push(fb_t *fb, raw_p src, i64_t n) {
+  if (!fb_grow(fb, n))
+    return;
+  fb->head -= n;
+  memcpy(fb->buf + fb->head, src, n);
+}
+
+static nil_t fb_pad(fb_t *fb, i64_t n) {
+  if (!fb_grow(fb, n))
+    return;
+  fb->head -= n;
+  memset(fb->buf + fb->head, 0, n);
+}
+
+// Align so that `align` holds once `extra` more bytes are pushed
+static nil_t fb_prep(fb_t *fb, i64_t align, i64_t extra) {
+  if (align > fb->minalign)
+    fb->minalign = align;
+  fb_pad(fb, (~(fb_size(fb) + extra) + 1) & (align - 1));
+}
+
+static nil_t fb_i8(fb_t *fb, i8_t v) { fb_push(fb, &v, 1); }
+
+static nil_t fb_i16(fb_t *fb, i16_t v) {
+  fb_prep(fb, 2, 0);
+  fb_push(fb, &v, 2);
+}
+
+static nil_t fb_i32(fb_t *fb, i32_t v) {
+  fb_prep(fb, 4, 0);
+  fb_push(fb, &v, 4);
+}
+
+static nil_t fb_i64(fb_t *fb, i64_t v) {
+  fb_prep(fb, 8, 0);
+  fb_push(fb, &v, 8);
+}
+
+// Offset from the pushed position forward to `target`
+static nil_t fb_uoffset(fb_t *fb, i64_t target) {
+  fb_prep(fb, 4, 0);
+  fb_i32(fb, (i32_t)(fb_size(fb) + 4 - target));
+}
+
+static i64_t fb_string(fb_t *fb, lit_p s, i64_t n) {
+  i32_t len = (i32_t)n;
+  fb_prep(fb, 4, n + 1);
+  fb_pad(fb, 1);
+  fb_push(fb, (raw_p)s, n);
+  fb_push(fb, &len, 4);
+  return fb_size(fb);
+}
+
+// Elements are pushed last to first between start and end
+static nil_t fb_start_vector(fb_t *fb, i64_t elem, i64_t n, i64_t align) {
+  fb_prep(fb, 4, elem * n);
+  fb_prep(fb, align, elem * n);
+}
+
+static i64_t fb_end_vector(fb_t *fb, i64_t n) {
+  i32_t len = (i32_t)n;
+  fb_push(fb, &len, 4);
+  return fb_size(fb);
+}
+
+static nil_t fb_start_table(fb_t *fb) {
+  memset(fb->slots, 0, sizeof(fb->slots));
+  fb->nslots = 0;
+  fb->table = fb_size(fb);
+}
+
+static nil_t fb_slot(fb_t *fb, i64_t id) {
+  fb->slots[id] = fb_size(fb);
+  if (id + 1 > fb->nslots)
+    fb->nslots = id + 1;
+}
+
+static nil_t fb_field_i8(fb_t *fb, i64_t id, i8_t v) {
+  fb_i8(fb, v);
+  fb_slot(fb, id);
+}
+
+static nil_t fb_field_i16(fb_t *fb, i64_t id, i16_t v) {
+  fb_i16(fb, v);
+  fb_slot(fb, id);
+}
+
+static nil_t fb_field_i32(fb_t *fb, i64_t id, i32_t v) {
+  fb_i32(fb, v);
+  fb_slot(fb, id);
+}
+
+static nil_t fb_field_i64(fb_t *fb, i64_t id, i64_t v) {
+  fb_i64(fb, v);
+  fb_slot(fb, id);
+}
+
+static nil_t fb_field_offset(fb_t *fb, i64_t id, i64_t target) {
+  fb_uoffset(fb, target);
+  fb_slot(fb, id);
+}
+
+// Close the open table: write its vtable right below it and point the
+// table's leading soffset at it
+static i64_t fb_end_table(fb_t *fb) {
+  i64_t i, obj, vt;
+  i32_t soffset;
+
+  fb_i32(fb, 0);
+  obj = fb_size(fb);
+
+  for (i = fb->nslots - 1; i >= 0; i--)
+    fb_i16(fb, fb->slots[i] ? (i16_t)(obj - fb->slots[i]) : 0);
+  fb_i16(fb, (i16_t)(obj - fb->table));
+  fb_i16(fb, (i16_t)((fb->nslots + 2) * 2));
+  vt = fb_size(fb);
+
+  if (!fb->oom) {
+    soffset = (i32_t)(vt - obj);
+    memcpy(fb->buf + fb->cap - obj, &soffset, 4);
+  }
+  return obj;
+}
+
+static nil_t fb_finish(fb_t *fb, i64_t root) {
+  fb_prep(fb, fb->minalign, 4);
+  fb_uoffset(fb, root);
+}
+
+// Growable output buffer
+typedef struct arrow_buf_t {
+  u8_t *data;
+  i64_t len;
+  i64_t cap;
+  b8_t oom;
+} arrow_buf_t;
+
+// Append `n` uninitialized bytes; the pointer is valid until the next call
+static u8_t *arrow_buf_alloc(arrow_buf_t *b, i64_t n) {
+  i64_t cap;
+  u8_t *data;
+
+  if (b->data == NULL || b->len + n > b->cap) {
+    cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + n)
+      cap *= 2;
+    data = (u8_t *)realloc(b->data, cap);
+    if (data == NULL) {
+      b->oom = B8_TRUE;
+      return NULL;
+    }
+    b->data = data;
+    b->cap = cap;
+  }
+
+  data = b->data + b->len;
+  b->len += n;
+  return data;
+}
+
+// Body of one batch message together with its FieldNode and Buffer entries
+typedef struct arrow_batch_t {
+  arrow_buf_t body;
+  i64_t *nodes; // (length, null_count) pairs
+  i64_t nnodes;
+  i64_t *bufs; // (offset, length) pairs
+  i64_t nbufs;
+} arrow_batch_t;
+
+static nil_t arrow_node(arrow_batch_t *b, i64_t len, i64_t nulls) {
+  b->nodes[b->nnodes * 2] = len;
+  b->nodes[b->nnodes * 2 + 1] = nulls;
+  b->nnodes++;
+}
+
+// Append a body buffer of `len` bytes (zero-padded to 8). Returns where
+// the caller writes its data, or NULL when out of memory.
+static u8_t *arrow_buffer(arrow_batch_t *b, i64_t len) {
+  i64_t offset = b->body.len, padded = (len + 7) & ~7LL;
+  u8_t *data = arrow_buf_alloc(&b->body, padded);
+
+  if (data == NULL)
+    return NULL;
+  memset(data + len, 0, padded - len);
+
+  b->bufs[b->nbufs * 2] = offset;
+  b->bufs[b->nbufs * 2 + 1] = len;
+  b->nbufs++;
+  return data;
+}
+
+// Symbol column dictionary: the distinct ids and every row's index into them
+typedef struct arrow_dict_t {
+  i64_t *ids;
+  i64_t n;
+  i32_t *idx;
+} arrow_dict_t;
+
+static b8_t arrow_dict_build(obj_p col, arrow_dict_t *d) {
+  i64_t i, id, cap = 16, rows = col->len;
+  i32_t *slots;
+  u64_t h;
+
+  while (cap < rows * 2)
+    cap *= 2;
+
+  slots = (i32_t *)calloc(cap, sizeof(i32_t));
+  d->ids = (i64_t *)malloc((rows ? rows : 1) * sizeof(i64_t));
+  d->idx = (i32_t *)malloc((rows ? rows : 1) * sizeof(i32_t));
+  d->n = 0;
+  if (slots == NULL || d->ids == NULL || d->idx == NULL) {
+    free(slots);
+    return B8_FALSE;
+  }
+
+  // Open addressing over 1-based dictionary positions (0 = empty slot)
+  for (i = 0; i < rows; i++) {
+    id = AS_SYMBOL(col)[i];
+    h = (u64_t)id * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 32)) & (cap - 1);
+    while (slots[h] && d->ids[slots[h] - 1] != id)
+      h = (h + 1) & (cap - 1);
+    if (!slots[h]) {
+      d->ids[d->n] = id;
+      slots[h] = (i32_t)++d->n;
+    }
+    d->idx[i] = slots[h] - 1;
+  }
+
+  free(slots);
+  return B8_TRUE;
+}
+
+// Arrow layout of a column: its rayforce type, TYPE_C8 for a list of
+// strings, or -1 when it has no Arrow counterpart
+static i8_t arrow_col_kind(obj_p col) {
+  i64_t i;
+
+  if (col == NULL || IS_ATOM(col))
+    return -1;
+
+  switch (col->type) {
+  case TYPE_B8:
+  case TYPE_U8:
+  case TYPE_I16:
+  case TYPE_I32:
+  case TYPE_I64:
+  case TYPE_SYMBOL:
+  case TYPE_DATE:
+  case TYPE_TIME:
+  case TYPE_TIMESTAMP:
+  case TYPE_F64:
+  case TYPE_GUID:
+    return col->type;
+  case TYPE_LIST:
+    for (i = 0; i < col->len; i++)
+      if (AS_LIST(col)[i] == NULL || AS_LIST(col)[i]->type != TYPE_C8)
+        return -1;
+    return TYPE_C8;
+  default:
+    return -1;
+  }
+}
+
+static nil_t arrow_mark(u8_t *bits, i64_t i, b8_t valid, i64_t *nulls) {
+  if (!valid)
+    (*nulls)++;
+  else if (bits != NULL)
+    bits[i >> 3] |= (u8_t)(1 << (i & 7));
+}
+
+// Count the nulls of a column; with `bits`, also set its validity bitmap
+static i64_t arrow_nulls(obj_p col, u8_t *bits) {
+  i64_t i, nulls = 0;
+
+  switch (col->type) {
+  case TYPE_I16:
+    for (i = 0; i < col->len; i++)
+      arrow_mark(bits, i, AS_I16(col)[i] != NULL_I16, &nulls);
+    break;
+  case TYPE_I32:
+  case TYPE_DATE:
+  case TYPE_TIME:
+    for (i = 0; i < col->len; i++)
+      arrow_mark(bits, i, AS_I32(col)[i] != NULL_I32, &nulls);
+    break;
+  case TYPE_I64:
+  case TYPE_TIMESTAMP:
+    for (i = 0; i < col->len; i++)
+      arrow_mark(bits, i, AS_I64(col)[i] != NULL_I64, &nulls);
+    break;
+  case TYPE_F64:
+    for (i = 0; i < col->len; i++)
+      arrow_mark(bits, i, !kern_f64_null(AS_F64(col)[i]), &nulls);
+    break;
+  default:
+    break;
+  }
+
+  return nulls;
+}
+
+// Append a Utf8 array (no nulls) of `n` strings taken either from symbol
+// `ids` or from a list of C8 vectors
+static b8_t arrow_write_utf8(arrow_batch_t *b, obj_p list, i64_t *ids,
+                             i64_t n) {
+  i64_t i, at, len, total = 0;
+  i32_t *offsets;
+  u8_t *data;
+  lit_p s;
+
+  arrow_node(b, n, 0);
+  arrow_buffer(b, 0);
+
+  at = b->body.len;
+  if (arrow_buffer(b, (n + 1) * sizeof(i32_t)) == NULL)
+    return B8_FALSE;
+  offsets = (i32_t *)(b->body.data + at);
+  offsets[0] = 0;
+  for (i = 0; i < n; i++) {
+    if (ids != NULL) {
+      s = str_from_symbol(ids[i]);
+      total += s ? (i64_t)strlen(s) : 0;
+    } else {
+      total += AS_LIST(list)[i]->len;
+    }
+    offsets[i + 1] = (i32_t)total;
+  }
+
+  data = arrow_buffer(b, total);
+  if (data == NULL)
+    return B8_FALSE;
+  offsets = (i32_t *)(b->body.data + at);
+  for (i = 0; i < n; i++) {
+    len = offsets[i + 1] - offsets[i];
+    if (len == 0)
+      continue;
+    s = ids != NULL ? str_from_symbol(ids[i]) : AS_C8(AS_LIST(list)[i]);
+    memcpy(data + offsets[i], s, len);
+  }
+
+  return B8_TRUE;
+}
+
+// Append one column of the record batch
+static b8_t arrow_write_column(arrow_batch_t *b, obj_p col, i8_t kind,
+                               arrow_dict_t *dict) {
+  i64_t i, n = col->len, nulls, size;
+  u8_t *bits, *data;
+
+  if (kind == TYPE_C8)
+    return arrow_write_utf8(b, col, NULL, n);
+
+  nulls = arrow_nulls(col, NULL);
+  arrow_node(b, n, nulls);
+
+  bits = arrow_buffer(b, nulls ? (n + 7) / 8 : 0);
+  if (bits == NULL)
+    return B8_FALSE;
+  if (nulls) {
+    memset(bits, 0, (n + 7) / 8);
+    arrow_nulls(col, bits);
+  }
+
+  switch (kind) {
+  case TYPE_B8:
+    data = arrow_buffer(b, (n + 7) / 8);
+    if (data == NULL)
+      return B8_FALSE;
+    memset(data, 0, (n + 7) / 8);
+    for (i = 0; i < n; i++)
+      if (AS_C8(col)[i])
+        data[i >> 3] |= (u8_t)(1 << (i & 7));
+    break;
+  case TYPE_SYMBOL:
+    data = arrow_buffer(b, n * sizeof(i32_t));
+    if (data == NULL)
+      return B8_FALSE;
+    if (n > 0)
+      memcpy(data, dict->idx, n * sizeof(i32_t));
+    break;
+  case TYPE_DATE:
+    data = arrow_buffer(b, n * sizeof(i32_t));
+    if (data == NULL)
+      return B8_FALSE;
+    for (i = 0; i < n; i++)
+      ((i32_t *)data)[i] = AS_I32(col)[i] == NULL_I32
+                               ? 0
+                               : AS_I32(col)[i] + ARROW_DATE_SHIFT;
+    break;
+  case TYPE_TIMESTAMP:
+    data = arrow_buffer(b, n * sizeof(i64_t));
+    if (data == NULL)
+      return B8_FALSE;
+    for (i = 0; i < n; i++)
+      ((i64_t *)data)[i] = AS_I64(col)[i] == NULL_I64
+                               ? 0
+                               : AS_I64(col)[i] + ARROW_TIMESTAMP_SHIFT;
+    break;
+  default:
+    size = n * get_element_size(kind);
+    data = arrow_buffer(b, size);
+    if (data == NULL)
+      return B8_FALSE;
+    if (size > 0)
+      memcpy(data, AS_C8(col), size);
+    break;
+  }
+
+  return B8_TRUE;
+}
+
+// Write the Arrow Type table of a column kind, storing its union tag
+static i64_t fb_arrow_type(fb_t *fb, i8_t kind, i8_t *tag) {
+  fb_start_table(fb);
+
+  switch (kind) {
+  case TYPE_B8:
+    *tag = ARROW_TYPE_BOOL;
+    break;
+  case TYPE_U8:
+  case TYPE_I16:
+  case TYPE_I32:
+  case TYPE_I64:
+    *tag = ARROW_TYPE_INT;
+    fb_field_i32(fb, 0, (i32_t)get_element_size(kind) * 8);
+    fb_field_i8(fb, 1, kind != TYPE_U8);
+    break;
+  case TYPE_F64:
+    *tag = ARROW_TYPE_FLOAT;
+    fb_field_i16(fb, 0, 2); // DOUBLE
+    break;
+  case TYPE_DATE:
+    *tag = ARROW_TYPE_DATE;
+    fb_field_i16(fb, 0, 0); // DAY
+    break;
+  case TYPE_TIME:
+    *tag = ARROW_TYPE_TIME;
+    fb_field_i32(fb, 1, 32);
+    fb_field_i16(fb, 0, 1); // MILLISECOND
+    break;
+  case TYPE_TIMESTAMP:
+    *tag = ARROW_TYPE_TIMESTAMP;
+    fb_field_i16(fb, 0, 3); // NANOSECOND
+    break;
+  case TYPE_GUID:
+    *tag = ARROW_TYPE_FIXED_BINARY;
+    fb_field_i32(fb, 0, 16);
+    break;
+  default: // TYPE_SYMBOL values and string lists
+    *tag = ARROW_TYPE_UTF8;
+    break;
+  }
+
+  return fb_end_table(fb);
+}
+
+// RecordBatch table describing the batch's nodes and buffers
+static i64_t fb_record_batch(fb_t *fb, arrow_batch_t *b, i64_t rows) {
+  i64_t i, nodes, bufs;
+
+  fb_start_vector(fb, 16, b->nbufs, 8);
+  for (i = b->nbufs - 1; i >= 0; i--) {
+    fb_i64(fb, b->bufs[i * 2 + 1]);
+    fb_i64(fb, b->bufs[i * 2]);
+  }
+  bufs = fb_end_vector(fb, b->nbufs);
+
+  fb_start_vector(fb, 16, b->nnodes, 8);
+  for (i = b->nnodes - 1; i >= 0; i--) {
+    fb_i64(fb, b->nodes[i * 2 + 1]);
+    fb_i64(fb, b->nodes[i * 2]);
+  }
+  nodes = fb_end_vector(fb, b->nnodes);
+
+  fb_start_table(fb);
+  fb_field_i64(fb, 0, rows);
+  fb_field_offset(fb, 1, nodes);
+  fb_field_offset(fb, 2, bufs);
+  return fb_end_table(fb);
+}
+
+// Arrow export state, released by arrow_writer_free
+typedef struct arrow_writer_t {
+  fb_t fb;
+  arrow_buf_t out;
+  arrow_batch_t batch;
+  arrow_dict_t *dicts; // per column, `ids` is NULL for non-symbol columns
+  i64_t *offs;         // per-column flatbuffer offsets
+  i8_t *kinds;
+  i64_t ncols;
+} arrow_writer_t;
+
+static nil_t arrow_writer_free(arrow_writer_t *w) {
+  i64_t i;
+
+  if (w->dicts != NULL) {
+    for (i = 0; i < w->ncols; i++) {
+      free(w->dicts[i].ids);
+      free(w->dicts[i].idx);
+    }
+  }
+  free(w->fb.buf);
+  free(w->out.data);
+  free(w->batch.body.data);
+  free(w->batch.nodes);
+  free(w->batch.bufs);
+  free(w->dicts);
+  free(w->offs);
+  free(w->kinds);
+}
+
+static obj_p arrow_writer_fail(arrow_writer_t *w, lit_p msg) {
+  arrow_writer_free(w);
+  return err_user(msg);
+}
+
+// Finish the flatbuffer as a Message and frame it, with the current batch
+// body when `with_body` is set, into the output stream
+static b8_t arrow_emit(arrow_writer_t *w, i8_t header_type, i64_t header,
+                       b8_t with_body) {
+  fb_t *fb = &w->fb;
+  i64_t body = with_body ? w->batch.body.len : 0, meta, padded, root;
+  i32_t marker = ARROW_CONTINUATION, size;
+  u8_t *p;
+
+  fb_start_table(fb);
+  fb_field_i64(fb, 3, body);
+  fb_field_offset(fb, 2, header);
+  fb_field_i16(fb, 0, ARROW_V5);
+  fb_field_i8(fb, 1, header_type);
+  root = fb_end_table(fb);
+  fb_finish(fb, root);
+  if (fb->oom)
+    return B8_FALSE;
+
+  meta = fb_size(fb);
+  padded = (meta + 7) & ~7LL;
+  p = arrow_buf_alloc(&w->out, 8 + padded + body);
+  if (p == NULL)
+    return B8_FALSE;
+
+  size = (i32_t)padded;
+  memcpy(p, &marker, 4);
+  memcpy(p + 4, &size, 4);
+  memcpy(p + 8, fb->buf + fb->head, meta);
+  memset(p + 8 + meta, 0, padded - meta);
+  if (body > 0)
+    memcpy(p + 8 + padded, w->batch.body.data, body);
+
+  fb_reset(fb);
+  w->batch.body.len = 0;
+  w->batch.nnodes = 0;
+  w->batch.nbufs = 0;
+  return B8_TRUE;
+}
+
+static b8_t arrow_write_schema(arrow_writer_t *w, obj_p keys) {
+  fb_t *fb = &w->fb;
+  i64_t i, name, type, dict, children, fields, index;
+  lit_p s;
+  i8_t tag;
+
+  for (i = 0; i < w->ncols; i++) {
+    s = str_from_symbol(AS_SYMBOL(keys)[i]);
+    name = fb_string(fb, s ? s : "", s ? (i64_t)strlen(s) : 0);
+    type = fb_arrow_type(fb, w->kinds[i], &tag);
+
+    fb_start_vector(fb, 4, 0, 4);
+    children = fb_end_vector(fb, 0);
+
+    dict = 0;
+    if (w->kinds[i] == TYPE_SYMBOL) {
+      fb_start_table(fb);
+      fb_field_i32(fb, 0, 32);
+      fb_field_i8(fb, 1, B8_TRUE);
+      index = fb_end_table(fb);
+
+      fb_start_table(fb);
+      fb_field_i64(fb, 0, i);
+      fb_field_offset(fb, 1, index);
+      dict = fb_end_table(fb);
+    }
+
+    fb_start_table(fb);
+    fb_field_offset(fb, 0, name);
+    fb_field_offset(fb, 3, type);
+    fb_field_offset(fb, 5, children);
+    if (dict)
+      fb_field_offset(fb, 4, dict);
+    fb_field_i8(fb, 2, tag);
+    fb_field_i8(fb, 1, B8_TRUE);
+    w->offs[i] = fb_end_table(fb);
+  }
+
+  fb_start_vector(fb, 4, w->ncols, 4);
+  for (i = w->ncols - 1; i >= 0; i--)
+    fb_uoffset(fb, w->offs[i]);
+  fields = fb_end_vector(fb, w->ncols);
+
+  fb_start_table(fb);
+  fb_field_offset(fb, 1, fields);
+  fb_field_i16(fb, 0, 0); // little endian
+  return arrow_emit(w, ARROW_MSG_SCHEMA, fb_end_table(fb), B8_FALSE);
+}
+
+// Export a table as an Arrow IPC stream (U8 vector), readable with
+// apache-arrow's tableFromIPC. Symbol columns become dictionary-encoded
+// Utf8, string lists plain Utf8; NULL_* sentinels and NaN become nulls.
+EMSCRIPTEN_KEEPALIVE obj_p export_arrow(obj_p t) {
+  arrow_writer_t w;
+  obj_p keys, vals, col, res;
+  i64_t i, rows, batch, dict;
+  i32_t eos[2] = {ARROW_CONTINUATION, 0};
+  u8_t *p;
+
+  if (t == NULL || t->type != TYPE_TABLE)
+    return err_user("export_arrow expects a table");
+
+  keys = AS_LIST(t)[0];
+  vals = AS_LIST(t)[1];
+  rows = table_count(t);
+
+  memset(&w, 0, sizeof(w));
+  w.ncols = keys->len;
+  w.kinds = (i8_t *)malloc(w.ncols + 1);
+  w.offs = (i64_t *)malloc((w.ncols + 1) * sizeof(i64_t));
+  w.dicts = (arrow_dict_t *)calloc(w.ncols + 1, sizeof(arrow_dict_t));
+  w.batch.nodes = (i64_t *)malloc((w.ncols + 1) * 2 * sizeof(i64_t));
+  w.batch.bufs = (i64_t *)malloc((w.ncols + 1) * 6 * sizeof(i64_t));
+  if (w.kinds == NULL || w.offs == NULL || w.dicts == NULL ||
+      w.batch.nodes == NULL || w.batch.bufs == NULL)
+    return arrow_writer_fail(&w, "Out of memory during Arrow export");
+
+  for (i = 0; i < w.ncols; i++) {
+    col = AS_LIST(vals)[i];
+    w.kinds[i] = arrow_col_kind(col);
+    if (w.kinds[i] < 0)
+      return arrow_writer_fail(&w, "Unsupported column type for Arrow export");
+    if (col->len != rows)
+      return arrow_writer_fail(&w, "Table columns differ in length");
+  }
+
+  if (!arrow_write_schema(&w, keys))
+    return arrow_writer_fail(&w, "Out of memory during Arrow export");
+
+  for (i = 0; i < w.ncols; i++) {
+    if (w.kinds[i] != TYPE_SYMBOL)
+      continue;
+    if (!arrow_dict_build(AS_LIST(vals)[i], &w.dicts[i]) ||
+        !arrow_write_utf8(&w.batch, NULL, w.dicts[i].ids, w.dicts[i].n))
+      return arrow_writer_fail(&w, "Out of memory during Arrow export");
+
+    batch = fb_record_batch(&w.fb, &w.batch, w.dicts[i].n);
+    fb_start_table(&w.fb);
+    fb_field_i64(&w.fb, 0, i);
+    fb_field_offset(&w.fb, 1, batch);
+    dict = fb_end_table(&w.fb);
+    if (!arrow_emit(&w, ARROW_MSG_DICTIONARY, dict, B8_TRUE))
+      return arrow_writer_fail(&w, "Out of memory during Arrow export");
+  }
+
+  for (i = 0; i < w.ncols; i++)
+    if (!arrow_write_column(&w.batch, AS_LIST(vals)[i], w.kinds[i], &w.dicts[i]))
+      return arrow_writer_fail(&w, "Out of memory during Arrow export");
+
+  batch = fb_record_batch(&w.fb, &w.batch, rows);
+  if (!arrow_emit(&w, ARROW_MSG_RECORD_BATCH, batch, B8_TRUE))
+    return arrow_writer_fail(&w, "Out of memory during Arrow export");
+
+  p = arrow_buf_alloc(&w.out, sizeof(eos));
+  if (p == NULL)
+    return arrow_writer_fail(&w, "Out of memory during Arrow export");
+  memcpy(p, eos, sizeof(eos));
+
+  res = vector(TYPE_U8, w.out.len);
+  if (res == NULL)
+    return arrow_writer_fail(&w, "Out of memory during Arrow export");
+  memcpy(AS_U8(res), w.out.data, w.out.len);
+
+  arrow_writer_free(&w);
+  return res;
 }
 
-// Upsert into table
-// Arguments: t = table, match_count = number of key columns, data = data
-EMSCRIPTEN_KEEPALIVE obj_p table_upsert(obj_p t, obj_p match_count,
-                                        obj_p data) {
-  if (t == NULL || data == NULL)
-    return NULL_OBJ;
-  obj_p args[3] = {t, match_count, data};
-  return ray_upsert(args, 3);
+// Bounds-checked flatbuffer reader over an IPC buffer. Positions are
+// absolute byte offsets into `buf`; any out-of-range access sets `bad`.
+typedef struct fbr_t {
+  const u8_t *buf;
+  i64_t len;
+  b8_t bad;
+} fbr_t;
+
+static b8_t fbr_ok(fbr_t *r, i64_t pos, i64_t n) {
+  if (pos < 0 || n < 0 || pos > r->len - n) {
+    r->bad = B8_TRUE;
+    return B8_FALSE;
+  }
+  return B8_TRUE;
 }
 
-// ============================================================================
-// Symbol Interning
-// ============================================================================
+static i64_t fbr_u8(fbr_t *r, i64_t pos) {
+  return fbr_ok(r, pos, 1) ? r->buf[pos] : 0;
+}
 
-// Intern a string as symbol and return ID
-EMSCRIPTEN_KEEPALIVE i64_t intern_symbol(lit_p str, i64_t len) {
-  obj_p sym = symbol(str, len);
-  i64_t id = sym->i64;
-  drop_obj(sym);
-  return id;
+static i64_t fbr_u16(fbr_t *r, i64_t pos) {
+  return fbr_ok(r, pos, 2) ? r->buf[pos] | (r->buf[pos + 1] << 8) : 0;
 }
 
-// ============================================================================
-// Binary Set/Get (global variable assignment)
-// ============================================================================
+static i64_t fbr_i16(fbr_t *r, i64_t pos) {
+  i16_t v = 0;
+  if (fbr_ok(r, pos, 2))
+    memcpy(&v, r->buf + pos, 2);
+  return v;
+}
 
-EMSCRIPTEN_KEEPALIVE obj_p global_set(obj_p name, obj_p val) {
-  if (name == NULL)
-    return NULL_OBJ;
-  return binary_set(name, val);
+static i64_t fbr_i32(fbr_t *r, i64_t pos) {
+  i32_t v = 0;
+  if (fbr_ok(r, pos, 4))
+    memcpy(&v, r->buf + pos, 4);
+  return v;
 }
 
-// Quote object (wrap in reference)
-EMSCRIPTEN_KEEPALIVE obj_p quote_obj(obj_p obj) {
-  if (obj == NULL)
-    return NULL_OBJ;
-  return ray_quote(obj);
+static i64_t fbr_u32(fbr_t *r, i64_t pos) {
+  u32_t v = 0;
+  if (fbr_ok(r, pos, 4))
+    memcpy(&v, r->buf + pos, 4);
+  return v;
 }
 
-// ============================================================================
-// Serialization
-// ============================================================================
+static i64_t fbr_i64(fbr_t *r, i64_t pos) {
+  i64_t v = 0;
+  if (fbr_ok(r, pos, 8))
+    memcpy(&v, r->buf + pos, 8);
+  return v;
+}
 
-// Serialize object to bytes
-EMSCRIPTEN_KEEPALIVE obj_p serialize(obj_p obj) {
-  if (obj == NULL)
-    return NULL_OBJ;
-  return ser_obj(obj);
+// Position of field `id` of the table at `t`, or 0 when it is absent
+static i64_t fbr_field(fbr_t *r, i64_t t, i64_t id) {
+  i64_t vt, off;
+
+  if (t <= 0)
+    return 0;
+  vt = t - fbr_i32(r, t);
+  if (4 + 2 * id >= fbr_u16(r, vt))
+    return 0;
+  off = fbr_u16(r, vt + 4 + 2 * id);
+  return off ? t + off : 0;
 }
 
-// Deserialize bytes to object
-EMSCRIPTEN_KEEPALIVE obj_p deserialize(obj_p buf) {
-  if (buf == NULL)
-    return NULL_OBJ;
-  return de_obj(buf);
+static i64_t fbr_field_u8(fbr_t *r, i64_t t, i64_t id, i64_t dflt) {
+  i64_t p = fbr_field(r, t, id);
+  return p ? fbr_u8(r, p) : dflt;
 }
 
-// ============================================================================
-// Type Name
-// ============================================================================
+static i64_t fbr_field_i16(fbr_t *r, i64_t t, i64_t id, i64_t dflt) {
+  i64_t p = fbr_field(r, t, id);
+  return p ? fbr_i16(r, p) : dflt;
+}
 
-EMSCRIPTEN_KEEPALIVE str_p get_type_name(i8_t type) { return type_name(type); }
+static i64_t fbr_field_i32(fbr_t *r, i64_t t, i64_t id, i64_t dflt) {
+  i64_t p = fbr_field(r, t, id);
+  return p ? fbr_i32(r, p) : dflt;
+}
 
-// ============================================================================
-// CSV Parsing
-// ============================================================================
+static i64_t fbr_field_i64(fbr_t *r, i64_t t, i64_t id, i64_t dflt) {
+  i64_t p = fbr_field(r, t, id);
+  return p ? fbr_i64(r, p) : dflt;
+}
 
-// Read CSV from string content
-// - Assumes types are all strings (C8) for simplicity in WASM
-// - Infers column names from first line
-EMSCRIPTEN_KEEPALIVE obj_p read_csv(lit_p content, i64_t len) {
-  i64_t i, l, lines;
-  str_p buf, pos, line, prev;
-  obj_p names, cols, res;
-  c8_t sep = ',';
+// Follow the offset in field `id` (table, vector or string), 0 if absent
+static i64_t fbr_ref(fbr_t *r, i64_t t, i64_t id) {
+  i64_t p = fbr_field(r, t, id);
+  return p ? p + fbr_u32(r, p) : 0;
+}
 
-  if (content == NULL) {
-    printf("ERROR: read_csv content is NULL\n");
-    return err_user("CSV content is NULL");
-  }
+// Vector in field `id`: returns the first element and stores the count
+static i64_t fbr_vec(fbr_t *r, i64_t t, i64_t id, i64_t *n) {
+  i64_t v = fbr_ref(r, t, id);
 
-  // We receive a heap pointer and byte length from JS.
-  // Trust the length passed in.
-  if (len <= 0) {
-    printf("ERROR: read_csv len <= 0\n");
-    return err_user("CSV length is zero or negative");
+  *n = v ? fbr_u32(r, v) : 0;
+  if (v && !fbr_ok(r, v + 4, *n))
+    *n = 0;
+  return v + 4;
+}
+
+// One framed IPC message
+typedef struct arrow_msg_t {
+  i8_t type;       // MessageHeader tag
+  i64_t header;    // header table
+  i64_t body;      // body start
+  i64_t body_len;
+} arrow_msg_t;
+
+// Read the message at `*pos` and advance past its body. Returns 1 for a
+// message, 0 at end-of-stream and -1 on malformed input. Both the
+// continuation-marker framing and the pre-1.0 length-only one are accepted.
+static i64_t arrow_next_msg(fbr_t *r, i64_t *pos, arrow_msg_t *m) {
+  i64_t p = *pos, meta_len, root;
+
+  if (p + 4 > r->len)
+    return 0;
+  meta_len = fbr_i32(r, p);
+  p += 4;
+  if (meta_len == ARROW_CONTINUATION) {
+    if (p + 4 > r->len)
+      return 0;
+    meta_len = fbr_i32(r, p);
+    p += 4;
   }
+  if (meta_len == 0)
+    return 0;
+  if (meta_len < 0 || !fbr_ok(r, p, meta_len))
+    return -1;
 
-  printf("INFO: read_csv starting, len=%lld bytes (%.1f MB)\n", len, len / (1024.0 * 1024.0));
+  root = p + fbr_u32(r, p);
+  m->type = (i8_t)fbr_field_u8(r, root, 1, ARROW_MSG_NONE);
+  m->header = fbr_ref(r, root, 2);
+  m->body_len = fbr_field_i64(r, root, 3, 0);
+  m->body = p + meta_len;
+  if (r->bad || m->body_len < 0 || !fbr_ok(r, m->body, m->body_len))
+    return -1;
 
-  // Since we receive a JS string pointer, we shouldn't modify it.
-  // However, parse_csv_lines expects a buffer it can read.
-  // We treat 'content' as the buffer.
-  buf = (str_p)content;
+  *pos = m->body + m->body_len;
+  return 1;
+}
 
-  // Count lines
-  lines = 0;
-  pos = buf;
-  while ((pos = (str_p)memchr(pos, '\n', buf + len - pos))) {
-    ++lines;
-    ++pos;
+// Schema field resolved to its rayforce column type
+typedef struct arrow_field_t {
+  i64_t name;    // name string
+  i8_t tag;      // Type union tag
+  i8_t rtype;    // rayforce column type, -1 when unsupported
+  i64_t width;   // source element (or dictionary index) size in bytes
+  b8_t is_signed;
+  i64_t unit;    // Date/Time/Timestamp unit
+  i64_t dict_id; // -1 unless dictionary-encoded
+} arrow_field_t;
+
+static nil_t arrow_field_resolve(fbr_t *r, i64_t f, arrow_field_t *af) {
+  i64_t type = fbr_ref(r, f, 3), dict = fbr_ref(r, f, 4), index, bits, n;
+
+  af->name = fbr_ref(r, f, 0);
+  af->tag = (i8_t)fbr_field_u8(r, f, 2, 0);
+  af->rtype = -1;
+  af->dict_id = -1;
+
+  fbr_vec(r, f, 5, &n);
+  if (n > 0)
+    return; // nested types
+
+  if (dict) {
+    if (af->tag != ARROW_TYPE_UTF8)
+      return;
+    index = fbr_ref(r, dict, 1);
+    af->dict_id = fbr_field_i64(r, dict, 0, 0);
+    af->width = index ? fbr_field_i32(r, index, 0, 32) / 8 : 4;
+    af->is_signed = index ? fbr_field_u8(r, index, 1, 0) != 0 : B8_TRUE;
+    if (af->width == 1 || af->width == 2 || af->width == 4 || af->width == 8)
+      af->rtype = TYPE_SYMBOL;
+    return;
   }
 
-  if (len > 0 && buf[len - 1] != '\n') {
-    ++lines;
+  switch (af->tag) {
+  case ARROW_TYPE_INT:
+    bits = fbr_field_i32(r, type, 0, 0);
+    af->width = bits / 8;
+    af->is_signed = fbr_field_u8(r, type, 1, 0) != 0;
+    if (bits == 8)
+      af->rtype = af->is_signed ? TYPE_I16 : TYPE_U8;
+    else if (bits == 16)
+      af->rtype = af->is_signed ? TYPE_I16 : TYPE_I32;
+    else if (bits == 32)
+      af->rtype = af->is_signed ? TYPE_I32 : TYPE_I64;
+    else if (bits == 64)
+      af->rtype = TYPE_I64;
+    break;
+  case ARROW_TYPE_FLOAT:
+    af->unit = fbr_field_i16(r, type, 0, 0);
+    af->width = af->unit == 2 ? 8 : 4;
+    if (af->unit == 1 || af->unit == 2) // SINGLE, DOUBLE
+      af->rtype = TYPE_F64;
+    break;
+  case ARROW_TYPE_UTF8:
+    af->rtype = TYPE_SYMBOL;
+    break;
+  case ARROW_TYPE_BOOL:
+    af->rtype = TYPE_B8;
+    break;
+  case ARROW_TYPE_DATE:
+    af->unit = fbr_field_i16(r, type, 0, 1);
+    af->width = af->unit == 0 ? 4 : 8;
+    af->rtype = TYPE_DATE;
+    break;
+  case ARROW_TYPE_TIME:
+    af->unit = fbr_field_i16(r, type, 0, 1);
+    af->width = fbr_field_i32(r, type, 1, 32) / 8;
+    if (af->width == 4 || af->width == 8)
+      af->rtype = TYPE_TIME;
+    break;
+  case ARROW_TYPE_TIMESTAMP:
+    af->unit = fbr_field_i16(r, type, 0, 0);
+    af->width = 8;
+    af->rtype = TYPE_TIMESTAMP;
+    break;
+  case ARROW_TYPE_FIXED_BINARY:
+    af->width = fbr_field_i32(r, type, 0, 0);
+    if (af->width == 16)
+      af->rtype = TYPE_GUID;
+    break;
+  default:
+    break;
   }
+}
 
-  if (lines == 0) {
-    printf("ERROR: read_csv no lines found\n");
-    return err_user("CSV has no lines");
-  }
+// Interned values of one dictionary id
+typedef struct arrow_symdict_t {
+  i64_t id;
+  i64_t *syms;
+  i64_t n;
+} arrow_symdict_t;
+
+// Arrow import state, released by arrow_reader_free
+typedef struct arrow_reader_t {
+  fbr_t r;
+  arrow_field_t *fields;
+  i64_t ncols;
+  arrow_symdict_t *dicts;
+  i64_t ndicts;
+  obj_p vals; // LIST of the columns being filled
+  i64_t rows;
+  i64_t empty; // id of the empty symbol, used for null strings
+} arrow_reader_t;
+
+static nil_t arrow_reader_free(arrow_reader_t *rd) {
+  i64_t i;
+
+  for (i = 0; i < rd->ndicts; i++)
+    free(rd->dicts[i].syms);
+  free(rd->dicts);
+  free(rd->fields);
+  if (rd->vals != NULL)
+    drop_obj(rd->vals);
+}
 
-  printf("INFO: read_csv found %lld lines\n", lines);
+static obj_p arrow_reader_fail(arrow_reader_t *rd, lit_p msg) {
+  arrow_reader_free(rd);
+  return err_user(msg);
+}
 
-  // Parse header
-  pos = (str_p)memchr(buf, '\n', len);
-  i64_t header_len = (pos == NULL) ? len : (pos - buf);
-  line = (pos == NULL) ? NULL : (pos + 1);
+static arrow_symdict_t *arrow_symdict(arrow_reader_t *rd, i64_t id) {
+  i64_t i;
 
-  // Count columns based on separator
-  l = 1;
-  pos = buf;
-  while ((pos = (str_p)memchr(pos, sep, header_len - (pos - buf)))) {
-    ++l;
-    ++pos;
+  for (i = 0; i < rd->ndicts; i++)
+    if (rd->dicts[i].id == id)
+      return &rd->dicts[i];
+  return NULL;
+}
+
+static b8_t arrow_read_schema(arrow_reader_t *rd, i64_t schema) {
+  fbr_t *r = &rd->r;
+  i64_t i, n, fields, f;
+
+  fields = fbr_vec(r, schema, 1, &n);
+  if (n == 0)
+    return B8_FALSE;
+
+  rd->ncols = n;
+  rd->fields = (arrow_field_t *)calloc(n, sizeof(arrow_field_t));
+  rd->dicts = (arrow_symdict_t *)calloc(n, sizeof(arrow_symdict_t));
+  if (rd->fields == NULL || rd->dicts == NULL)
+    return B8_FALSE;
+
+  for (i = 0; i < n; i++) {
+    f = fields + 4 * i;
+    f += fbr_u32(r, f);
+    arrow_field_resolve(r, f, &rd->fields[i]);
+    if (rd->fields[i].dict_id >= 0 && arrow_symdict(rd, rd->fields[i].dict_id) == NULL)
+      rd->dicts[rd->ndicts++].id = rd->fields[i].dict_id;
   }
 
-  printf("INFO: read_csv found %lld columns\n", l);
+  return !r->bad;
+}
 
-  names = SYMBOL(l);
-  if (names == NULL) {
-    printf("ERROR: read_csv failed to allocate names vector\n");
-    return err_user("Failed to allocate column names");
+// Buffer `i` of a record batch as a body pointer holding at least `need`
+// bytes (its full length is stored in `len`), or NULL
+static const u8_t *arrow_body_buf(arrow_reader_t *rd, arrow_msg_t *m,
+                                  i64_t bufs, i64_t nbufs, i64_t i,
+                                  i64_t need, i64_t *len) {
+  fbr_t *r = &rd->r;
+  i64_t offset, length;
+
+  if (i >= nbufs)
+    return NULL;
+  offset = fbr_i64(r, bufs + 16 * i);
+  length = fbr_i64(r, bufs + 16 * i + 8);
+  if (r->bad || offset < 0 || length < need || offset > m->body_len - length)
+    return NULL;
+  if (len != NULL)
+    *len = length;
+  return r->buf + m->body + offset;
+}
+
+// Utf8 offsets must be non-decreasing and stay within the data buffer
+static b8_t arrow_utf8_ok(const i32_t *offsets, i64_t n, i64_t data_len) {
+  i64_t i;
+
+  if (offsets[0] < 0 || offsets[n] > data_len)
+    return B8_FALSE;
+  for (i = 0; i < n; i++)
+    if (offsets[i + 1] < offsets[i])
+      return B8_FALSE;
+  return B8_TRUE;
+}
+
+static i64_t arrow_int_at(const u8_t *p, i64_t i, i64_t width, b8_t is_signed) {
+  i8_t v8;
+  i16_t v16;
+  i32_t v32;
+  i64_t v64;
+
+  switch (width) {
+  case 1:
+    v8 = (i8_t)p[i];
+    return is_signed ? v8 : (i64_t)p[i];
+  case 2:
+    memcpy(&v16, p + i * 2, 2);
+    return is_signed ? v16 : (i64_t)v16 & 0xFFFF;
+  case 4:
+    memcpy(&v32, p + i * 4, 4);
+    return is_signed ? v32 : (i64_t)(u32_t)v32;
+  default:
+    memcpy(&v64, p + i * 8, 8);
+    return v64;
   }
+}
 
-  pos = buf;
-  i64_t remaining = header_len;
+static b8_t arrow_read_dictionary(arrow_reader_t *rd, arrow_msg_t *m) {
+  fbr_t *r = &rd->r;
+  i64_t data, rows, nbufs, bufs, len, base;
+  const u8_t *bytes;
+  const i32_t *offsets;
+  arrow_symdict_t *d;
+  i64_t *syms;
+
+  d = arrow_symdict(rd, fbr_field_i64(r, m->header, 0, 0));
+  data = fbr_ref(r, m->header, 1);
+  if (d == NULL || data == 0 || fbr_field(r, data, 3))
+    return B8_FALSE;
 
-  for (i = 0; i < l; i++) {
-    prev = pos;
-    str_p next_sep = (str_p)memchr(pos, sep, remaining);
+  rows = fbr_field_i64(r, data, 0, 0);
+  bufs = fbr_vec(r, data, 2, &nbufs);
+  offsets = (const i32_t *)arrow_body_buf(rd, m, bufs, nbufs, 1,
+                                          (rows + 1) * sizeof(i32_t), NULL);
+  bytes = arrow_body_buf(rd, m, bufs, nbufs, 2, 0, &len);
+  if (rows < 0 || offsets == NULL || bytes == NULL ||
+      !arrow_utf8_ok(offsets, rows, len))
+    return B8_FALSE;
 
-    if (next_sep == NULL) {
-      // Last column
-      if (remaining > 0 && prev[remaining - 1] == '\r') {
-        AS_SYMBOL(names)
-        [i] = io_symbol_from_str_trimmed(prev, remaining - 1);
-      } else {
-        AS_SYMBOL(names)[i] = io_symbol_from_str_trimmed(prev, remaining);
+  base = fbr_field_u8(r, m->header, 2, 0) ? d->n : 0; // isDelta appends
+  syms = (i64_t *)realloc(d->syms, (base + rows + 1) * sizeof(i64_t));
+  if (syms == NULL)
+    return B8_FALSE;
+  d->syms = syms;
+  d->n = base + rows;
+
+  intern_symbols_bulk((lit_p)bytes, (i32_t *)offsets, d->syms + base, rows);
+  return B8_TRUE;
+}
+
+// Convert `n` fixed-width source values into `col` starting at row `at`
+static nil_t arrow_convert(arrow_field_t *f, const u8_t *src, obj_p col,
+                           i64_t at, i64_t n) {
+  static const i64_t ns_per_unit[] = {1000000000LL, 1000000LL, 1000LL, 1LL};
+  static const i64_t ms_div[] = {0, 1, 1000LL, 1000000LL};
+  i64_t i, size = get_element_size(col->type), v;
+  float f32;
+
+  switch (f->rtype) {
+  case TYPE_DATE:
+    for (i = 0; i < n; i++) {
+      v = arrow_int_at(src, i, f->width, B8_TRUE);
+      if (f->unit != 0) // MILLISECOND
+        v = (v >= 0 ? v : v - 86399999) / 86400000;
+      AS_I32(col)[at + i] = (i32_t)(v - ARROW_DATE_SHIFT);
+    }
+    return;
+  case TYPE_TIME:
+    for (i = 0; i < n; i++) {
+      v = arrow_int_at(src, i, f->width, B8_TRUE);
+      AS_I32(col)[at + i] = (i32_t)(f->unit == 0 ? v * 1000 : v / ms_div[f->unit & 3]);
+    }
+    return;
+  case TYPE_TIMESTAMP:
+    for (i = 0; i < n; i++)
+      AS_I64(col)[at + i] = arrow_int_at(src, i, 8, B8_TRUE) * ns_per_unit[f->unit & 3] -
+                            ARROW_TIMESTAMP_SHIFT;
+    return;
+  case TYPE_F64:
+    if (f->width == 8)
+      break;
+    for (i = 0; i < n; i++) {
+      memcpy(&f32, src + i * 4, 4);
+      AS_F64(col)[at + i] = f32;
+    }
+    return;
+  case TYPE_GUID:
+    break;
+  default: // integers
+    if (f->width == size && (f->is_signed || col->type == TYPE_U8 || size == 8))
+      break;
+    for (i = 0; i < n; i++) {
+      v = arrow_int_at(src, i, f->width, f->is_signed);
+      switch (col->type) {
+      case TYPE_I16:
+        AS_I16(col)[at + i] = (i16_t)v;
+        break;
+      case TYPE_I32:
+        AS_I32(col)[at + i] = (i32_t)v;
+        break;
+      default:
+        AS_I64(col)[at + i] = v;
+        break;
       }
-      pos += remaining;
-      remaining = 0;
-    } else {
-      AS_SYMBOL(names)
-      [i] = io_symbol_from_str_trimmed(prev, next_sep - prev);
-      remaining -= (next_sep - prev + 1);
-      pos = next_sep + 1;
     }
+    return;
   }
 
-  // Alloc types - default to C8 (String)
-  i8_t *type_arr = (i8_t *)malloc(l * sizeof(i8_t));
-  if (type_arr == NULL) {
-    printf("ERROR: read_csv failed to allocate type_arr\n");
-    drop_obj(names);
-    return err_user("Failed to allocate type array");
-  }
-  for (i = 0; i < l; i++) {
-    type_arr[i] = TYPE_C8;
-  }
-
-  // Exclude header from data lines
-  lines--;
-  if (lines < 0)
-    lines = 0;
+  if (n > 0)
+    memcpy(AS_C8(col) + at * size, src, n * size);
+}
 
-  printf("INFO: read_csv allocating %lld columns x %lld rows\n", l, lines);
+// Overwrite rows whose validity bit is clear with the column's null value
+static nil_t arrow_apply_nulls(arrow_reader_t *rd, obj_p col, i64_t at,
+                               i64_t n, const u8_t *valid) {
+  i64_t i, size = get_element_size(col->type);
 
-  // Allocate columns
-  cols = LIST(l);
-  if (cols == NULL) {
-    printf("ERROR: read_csv failed to allocate cols list\n");
-    free(type_arr);
-    drop_obj(names);
-    return err_user("Failed to allocate columns list");
+  for (i = 0; i < n; i++) {
+    if (valid[i >> 3] & (1 << (i & 7)))
+      continue;
+    switch (col->type) {
+    case TYPE_I16:
+      AS_I16(col)[at + i] = NULL_I16;
+      break;
+    case TYPE_I32:
+    case TYPE_DATE:
+    case TYPE_TIME:
+      AS_I32(col)[at + i] = NULL_I32;
+      break;
+    case TYPE_I64:
+    case TYPE_TIMESTAMP:
+      AS_I64(col)[at + i] = NULL_I64;
+      break;
+    case TYPE_F64:
+      AS_F64(col)[at + i] = NULL_F64;
+      break;
+    case TYPE_SYMBOL:
+      AS_SYMBOL(col)[at + i] = rd->empty;
+      break;
+    default:
+      memset(AS_C8(col) + (at + i) * size, 0, size);
+      break;
+    }
   }
+}
 
-  for (i = 0; i < l; i++) {
-    AS_LIST(cols)[i] = LIST(lines);
-    if (AS_LIST(cols)[i] == NULL) {
-      printf("ERROR: read_csv failed to allocate column %lld (lines=%lld)\n", i, lines);
-      free(type_arr);
-      drop_obj(names);
-      drop_obj(cols);
-      return err_user("Failed to allocate column data - file too large for memory");
+// Fill rows [at, at + length) of every column from a record batch
+static lit_p arrow_read_batch(arrow_reader_t *rd, arrow_msg_t *m, i64_t at) {
+  fbr_t *r = &rd->r;
+  arrow_field_t *f;
+  arrow_symdict_t *d;
+  i64_t c, i, k, rows, nnodes, nodes, nbufs, bufs, b = 0, len;
+  const u8_t *valid, *data;
+  const i32_t *offsets;
+  obj_p col;
+
+  rows = fbr_field_i64(r, m->header, 0, 0);
+  nodes = fbr_vec(r, m->header, 1, &nnodes);
+  bufs = fbr_vec(r, m->header, 2, &nbufs);
+  if (fbr_field(r, m->header, 3))
+    return "Compressed Arrow buffers are not supported";
+  if (rows < 0 || at + rows > rd->rows || nnodes < rd->ncols || r->bad)
+    return "Malformed Arrow record batch";
+
+  for (c = 0; c < rd->ncols; c++) {
+    f = &rd->fields[c];
+    col = AS_LIST(rd->vals)[c];
+    if (fbr_i64(r, nodes + 16 * c) != rows)
+      return "Malformed Arrow record batch";
+
+    valid = NULL;
+    if (fbr_i64(r, nodes + 16 * c + 8) > 0) {
+      valid = arrow_body_buf(rd, m, bufs, nbufs, b, (rows + 7) / 8, NULL);
+      if (valid == NULL)
+        return "Malformed Arrow validity buffer";
+    }
+    b++;
+
+    if (f->dict_id >= 0) {
+      d = arrow_symdict(rd, f->dict_id);
+      data = arrow_body_buf(rd, m, bufs, nbufs, b++, rows * f->width, NULL);
+      if (data == NULL)
+        return "Malformed Arrow dictionary indices";
+      for (i = 0; i < rows; i++) {
+        if (valid != NULL && !(valid[i >> 3] & (1 << (i & 7)))) {
+          AS_SYMBOL(col)[at + i] = rd->empty;
+          continue;
+        }
+        k = arrow_int_at(data, i, f->width, f->is_signed);
+        if (k < 0 || k >= d->n)
+          return "Arrow dictionary index out of range";
+        AS_SYMBOL(col)[at + i] = d->syms[k];
+      }
+      continue;
     }
-  }
 
-  printf("INFO: read_csv column allocation successful, parsing data...\n");
+    switch (f->tag) {
+    case ARROW_TYPE_UTF8:
+      offsets = (const i32_t *)arrow_body_buf(rd, m, bufs, nbufs, b++,
+                                              (rows + 1) * sizeof(i32_t), NULL);
+      data = arrow_body_buf(rd, m, bufs, nbufs, b++, 0, &len);
+      if (offsets == NULL || data == NULL || !arrow_utf8_ok(offsets, rows, len))
+        return "Malformed Arrow string column";
+      intern_symbols_bulk((lit_p)data, (i32_t *)offsets, AS_SYMBOL(col) + at, rows);
+      break;
+    case ARROW_TYPE_BOOL:
+      data = arrow_body_buf(rd, m, bufs, nbufs, b++, (rows + 7) / 8, NULL);
+      if (data == NULL)
+        return "Malformed Arrow boolean column";
+      for (i = 0; i < rows; i++)
+        AS_C8(col)[at + i] = (data[i >> 3] >> (i & 7)) & 1;
+      break;
+    default:
+      data = arrow_body_buf(rd, m, bufs, nbufs, b++, rows * f->width, NULL);
+      if (data == NULL)
+        return "Malformed Arrow column buffer";
+      arrow_convert(f, data, col, at, rows);
+      break;
+    }
 
-  // parse lines
-  // If line is NULL (only header), we skip parsing
-  if (lines > 0 && line != NULL) {
-    printf("INFO: read_csv calling io_read_csv for %lld lines...\n", lines);
-    res = io_read_csv(type_arr, l, line, len - (line - buf), lines, cols, sep);
-    printf("INFO: read_csv io_read_csv returned: %p, type=%d\n", res, res ? res->type : -999);
+    if (valid != NULL)
+      arrow_apply_nulls(rd, col, at, rows, valid);
+  }
 
-    if (res && res->type == TYPE_ERR) {
-      printf("ERROR: read_csv io_read_csv returned error\n");
-      free(type_arr);
-      drop_obj(names);
-      drop_obj(cols);
-      return res;
+  return NULL;
+}
+
+// Import an Arrow IPC stream (or file) from `len` bytes at `buf` into a
+// table. Record batches are concatenated; fixed-width columns are copied
+// with one memcpy per batch, Utf8 and dictionary columns become SYMBOL
+// vectors through bulk interning, and validity bitmaps become nulls.
+EMSCRIPTEN_KEEPALIVE obj_p import_arrow(u8_t *buf, i64_t len) {
+  arrow_reader_t rd;
+  arrow_msg_t m;
+  obj_p keys, col;
+  i64_t i, pos = 0, start, at = 0, k;
+  lit_p err, name;
+
+  if (buf == NULL || len <= 0)
+    return err_user("Arrow buffer is empty");
+
+  memset(&rd, 0, sizeof(rd));
+  rd.r.buf = buf;
+  rd.r.len = len;
+
+  // File format: "ARROW1" magic + padding, then the stream format
+  if (len >= 8 && memcmp(buf, "ARROW1", 6) == 0)
+    pos = 8;
+  start = pos;
+
+  // First pass: schema and total row count
+  while ((k = arrow_next_msg(&rd.r, &pos, &m)) > 0) {
+    if (m.type == ARROW_MSG_SCHEMA) {
+      if (rd.fields != NULL)
+        return arrow_reader_fail(&rd, "Arrow stream has more than one schema");
+      if (!arrow_read_schema(&rd, m.header))
+        return arrow_reader_fail(&rd, "Malformed Arrow schema");
+    } else if (m.type == ARROW_MSG_RECORD_BATCH) {
+      // Every supported column takes at least a bit per row of the body
+      at = fbr_field_i64(&rd.r, m.header, 0, 0);
+      if (at < 0 || at > m.body_len * 8)
+        return arrow_reader_fail(&rd, "Malformed Arrow record batch");
+      rd.rows += at;
     }
   }
-
-  free(type_arr);
-  
-  // Verify objects are still valid before creating table
-  printf("INFO: read_csv verifying objects - names=%p type=%d len=%lld, cols=%p type=%d len=%lld\n", 
-         names, names ? names->type : -1, names ? names->len : -1,
-         cols, cols ? cols->type : -1, cols ? cols->len : -1);
-  
-  if (names == NULL || cols == NULL) {
-    printf("ERROR: read_csv names or cols became NULL!\n");
-    if (names) drop_obj(names);
-    if (cols) drop_obj(cols);
-    return err_user("Memory corruption - names or cols became NULL");
+  if (k < 0 || rd.r.bad || rd.rows < 0)
+    return arrow_reader_fail(&rd, "Malformed Arrow IPC message");
+  if (rd.fields == NULL)
+    return arrow_reader_fail(&rd, "Arrow stream has no schema");
+
+  for (i = 0; i < rd.ncols; i++)
+    if (rd.fields[i].rtype < 0)
+      return arrow_reader_fail(&rd, "Unsupported Arrow column type");
+
+  rd.vals = LIST(rd.ncols);
+  if (rd.vals == NULL)
+    return arrow_reader_fail(&rd, "Failed to allocate table structure");
+  for (i = 0; i < rd.ncols; i++)
+    AS_LIST(rd.vals)[i] = NULL_OBJ;
+  for (i = 0; i < rd.ncols; i++) {
+    col = vector(rd.fields[i].rtype, rd.rows);
+    if (col == NULL)
+      return arrow_reader_fail(&rd, "Failed to allocate column data - table too large for memory");
+    AS_LIST(rd.vals)[i] = col;
   }
-  
-  printf("INFO: read_csv creating table...\n");
-  obj_p t = table(names, cols);
-  printf("INFO: read_csv table() returned: %p\n", t);
-  if (t == NULL) {
-    printf("ERROR: read_csv table() returned NULL - out of memory!\n");
-    drop_obj(names);
-    drop_obj(cols);
-    return err_user("Out of memory: failed to allocate table structure");
+  rd.empty = intern_symbol("", 0);
+
+  // Second pass: dictionaries and record batches in stream order
+  pos = start;
+  at = 0;
+  while (arrow_next_msg(&rd.r, &pos, &m) > 0) {
+    if (m.type == ARROW_MSG_DICTIONARY) {
+      if (!arrow_read_dictionary(&rd, &m))
+        return arrow_reader_fail(&rd, "Malformed Arrow dictionary batch");
+    } else if (m.type == ARROW_MSG_RECORD_BATCH) {
+      err = arrow_read_batch(&rd, &m, at);
+      if (err != NULL)
+        return arrow_reader_fail(&rd, err);
+      at += fbr_field_i64(&rd.r, m.header, 0, 0);
+    }
   }
 
-  printf("INFO: read_csv success. Table: %p, rows=%lld, cols=%lld\n", t, lines, l);
-  return t;
+  keys = vector(TYPE_SYMBOL, rd.ncols);
+  if (keys == NULL)
+    return arrow_reader_fail(&rd, "Failed to allocate table structure");
+  for (i = 0; i < rd.ncols; i++) {
+    k = rd.fields[i].name;
+    len = k ? fbr_u32(&rd.r, k) : 0;
+    name = (lit_p)buf + k + 4;
+    if (k == 0 || !fbr_ok(&rd.r, k + 4, len)) {
+      name = "";
+      len = 0;
+    }
+    AS_SYMBOL(keys)[i] = intern_symbol(name, len);
+  }
+
+  col = rd.vals;
+  rd.vals = NULL;
+  arrow_reader_free(&rd);
+  return table(keys, col);
 }
 
+
 // ============================================================================
 // Main Entry Point
 // ============================================================================
 
+// Resolve the pool size from "-p N" in the module arguments (passed by
+// init({ threads })). Single-threaded builds always run one worker, and
+// multi-threaded builds are capped by the prespawned PTHREAD_POOL_SIZE.
+static i32_t wasm_pool_size(i32_t argc, str_p argv[]) {
+  i32_t i, n = 1;
+
+  for (i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-p") == 0)
+      n = atoi(argv[i + 1]);
+  }
+
+#if defined(__EMSCRIPTEN_PTHREADS__) && defined(WASM_POOL_SIZE)
+  if (n > WASM_POOL_SIZE)
+    n = WASM_POOL_SIZE;
+#else
+  n = 1;
+#endif
+
+  return n < 1 ? 1 : n;
+}
+
+static b8_t wasm_has_flag(i32_t argc, str_p argv[], lit_p flag) {
+  i32_t i;
+
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], flag) == 0)
+      return B8_TRUE;
+  }
+
+  return B8_FALSE;
+}
+
 EMSCRIPTEN_KEEPALIVE i32_t main(i32_t argc, str_p argv[]) {
   sys_info_t info;
   obj_p fmt = NULL_OBJ;
   runtime_p runtime;
+  c8_t pool[16];
 
-  // Silence unused parameter warnings
-  (void)argc;
-  (void)argv;
+  snprintf(pool, sizeof(pool), "%d", wasm_pool_size(argc, argv));
 
   // Initialize runtime like Python binding does:
   // Pass -r 0 to disable REPL (we'll call eval_str directly from JS)
-  // Pass -p 1 to force single-threaded mode (avoids pool crashes in WASM)
-  str_p wasm_argv[] = {"rayforce-wasm", "-r", "0", "-p", "1", NULL};
+  // Pass -p N for the pool size (1 in single-threaded builds, where the
+  // pool has no threads to run on)
+  str_p wasm_argv[] = {"rayforce-wasm", "-r", "0", "-p", pool, NULL};
   atexit((void (*)(void))runtime_destroy);
   runtime = runtime_create(5, wasm_argv);
 
@@ -866,6 +6304,13 @@ EMSCRIPTEN_KEEPALIVE i32_t main(i32_t argc, str_p argv[]) {
     return -1;
   }
 
+  // Lean start (init({ lean: true })): no self-test, banner or examples/
+  // scan, the ready message is just the version
+  if (wasm_has_flag(argc, argv, "--lean")) {
+    js_rayforce_ready(version_str());
+    return 0;
+  }
+
   // Verify eval_str works after runtime initialization (LISP syntax)
   {
     obj_p test_result = eval_str("(+ 1 2)");
@@ -886,7 +6331,9 @@ EMSCRIPTEN_KEEPALIVE i32_t main(i32_t argc, str_p argv[]) {
   str_fmt_into(&fmt, -1, __ABOUT, BOLD, YELLOW, info.major_version,
                info.minor_version, info.build_date, info.cwd, RESET);
 
+#ifndef WASM_NO_FS
   list_examples(&fmt);
+#endif
 
   // Signal to JS that we're ready
   js_rayforce_ready(AS_C8(fmt));
@@ -0,0 +1,16 @@
+/**
+ * RayforceDB Emscripten post-js
+ *
+ * Linked into every WASM build (--post-js). Memory growth replaces the heap
+ * ArrayBuffer and detaches every view over the old one; Module.onMemoryGrowth
+ * lets the SDK bump its heap generation so cached Vector views are rebuilt
+ * lazily instead of on every access.
+ */
+
+if (typeof updateMemoryViews === 'function') {
+  var rayforceUpdateMemoryViews = updateMemoryViews;
+  updateMemoryViews = function () {
+    rayforceUpdateMemoryViews();
+    if (Module['onMemoryGrowth']) Module['onMemoryGrowth']();
+  };
+}
@@ -0,0 +1,256 @@
+/**
+ * RayforceDB Worker Proxy
+ *
+ * Async main-thread proxy for an SDK hosted in rayforce.worker.js. Every
+ * RayforceSDK method is available and returns a Promise; RayObjects come
+ * back as RemoteObject handles whose methods are forwarded the same way.
+ *
+ * Usage:
+ *   const rf = await init({ worker: true });
+ *   const t = await rf.readCsv(text);
+ *   const cols = await t.columns();     // { price: Float64Array, ... }
+ *   const n = await t.rowCount();       // properties are read as calls
+ *   await t.drop();
+ *
+ * @module rayforce/proxy
+ */
+
+// ============================================================================
+// Remote Object Handle
+// ============================================================================
+
+/**
+ * Handle to a RayObject living in the worker
+ */
+class RemoteObject {
+  constructor(client, info) {
+    this._client = client;
+    this.handle = info.$handle;
+    this.className = info.className;
+    this.type = info.type;
+    this.length = info.length;
+  }
+
+  /**
+   * Call a method (or read a property) of the worker-side object
+   * @param {string} method
+   * @param {...any} args
+   * @returns {Promise<any>}
+   */
+  call(method, ...args) {
+    return this._client._request({ op: 'obj', handle: this.handle, method, args });
+  }
+
+  /**
+   * For tables: all columns keyed by name, numeric columns as TypedArrays
+   * @returns {Promise<Object>}
+   */
+  columns() {
+    return this._client._request({ op: 'columns', handle: this.handle });
+  }
+
+  /**
+   * For vectors: the data as a TypedArray (transferred copy, or a shared
+   * view for the multi-threaded build)
+   * @returns {Promise<TypedArray>}
+   */
+  typedArray() {
+    return this.call('typedArray');
+  }
+
+  /**
+   * Free the worker-side object
+   * @returns {Promise<boolean>}
+   */
+  drop() {
+    return this._client._request({ op: 'drop', handle: this.handle });
+  }
+}
+
+// ============================================================================
+// Worker SDK Client
+// ============================================================================
+
+/**
+ * Async proxy of RayforceSDK backed by a dedicated Worker
+ */
+class RayforceWorkerSDK {
+  constructor(worker) {
+    this._worker = worker;
+    this._nextId = 1;
+    this._pending = new Map();
+    // Shared with the worker's SDK (interruptFlag) so interrupt() reaches
+    // it mid-call; null where SharedArrayBuffer cannot be posted
+    this._interrupt = typeof SharedArrayBuffer === 'function' && globalThis.crossOriginIsolated !== false
+      ? new Int32Array(new SharedArrayBuffer(4))
+      : null;
+
+    worker.onmessage = (event) => this._onMessage(event.data);
+    worker.onerror = (event) => {
+      const error = new Error(`RayforceDB worker error: ${event.message}`);
+      for (const { reject } of this._pending.values()) reject(error);
+      this._pending.clear();
+    };
+  }
+
+  /**
+   * Call a RayforceSDK method (or read a property) in the worker
+   * @param {string} method
+   * @param {...any} args
+   * @returns {Promise<any>}
+   */
+  call(method, ...args) {
+    return this._request({ op: 'sdk', method, args });
+  }
+
+  /**
+   * Stop the call the worker is running with an "Interrupted" error (see
+   * RayforceSDK.interrupt). Needs SharedArrayBuffer, i.e. a cross-origin
+   * isolated page; returns false where it is unavailable.
+   * @returns {boolean}
+   */
+  interrupt() {
+    if (this._interrupt === null) return false;
+    Atomics.store(this._interrupt, 0, 1);
+    return true;
+  }
+
+  /**
+   * RayforceSDK.evalAsync in the worker. The signal and progress callback
+   * stay on this side: an abort sets the shared interrupt flag, seen before
+   * the next top-level form, and is also posted to the worker, which sees
+   * it at its next yield (a running form always completes). Progress is
+   * posted back.
+   * @param {string} code
+   * @param {Object} [options] - signal, onProgress, yieldMs, sourceName
+   * @returns {Promise<RemoteObject>}
+   */
+  async evalAsync(code, options = {}) {
+    const { signal, onProgress, ...rest } = options;
+    signal?.throwIfAborted();
+
+    const id = this._nextId++;
+    const abort = () => {
+      this.interrupt();
+      this._worker.postMessage({ op: 'abort', target: id });
+    };
+    signal?.addEventListener('abort', abort, { once: true });
+    try {
+      const msg = { op: 'evalAsync', id, code, options: rest, progress: onProgress !== undefined };
+      return await this._request(msg, onProgress);
+    } catch (error) {
+      if (signal?.aborted) throw signal.reason;
+      throw error;
+    } finally {
+      signal?.removeEventListener('abort', abort);
+    }
+  }
+
+  /**
+   * Stop the worker; pending calls are rejected
+   */
+  terminate() {
+    this._worker.terminate();
+    const error = new Error('RayforceDB worker terminated');
+    for (const { reject } of this._pending.values()) reject(error);
+    this._pending.clear();
+  }
+
+  _request(msg, onProgress) {
+    const transfer = [];
+    const args = msg.args ? msg.args.map(a => this._encodeArg(a, transfer)) : undefined;
+
+    return new Promise((resolve, reject) => {
+      const id = msg.id ?? this._nextId++;
+      this._pending.set(id, { resolve, reject, onProgress });
+      this._worker.postMessage({ ...msg, args, id }, transfer);
+    });
+  }
+
+  _encodeArg(arg, transfer) {
+    if (arg instanceof RemoteObject) return { $handle: arg.handle };
+    // Streams are moved into the worker (readCsvStream)
+    if (typeof ReadableStream !== 'undefined' && arg instanceof ReadableStream) {
+      transfer.push(arg);
+    }
+    // Handles nested in arrays and plain objects (sdk.table({ a: vec }))
+    if (Array.isArray(arg)) return arg.map(a => this._encodeArg(a, transfer));
+    if (arg !== null && typeof arg === 'object' && arg.constructor === Object) {
+      const result = {};
+      for (const [k, v] of Object.entries(arg)) result[k] = this._encodeArg(v, transfer);
+      return result;
+    }
+    return arg;
+  }
+
+  _onMessage({ id, result, error, progress }) {
+    const pending = this._pending.get(id);
+    if (!pending) return;
+    if (progress !== undefined) {
+      if (pending.onProgress) pending.onProgress(progress);
+      return;
+    }
+    this._pending.delete(id);
+
+    if (error !== undefined) {
+      pending.reject(new Error(error));
+    } else {
+      pending.resolve(this._revive(result));
+    }
+  }
+
+  _revive(value) {
+    if (value === null || typeof value !== 'object') return value;
+    if (ArrayBuffer.isView(value)) return value;
+    if (value.$handle !== undefined) return forwardMembers(new RemoteObject(this, value));
+    if (value.$view !== undefined) {
+      return new globalThis[value.$view](value.buffer, value.byteOffset, value.length);
+    }
+    if (Array.isArray(value)) return value.map(v => this._revive(v));
+
+    const result = {};
+    for (const [k, v] of Object.entries(value)) result[k] = this._revive(v);
+    return result;
+  }
+}
+
+/**
+ * Wrap a client so unknown members become forwarded async calls.
+ * `then` is never forwarded, so proxies are not mistaken for thenables.
+ */
+function forwardMembers(target) {
+  return new Proxy(target, {
+    get(obj, prop) {
+      if (prop in obj || typeof prop === 'symbol' || prop === 'then') return obj[prop];
+      return (...args) => obj.call(prop, ...args);
+    },
+  });
+}
+
+// ============================================================================
+// Factory
+// ============================================================================
+
+/**
+ * Start a worker hosting the WASM module and return its async SDK proxy.
+ * @param {Object} [options] - Passed to init() inside the worker
+ * @param {string|URL} [options.workerPath] - Custom path to rayforce.worker.js
+ * @returns {Promise<RayforceWorkerSDK>}
+ */
+export async function createWorkerSDK(options = {}) {
+  const { workerPath, onReady, ...workerOptions } = options;
+  const url = workerPath || new URL('./rayforce.worker.js', import.meta.url);
+  const client = new RayforceWorkerSDK(new Worker(url, { type: 'module' }));
+
+  try {
+    await client._request({ op: 'init', options: workerOptions, interrupt: client._interrupt?.buffer });
+  } catch (error) {
+    client.terminate();
+    throw error;
+  }
+
+  if (onReady) onReady(await client.call('version'));
+  return forwardMembers(client);
+}
+
+export { RayforceWorkerSDK, RemoteObject };
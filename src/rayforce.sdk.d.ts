@@ -74,7 +74,7 @@ export declare class RayObject {
   /** Convert to JavaScript value */
   toJS(): any;
   
-  /** Free this object's memory */
+  /** Free this object's memory now (otherwise freed when garbage collected) */
   drop(): void;
   
   /** Release ownership (don't drop on GC) */
@@ -172,7 +172,10 @@ export declare class Vector<T extends TypedArray = TypedArray> extends RayObject
   
   /**
    * Zero-copy TypedArray view over the vector data.
-   * WARNING: This view is only valid while the Vector exists.
+   * Cached; rebuilt only after the heap has grown, so re-read it after
+   * calls that may allocate instead of holding the view.
+   * A reachable view keeps its Vector from being collected, but it must not
+   * outlive drop()/release() or the scope() that owns the Vector.
    */
   readonly typedArray: T;
   
@@ -185,6 +188,35 @@ export declare class Vector<T extends TypedArray = TypedArray> extends RayObject
   /** Convert to JS array (copies data) */
   toJS(): Array<T extends BigInt64Array ? number | bigint : number>;
   
+  /** Sum of non-null elements (native SIMD kernel; I64/I32/F64) */
+  sum(): number | bigint;
+  
+  /** Mean of non-null elements */
+  avg(): number;
+  
+  /** Smallest non-null element */
+  min(): any;
+  
+  /** Largest non-null element */
+  max(): any;
+  
+  /** Compare every element with `value` into a B8 mask */
+  compare(op: 'eq' | 'ne' | 'lt' | 'le' | 'gt' | 'ge', value: number | bigint | RayObject): Vector<Int8Array> | RayError;
+  
+  /** Elements where the B8 mask (same length) is set */
+  filter(mask: Vector): Vector<T> | RayError;
+  
+  /** Whether the elements ascend (nulls first); symbols never count as sorted */
+  isSorted(): boolean;
+  
+  /**
+   * DATE/TIME/TIMESTAMP elements as Unix epoch ms (TIME: ms since midnight)
+   * in one native pass; nulls are NaN (or the i64 null). Cached until set();
+   * each call returns a fresh copy.
+   */
+  asEpochMillis(options?: { bigint?: false }): Float64Array;
+  asEpochMillis(options: { bigint: true }): BigInt64Array;
+  
   [Symbol.iterator](): Iterator<T extends BigInt64Array ? bigint : number>;
 }
 
@@ -268,19 +300,37 @@ export declare class Table extends RayObject {
   /** Insert data */
   insert(data: Record<string, any> | any[]): Table;
   
+  /** Open a native append session (this table is left unchanged) */
+  appender(): AppendSession;
+  
+  /** Natively sorted copy by a boolean, numeric or temporal column (stable, ascending) */
+  sortBy(column: string): Table | RayError;
+  
+  /**
+   * Native equality index on a SYMBOL, boolean, integer or temporal column,
+   * followed through insert()/upserts; `where(col.eq(value))` probes it
+   */
+  createIndex(column: string): TableIndex;
+  
   /** Convert to column object */
   toJS(): Record<string, any[]>;
   
   /** Convert to array of row objects */
   toRows(): Record<string, any>[];
+
+  /** Export as an Arrow IPC stream (for apache-arrow's tableFromIPC) */
+  toArrow(): Uint8Array;
 }
 
 /**
  * Lambda (function)
  */
 export declare class Lambda extends RayObject {
-  /** Call the lambda with arguments */
+  /** Call the lambda with arguments (passed by pointer, never re-parsed) */
   call(...args: any[]): RayObject;
+  
+  /** Build the call as a reusable plan for RayforceSDK.evalPlan */
+  plan(...args: any[]): List;
 }
 
 // ============================================================================
@@ -339,8 +389,234 @@ export declare class SelectQuery {
   /** Column reference helper */
   col(name: string): Expr;
   
-  /** Execute the query */
+  /**
+   * Keep the plan execute() builds for later runs; the plan pins the table
+   * until drop()
+   */
+  keep(): this;
+  
+  /** Release the cached plan */
+  drop(): void;
+  
+  /** Execute the query; drops the plan it built unless kept */
   execute(): Table;
+  
+  /** Native query dict, built from handles once and cached until drop() */
+  plan(): Dict;
+}
+
+/**
+ * Code parsed once into a native lambda
+ */
+export declare class PreparedQuery {
+  /** Parameter names, in call order */
+  readonly params: string[];
+  
+  /** Evaluate with values by name or position (strings become symbols) */
+  execute(values?: Record<string, any> | any[]): RayObject;
+  
+  /** Release the compiled lambda */
+  drop(): void;
+}
+
+/**
+ * Postfix builder for native plans (call lists and query dicts)
+ */
+export declare class PlanBuilder {
+  constructor(sdk: RayforceSDK);
+  
+  /** Push an object as-is */
+  push(obj: RayObject): PlanBuilder;
+  
+  /** Push an object as a quoted literal */
+  quote(obj: RayObject): PlanBuilder;
+  
+  /** Push a name reference (function, global or column) */
+  name(name: string): PlanBuilder;
+  
+  /** Push a value; symbols and lists are quoted */
+  literal(value: any, temp?: boolean): PlanBuilder;
+  
+  /** Pop n items (head first) into a call */
+  call(n: number): PlanBuilder;
+  
+  /** Pop n (name, value) pairs into a dict */
+  dict(n: number): PlanBuilder;
+  
+  /** Assemble the plan natively */
+  build(): RayObject;
+}
+
+/** Column of an append batch */
+export type AppendColumn =
+  | ArrayBufferView
+  | Array<number | bigint | boolean | string>
+  | { bytes: Uint8Array; offsets: Int32Array };
+
+/**
+ * Native append buffer bound to a table; rows become visible on flush()
+ */
+export declare class AppendSession {
+  /** Rows appended since the last flush */
+  readonly pending: number;
+  
+  /**
+   * Append a batch: TypedArrays of each column's kind (Int32Array for DATE),
+   * string arrays or packed strings for symbols
+   * @returns Rows pending since the last flush
+   */
+  append(batch: Record<string, AppendColumn> | AppendColumn[]): number;
+  
+  /**
+   * Publish pending rows as a snapshot. Drop the previous snapshot first,
+   * or the session copies the table to keep it unchanged.
+   */
+  flush(): Table;
+  
+  /** Flush and release the session */
+  close(): Table;
+}
+
+export interface ResultCacheStats {
+  hits: number;
+  misses: number;
+  /** Selects that could not be cached (no Table in `from`, or caching off) */
+  bypassed: number;
+  /** Results dropped for space */
+  evictions: number;
+  /** Results dropped because their table changed */
+  invalidations: number;
+  entries: number;
+  bytes: number;
+  budget: number;
+}
+
+export interface HeapStats {
+  /** 'pool' for the wasm-pool build (rayforce's own heap; usedBytes counts its blocks) */
+  allocator: 'sys' | 'pool';
+  /** WASM linear memory size */
+  heapBytes: number;
+  arenaBytes: number;
+  usedBytes: number;
+  freeBytes: number;
+  freeChunks: number;
+  /** Free bytes at the top of the arena */
+  releasableBytes: number;
+  /** Free bytes below the top of the arena, as a fraction of it */
+  fragmentation: number;
+  liveObjects: number;
+  liveByType: Record<string, number>;
+}
+
+/** Native time and allocator growth of one profiled entry point */
+export interface ProfileEntry {
+  calls: number;
+  ms: number;
+  /** Net bytes allocated (in use after the calls minus before) */
+  bytes: number;
+}
+
+export interface ProfileReport<T = RayObject> {
+  result: T;
+  totalMs: number;
+  allocatedBytes: number;
+  /**
+   * Largest allocator in-use size right after an entry call returned. Not a
+   * true peak: memory allocated and freed within a call is not sampled
+   */
+  maxEndBytes: number;
+  /** WASM linear memory size */
+  heapBytes: number;
+  entries: Partial<Record<'parse' | 'eval' | 'format' | 'evalCmd' | 'evalCached' |
+    'evalPlan' | 'select' | 'update', ProfileEntry>>;
+}
+
+/**
+ * Group-by aggregation kept up to date from appended rows (materialize())
+ */
+export declare class MaterializedView {
+  /** Fold rows added since the last refresh; `table` must extend the source */
+  refresh(table: Table): this;
+  
+  /** Current result as a table of group keys and aggregates, O(groups) */
+  read(): Table;
+  
+  /** Free the native accumulators and detach from the session */
+  drop(): void;
+}
+
+/**
+ * Native equality index on one table column (Table.createIndex())
+ */
+export declare class TableIndex {
+  readonly column: string;
+  
+  /** Binary search over an ascending column, or a hash; null once the column is gone */
+  readonly kind: 'sorted' | 'hash' | null;
+  
+  /** Positions of the rows equal to `value` (strings for SYMBOL columns) */
+  rows(value: string | number | bigint | boolean): Vector<BigInt64Array>;
+  
+  /** Rows equal to `value` as a table */
+  where(value: string | number | bigint | boolean): Table;
+  
+  /** Distinct values to I64 vectors of their row positions */
+  groups(): Dict;
+  
+  /** Rebuild after in-place writes (Vector.set(), typedArray) to the column */
+  rebuild(): this;
+  
+  /** Free the index and stop maintaining it (also done when it is garbage collected) */
+  drop(): void;
+}
+
+/**
+ * Table saved with saveSplayed(), paged in one column at a time
+ */
+export declare class SplayedTable {
+  /** Column names (nothing is loaded) */
+  columnNames(): string[];
+  
+  /** Column types by name (nothing is loaded) */
+  schema(): Record<string, number>;
+  
+  readonly rowCount: number;
+  
+  /** Bytes of column data currently paged in */
+  readonly cachedBytes: number;
+  
+  /** Load one column (caller-owned reference) */
+  col(name: string): Promise<Vector>;
+  
+  /** Native table over the given columns (all by default) */
+  table(...names: string[]): Promise<Table>;
+  
+  /** Query that pages in only the columns it references */
+  select(...cols: string[]): SplayedQuery;
+  where(condition: Expr): SplayedQuery;
+  
+  /** Drop one cached column, or all of them */
+  evict(name?: string): void;
+  
+  /** Release every cached column and the symbol file */
+  drop(): void;
+}
+
+/**
+ * SELECT over a SplayedTable
+ */
+export declare class SplayedQuery {
+  select(...cols: string[]): SplayedQuery;
+  withColumn(name: string, expr: Expr): SplayedQuery;
+  where(condition: Expr): SplayedQuery;
+  groupBy(...cols: string[]): SplayedQuery;
+  col(name: string): Expr;
+  
+  /** Columns of the splayed table the query reads */
+  columnsUsed(): string[];
+  
+  /** Page in the referenced columns and run the query */
+  execute(): Promise<Table>;
 }
 
 // ============================================================================
@@ -363,6 +639,15 @@ export declare class RayforceSDK {
   
   /** RayforceDB version string */
   readonly version: string;
+
+  /** Number of times memory growth has replaced the WASM heap buffer */
+  readonly heapGeneration: number;
+
+  /** Native pointer width in bytes: 4 (wasm32) or 8 (wasm64 build) */
+  readonly pointerSize: number;
+
+  /** Whether the vector kernels were built with WASM SIMD (-msimd128) */
+  readonly simd: boolean;
   
   // ==========================================================================
   // Core Methods
@@ -375,6 +660,75 @@ export declare class RayforceSDK {
    */
   eval(code: string, sourceName?: string): RayObject;
   
+  /**
+   * Evaluate one top-level form at a time, yielding to the event loop at
+   * most every `yieldMs`. An aborted signal rejects at the next yield and
+   * interrupt() before the next form: a running form (e.g. one long
+   * select) always completes
+   */
+  evalAsync(code: string, options?: EvalAsyncOptions): Promise<RayObject>;
+
+  /**
+   * Stop the running Vector reduction/comparison/filter, Table.sortBy or
+   * view refresh with an "Interrupted" error, or evalAsync before its next
+   * form. Called from another thread sharing `interruptFlag`
+   */
+  interrupt(): void;
+
+  /** Slot interrupt() sets; assign one over a SharedArrayBuffer to share it */
+  interruptFlag: Int32Array;
+  
+  /** Evaluate a plan from PlanBuilder or Lambda.plan without re-parsing */
+  evalPlan(plan: RayObject): RayObject;
+  
+  /** Parse code once into a native lambda over named parameters */
+  prepare(code: string, params?: string[]): PreparedQuery;
+  
+  /** Evaluate through the native prepared cache (runs as a lambda body) */
+  evalCached(code: string): RayObject;
+  
+  /** Drop every natively cached prepared command */
+  clearPreparedCache(): void;
+  
+  /**
+   * Cache select results natively within `bytes` (LRU; 0, the default, is
+   * off). Table inserts, upserts, updates and set() evict affected results;
+   * hits return a private copy, and the budget also counts the tables that
+   * cached results keep alive.
+   */
+  setResultCacheBudget(bytes: number): void;
+  
+  /** Result cache counters since the last clearResultCache() */
+  resultCacheStats(): ResultCacheStats;
+  
+  /** Drop every cached select result and reset the counters */
+  clearResultCache(): void;
+  
+  /**
+   * Keep a group-by of sum/avg/min/max/count/first/last aggregates up to
+   * date incrementally; with a session it refreshes on every flush()
+   */
+  materialize(query: SelectQuery, options?: { session?: AppendSession }): MaterializedView;
+  
+  /**
+   * Profile natively: code runs in parse/eval/format phases, a function has
+   * its eval/select/update/plan/format calls counted. Entries are emitted
+   * as `rayforce:<entry>` performance measures.
+   */
+  profile<T = RayObject>(code: string | (() => T)): ProfileReport<T>;
+  
+  /** Allocator statistics and SDK-owned objects by type (walks the heap) */
+  heapStats(): HeapStats;
+
+  /** Module memory up to the heap top, for init({ snapshot }) (single-threaded builds) */
+  snapshot(): Uint8Array;
+
+  /** False while a split-build side module ('io': CSV + serialization) is not loaded */
+  hasFeature(name: 'io'): boolean;
+
+  /** Load a split-build side module; resolves at once on other builds */
+  loadFeature(name: 'io'): Promise<void>;
+  
   /**
    * Format any RayObject to string
    */
@@ -443,11 +797,40 @@ export declare class RayforceSDK {
    * Create a table from column definitions
    * @param columns - Object with column names as keys and arrays as values
    */
-  table(columns: Record<string, any[]>): Table;
+  table(columns: Record<string, any[] | BulkColumn>): Table;
+
+  /**
+   * Build a table in a single WASM call: TypedArrays are memcpy'd and
+   * symbol columns interned natively
+   */
+  tableFromColumns(columns: Record<string, BulkColumn>, options?: TableFromColumnsOptions): Table;
+
+  // ==========================================================================
+  // Symbols
+  // ==========================================================================
+
+  /** Resolve a symbol id to its string (LRU cached) */
+  symbolString(id: number | bigint): string;
+
+  /** Resolve many symbol ids; cache misses take one native call */
+  resolveSymbols(ids: BigInt64Array | Array<number | bigint>): string[];
+
+  /** Intern many strings in one native call */
+  internSymbols(strings: string[]): BigInt64Array;
+
+  /** DATE/TIME/TIMESTAMP vector from Unix epoch ms in one native pass; NaN is null */
+  fromEpochMillis(type: number, ms: Float64Array | BigInt64Array | number[]): Vector | RayError;
   
   // ==========================================================================
   // Utility Methods
   // ==========================================================================
+
+  /**
+   * Run a synchronous callback in an arena: objects created inside are
+   * dropped on exit, except those returned (directly or as members of a
+   * returned array / plain object). Other objects are dropped on GC.
+   */
+  scope<T>(fn: (sdk: RayforceSDK) => T): T;
   
   /**
    * Set a global variable
@@ -468,8 +851,239 @@ export declare class RayforceSDK {
    * Create column expression
    */
   col(name: string): Expr;
+  
+  // ==========================================================================
+  // CSV Ingest
+  // ==========================================================================
+  
+  /**
+   * Parse CSV content into a table with native typed columns.
+   * Types are inferred from the first rows unless overridden.
+   * @param content - CSV text, first line is the header
+   * @param options.types - Type codes by column name or position (Types.C8 keeps raw strings)
+   */
+  readCsv(content: string, options?: ReadCsvOptions): Table;
+  
+  /**
+   * Ingest CSV chunk by chunk (e.g. File.stream() or a fetch() body)
+   * without holding the whole file in the WASM heap.
+   */
+  readCsvStream(
+    stream: ReadableStream<Uint8Array | string> | AsyncIterable<Uint8Array | string>,
+    options?: ReadCsvStreamOptions
+  ): Promise<Table>;
+  
+  /** Statistics of the last CSV ingest */
+  lastIngestStats(): IngestStats;
+  
+  /**
+   * Import an Arrow IPC stream or file into a native table.
+   * Utf8 and dictionary columns become symbols, validity bitmaps nulls.
+   */
+  readArrow(bytes: ArrayBuffer | ArrayBufferView): Table;
+  
+  // ==========================================================================
+  // Persistence
+  // ==========================================================================
+  
+  /** Encode an object in rayforce's binary format (U8 vector) */
+  serialize(obj: RayObject): Vector;
+  
+  /** Decode bytes produced by serialize() */
+  deserialize(bytes: Vector | ArrayBuffer | ArrayBufferView): RayObject;
+  
+  /**
+   * Persist an object under `name` in the Origin Private File System
+   * (IndexedDB where OPFS is unavailable). Inside a worker the bytes are
+   * written straight from the WASM heap through a sync access handle.
+   * @returns Bytes written
+   */
+  save(name: string, obj: RayObject): Promise<number>;
+  
+  /** Load an object saved with save(); null if none is saved under `name` */
+  load(name: string): Promise<RayObject | null>;
+  
+  /**
+   * Save a table splayed: one file per column, symbols enumerated into a
+   * shared `.sym` file, names/types/row count in `.d`. Written to a new
+   * directory, so the previous save stays readable until this one completes
+   * @returns Bytes written
+   */
+  saveSplayed(name: string, table: Table): Promise<number>;
+  
+  /**
+   * Open a splayed table; columns are loaded on demand and cached
+   * within `maxBytes` (default 256 MiB)
+   */
+  openSplayed(name: string, options?: { maxBytes?: number }): Promise<SplayedTable | null>;
+  
+  /** Delete a saved object or splayed table */
+  removeSaved(name: string): Promise<boolean>;
+  
+  /** Names of all saved objects and splayed tables */
+  listSaved(): Promise<string[]>;
+  
+  // ==========================================================================
+  // Remote IPC
+  // ==========================================================================
+  
+  /**
+   * Connect to a native rayforce server over a WebSocket carrying its binary
+   * IPC protocol (a WebSocket listener, or a WebSocket-to-TCP bridge)
+   */
+  connect(url: string, options?: ConnectOptions): Promise<RemoteConnection>;
+}
+
+/**
+ * Options for RayforceSDK.evalAsync
+ */
+export interface EvalAsyncOptions {
+  /** Checked at yields between top-level forms, never inside one */
+  signal?: AbortSignal;
+  /** Called after each form; offsets are UTF-8 bytes of `code` */
+  onProgress?: (progress: { forms: number; offset: number; length: number }) => void;
+  /** Longest run between yields in ms (default 10) */
+  yieldMs?: number;
+  sourceName?: string;
+}
+
+/**
+ * Options for RayforceSDK.connect
+ */
+export interface ConnectOptions {
+  /** 'user:password' sent in the handshake */
+  auth?: string;
+  /** Open with rayforce's handshake (default true) */
+  handshake?: boolean;
+  /** Connect timeout in ms, 0 for none (default 10000) */
+  timeout?: number;
+  /** WebSocket class, for runtimes without a global one */
+  WebSocket?: new (url: string) => WebSocket;
+}
+
+/**
+ * Connection to a native rayforce server; results are decoded straight
+ * into the WASM heap
+ */
+export declare class RemoteConnection {
+  /** Socket open and handshake done */
+  readonly connected: boolean;
+  readonly bytesSent: number;
+  readonly bytesReceived: number;
+  
+  /** Server-initiated messages; for sync ones the returned object is the reply */
+  onmessage: ((obj: RayObject, sync: boolean) => RayObject | null | void) | null;
+  onclose: (() => void) | null;
+  
+  /** Evaluate on the server; replies arrive in request order */
+  query(expr: string | RayObject): Promise<RayObject>;
+  
+  /** Send without waiting for a result */
+  send(expr: string | RayObject): void;
+  
+  /** Close; unanswered queries reject */
+  close(): void;
+}
+
+/**
+ * Symbol column as packed UTF-8: string i is bytes[offsets[i] .. offsets[i + 1])
+ */
+export interface PackedStrings {
+  bytes: Uint8Array;
+  offsets: Int32Array | Uint32Array;
+}
+
+export type BulkColumn =
+  | Int8Array | Uint8Array | Int16Array | Int32Array | BigInt64Array | Float64Array
+  | string[] | PackedStrings;
+
+/**
+ * Options for RayforceSDK.tableFromColumns
+ */
+export interface TableFromColumnsOptions {
+  /** Type codes by column name, e.g. { day: Types.DATE } for an Int32Array */
+  types?: Record<string, TypeCode>;
 }
 
+/**
+ * Options for RayforceSDK.readCsv
+ */
+export interface ReadCsvOptions {
+  types?: Record<string, TypeCode> | TypeCode[];
+}
+
+/**
+ * Options for RayforceSDK.readCsvStream
+ */
+export interface ReadCsvStreamOptions extends ReadCsvOptions {
+  /** Called after each chunk with the number of rows ingested so far */
+  onProgress?: (rows: number) => void;
+}
+
+/**
+ * Timing and size of the last CSV ingest (times in milliseconds)
+ */
+export interface IngestStats {
+  rows: number;
+  columns: number;
+  bytes: number;
+  countMs: number;
+  headerMs: number;
+  allocMs: number;
+  parseMs: number;
+  totalMs: number;
+}
+
+// ============================================================================
+// Worker Proxy (rayforce.proxy.js)
+// ============================================================================
+
+/**
+ * Handle to a RayObject held by the worker; other members are forwarded
+ * to the worker-side object and resolve asynchronously
+ */
+export declare class RemoteObject {
+  readonly handle: number;
+  readonly className: string;
+  readonly type: number;
+  readonly length: number;
+  call(method: string, ...args: any[]): Promise<any>;
+  /** Table columns by name; numeric columns as TypedArrays */
+  columns(): Promise<Record<string, TypedArray | any[]>>;
+  typedArray(): Promise<TypedArray>;
+  drop(): Promise<boolean>;
+  [member: string]: any;
+}
+
+/**
+ * Async proxy of RayforceSDK running in a dedicated Web Worker
+ */
+export declare class RayforceWorkerSDK {
+  call(method: string, ...args: any[]): Promise<any>;
+  /** Interrupt the worker's running call; false without SharedArrayBuffer */
+  interrupt(): boolean;
+  terminate(): void;
+  [member: string]: any;
+}
+
+export interface WorkerSDKOptions {
+  wasmPath?: string;
+  wasmMtPath?: string;
+  memory64?: boolean;
+  wasm64Path?: string;
+  threads?: number;
+  lean?: boolean;
+  snapshot?: Uint8Array | ArrayBuffer | string | URL;
+  wasmModule?: WebAssembly.Module;
+  workerPath?: string | URL;
+  onReady?: (version: string) => void;
+}
+
+export declare function createWorkerSDK(options?: WorkerSDKOptions): Promise<RayforceWorkerSDK>;
+
+/** Compile (once per URL) the .wasm next to an Emscripten loader such as rayforce.js */
+export declare function compileModule(loaderPath: string | URL): Promise<WebAssembly.Module>;
+
 // ============================================================================
 // Factory Function
 // ============================================================================
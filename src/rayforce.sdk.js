@@ -63,6 +63,50 @@ const ELEMENT_SIZES = {
   [Types.LIST]: 4, // pointer size in WASM32
 };
 
+// obj_header() scratch struct: i32 type, attrs, rc, flags; i64 len; data ptr
+const OBJ_HEADER_SIZE = 32;
+const OBJ_HEADER_ATOM = 1;
+const OBJ_HEADER_VECTOR = 2;
+const OBJ_HEADER_NULL = 4;
+const OBJ_HEADER_ERR = 8;
+
+// build_plan() instructions, encoded as (op, arg) i32 pairs
+const PLAN_PUSH = 0;
+const PLAN_QUOTE = 1;
+const PLAN_CALL = 2;
+const PLAN_DICT = 3;
+
+// Profiler entries, in prof_stats_t slot order (PROF_PARSE ... PROF_UPDATE)
+const PROFILE_ENTRIES = [
+  'parse', 'eval', 'format', 'evalCmd', 'evalCached', 'evalPlan', 'select', 'update',
+];
+const PROFILE_SLOT_FIELDS = 5;
+
+// kern_reduce() / kern_compare() operations
+const KERNEL_REDUCE = { sum: 0, min: 1, max: 2, avg: 3 };
+const KERNEL_COMPARE = { eq: 0, ne: 1, lt: 2, le: 3, gt: 4, ge: 5 };
+
+// Side modules of the split build (split_features() bits in main.c)
+const SPLIT_FEATURES = { io: 1 };
+
+// Message types of rayforce's IPC header (ipc_encode / ipc_msg_type)
+const IPC_MSG = { ASYNC: 0, SYNC: 1, RESPONSE: 2 };
+
+// Rayforce temporal epoch (2000-01-01 UTC) in Unix ms, and one day in ms
+const RAY_EPOCH_MS = Date.UTC(2000, 0, 1);
+const DAY_MS = 86400000;
+
+// Column type implied by a TypedArray in bulk table construction
+// (override per column with options.types, e.g. Int32Array as DATE)
+const BULK_COLUMN_TYPES = new Map([
+  [Int8Array, Types.B8],
+  [Uint8Array, Types.U8],
+  [Int16Array, Types.I16],
+  [Int32Array, Types.I32],
+  [BigInt64Array, Types.I64],
+  [Float64Array, Types.F64],
+]);
+
 // TypedArray constructors for each type
 const TYPED_ARRAY_MAP = {
   [Types.B8]: Int8Array,
@@ -78,6 +122,410 @@ const TYPED_ARRAY_MAP = {
   [Types.SYMBOL]: BigInt64Array,
 };
 
+// Zero-copy views to the Vector they read, so a view held on its own
+// (`rf.eval('(til 10)').typedArray`) keeps the wrapper, and with it the
+// native vector, from being finalized while the view is reachable
+const VIEW_OWNERS = new WeakMap();
+
+// ============================================================================
+// Symbol Cache
+// ============================================================================
+
+// Default capacity of the per-SDK id -> string cache
+const SYMBOL_CACHE_SIZE = 65536;
+
+/**
+ * LRU cache of symbol id -> string. Map iteration order is insertion
+ * order, so re-inserting on hit keeps the oldest entry first.
+ */
+class SymbolCache {
+  constructor(capacity) {
+    this._capacity = capacity;
+    this._map = new Map();
+  }
+
+  get(id) {
+    const str = this._map.get(id);
+    if (str !== undefined) {
+      this._map.delete(id);
+      this._map.set(id, str);
+    }
+    return str;
+  }
+
+  set(id, str) {
+    this._map.delete(id);
+    this._map.set(id, str);
+    if (this._map.size > this._capacity) {
+      this._map.delete(this._map.keys().next().value);
+    }
+  }
+
+  clear() {
+    this._map.clear();
+  }
+}
+
+// ============================================================================
+// Scope Helpers
+// ============================================================================
+
+/**
+ * RayObjects returned from a scope() callback: the value itself or the
+ * members of a returned array / plain object
+ * @param {any} result
+ * @returns {Set<RayObject>}
+ */
+function scopeResults(result) {
+  const kept = new Set();
+  const visit = (v) => {
+    if (v instanceof RayObject) kept.add(v);
+  };
+
+  if (Array.isArray(result)) {
+    result.forEach(visit);
+  } else if (result !== null && typeof result === 'object' && result.constructor === Object) {
+    Object.values(result).forEach(visit);
+  } else {
+    visit(result);
+  }
+
+  return kept;
+}
+
+// ============================================================================
+// Bulk Column Helpers
+// ============================================================================
+
+/**
+ * Pack strings as UTF-8 into one buffer with offsets (length n + 1)
+ * @param {string[]} strings
+ * @returns {{bytes: Uint8Array, offsets: Int32Array}}
+ */
+function packStrings(strings) {
+  const encoder = new TextEncoder();
+  const offsets = new Int32Array(strings.length + 1);
+  let bytes = new Uint8Array(Math.max(64, strings.length * 8));
+  let pos = 0;
+
+  for (let i = 0; i < strings.length; i++) {
+    const str = String(strings[i]);
+    // UTF-8 needs at most 3 bytes per UTF-16 code unit
+    if (pos + str.length * 3 > bytes.length) {
+      const grown = new Uint8Array(Math.max(bytes.length * 2, pos + str.length * 3));
+      grown.set(bytes.subarray(0, pos));
+      bytes = grown;
+    }
+    pos += encoder.encodeInto(str, bytes.subarray(pos)).written;
+    offsets[i + 1] = pos;
+  }
+
+  return { bytes: bytes.subarray(0, pos), offsets };
+}
+
+/**
+ * Decode packed UTF-8 strings from the heap. ASCII blobs (the common case)
+ * are decoded in one TextDecoder pass and sliced by offset.
+ * @param {Uint8Array} heap
+ * @param {number} ptr - Start of the string bytes
+ * @param {Int32Array} offsets - n + 1 byte offsets relative to ptr
+ * @returns {string[]}
+ */
+function decodePacked(heap, ptr, offsets) {
+  const n = offsets.length - 1;
+  const total = offsets[n];
+  let bytes = heap.subarray(ptr, ptr + total);
+  // TextDecoder rejects views over SharedArrayBuffer (wasm-mt heap)
+  if (typeof SharedArrayBuffer !== 'undefined' && bytes.buffer instanceof SharedArrayBuffer) {
+    bytes = bytes.slice();
+  }
+
+  const decoder = new TextDecoder('utf-8');
+  const text = decoder.decode(bytes);
+  const result = new Array(n);
+
+  if (text.length === total) {
+    for (let i = 0; i < n; i++) result[i] = text.slice(offsets[i], offsets[i + 1]);
+  } else {
+    for (let i = 0; i < n; i++) result[i] = decoder.decode(bytes.subarray(offsets[i], offsets[i + 1]));
+  }
+
+  return result;
+}
+
+function isPackedStrings(col) {
+  return col !== null && typeof col === 'object' &&
+    col.bytes instanceof Uint8Array && ArrayBuffer.isView(col.offsets);
+}
+
+// Columns table() may hand to tableFromColumns because the result matches
+// _arrayToVector: BigInt64Array (I64), Float64Array led by a non-integer
+// (F64, since _arrayToVector types by the first element), arrays of only
+// strings (SYMBOL), and packed strings, which _arrayToVector cannot take
+function isBulkIdentical(col) {
+  if (col instanceof BigInt64Array) return col.length > 0;
+  if (col instanceof Float64Array) return col.length > 0 && !Number.isInteger(col[0]);
+  if (Array.isArray(col)) return col.length > 0 && col.every(v => typeof v === 'string');
+  return isPackedStrings(col);
+}
+
+// ============================================================================
+// Persistent Storage
+// ============================================================================
+
+// OPFS directory (and IndexedDB database) holding saved objects
+const STORAGE_ROOT = 'rayforce';
+
+/**
+ * Check a storage name: one path component, no separators
+ * @param {string} name
+ * @returns {string}
+ */
+function storageName(name) {
+  if (typeof name !== 'string' || !/^[A-Za-z0-9_.-]+$/.test(name) || /^\.\.?$/.test(name)) {
+    throw new Error(`Invalid storage name '${name}'`);
+  }
+  return name;
+}
+
+/**
+ * File name of a splayed column; names starting with '.' are reserved for
+ * the table's `.d` and `.sym` files
+ * @param {string} column
+ * @returns {string}
+ */
+function splayFile(column) {
+  if (column === '' || column[0] === '.' || /[\/\\]/.test(column)) {
+    throw new Error(`Column name '${column}' cannot be splayed`);
+  }
+  return column;
+}
+
+// Per-process counter making generation directory names unique
+let splayGenerations = 0;
+
+/**
+ * Fresh generation directory for a splayed table: hidden, so it cannot
+ * clash with a column file
+ * @returns {string}
+ */
+function splayGeneration() {
+  return `.g${Date.now().toString(36)}${(splayGenerations++).toString(36)}`;
+}
+
+function hasOPFS() {
+  return typeof navigator !== 'undefined' && navigator.storage !== undefined &&
+    typeof navigator.storage.getDirectory === 'function';
+}
+
+/**
+ * Resolve a directory under the OPFS storage root
+ * @param {string[]} path - Components below STORAGE_ROOT
+ * @param {boolean} create
+ * @returns {Promise<FileSystemDirectoryHandle|null>} null if missing
+ */
+async function opfsDir(path, create) {
+  let dir = await navigator.storage.getDirectory();
+  try {
+    for (const part of [STORAGE_ROOT, ...path]) {
+      dir = await dir.getDirectoryHandle(part, { create });
+    }
+  } catch (error) {
+    if (error.name === 'NotFoundError') return null;
+    throw error;
+  }
+  return dir;
+}
+
+/**
+ * Open the IndexedDB fallback store (browsers without OPFS)
+ * @returns {Promise<IDBDatabase>}
+ */
+function idbOpen() {
+  return new Promise((resolve, reject) => {
+    const req = indexedDB.open(STORAGE_ROOT, 1);
+    req.onupgradeneeded = () => req.result.createObjectStore('files');
+    req.onsuccess = () => resolve(req.result);
+    req.onerror = () => reject(req.error);
+  });
+}
+
+function idbRequest(mode, fn) {
+  return idbOpen().then(db => new Promise((resolve, reject) => {
+    const tx = db.transaction('files', mode);
+    const req = fn(tx.objectStore('files'));
+    tx.oncomplete = () => { db.close(); resolve(req.result); };
+    tx.onerror = () => { db.close(); reject(tx.error); };
+  }));
+}
+
+/**
+ * Write one file. `view()` returns the bytes and is called right before
+ * they are consumed, so a heap view is never held across an await. In a
+ * worker the bytes go straight from the WASM heap to disk through a sync
+ * access handle; elsewhere they are copied once into a Blob.
+ * @param {string[]} path - Directory components below STORAGE_ROOT
+ * @param {string} file
+ * @param {() => Uint8Array} view
+ * @returns {Promise<void>}
+ */
+async function storageWrite(path, file, view) {
+  if (!hasOPFS()) {
+    if (typeof indexedDB === 'undefined') throw new Error('Persistent storage is not available');
+    const blob = new Blob([view()]);
+    await idbRequest('readwrite', store => store.put(blob, [...path, file].join('/')));
+    return;
+  }
+
+  const handle = await (await opfsDir(path, true)).getFileHandle(file, { create: true });
+
+  if (typeof handle.createSyncAccessHandle === 'function') {
+    const access = await handle.createSyncAccessHandle();
+    try {
+      const bytes = view();
+      access.truncate(0);
+      access.write(bytes, { at: 0 });
+      access.flush();
+    } finally {
+      access.close();
+    }
+    return;
+  }
+
+  const blob = new Blob([view()]);
+  const writable = await handle.createWritable();
+  await writable.write(blob);
+  await writable.close();
+}
+
+/**
+ * Read one file into memory supplied by `alloc(size)`, which returns a
+ * getter for the destination view (re-read after each await, as the heap
+ * may grow). Sync access handles read straight into it; otherwise the
+ * file is streamed in chunk by chunk.
+ * @param {string[]} path
+ * @param {string} file
+ * @param {(size: number) => (() => Uint8Array)} alloc
+ * @returns {Promise<boolean>} false if the file does not exist
+ */
+async function storageRead(path, file, alloc) {
+  let blob;
+
+  if (!hasOPFS()) {
+    if (typeof indexedDB === 'undefined') throw new Error('Persistent storage is not available');
+    blob = await idbRequest('readonly', store => store.get([...path, file].join('/')));
+    if (blob === undefined) return false;
+  } else {
+    const dir = await opfsDir(path, false);
+    if (dir === null) return false;
+
+    let handle;
+    try {
+      handle = await dir.getFileHandle(file);
+    } catch (error) {
+      if (error.name === 'NotFoundError') return false;
+      throw error;
+    }
+
+    if (typeof handle.createSyncAccessHandle === 'function') {
+      const access = await handle.createSyncAccessHandle();
+      try {
+        const view = alloc(access.getSize());
+        access.read(view(), { at: 0 });
+      } finally {
+        access.close();
+      }
+      return true;
+    }
+
+    blob = await handle.getFile();
+  }
+
+  const view = alloc(blob.size);
+  const reader = blob.stream().getReader();
+  let offset = 0;
+  try {
+    while (true) {
+      const { done, value } = await reader.read();
+      if (done) break;
+      view().set(value, offset);
+      offset += value.length;
+    }
+  } finally {
+    reader.releaseLock();
+  }
+  return true;
+}
+
+/**
+ * Remove a file or directory (recursively) below the storage root
+ * @param {string[]} path
+ * @param {string} entry
+ * @returns {Promise<boolean>} false if it did not exist
+ */
+async function storageRemove(path, entry) {
+  if (!hasOPFS()) {
+    if (typeof indexedDB === 'undefined') throw new Error('Persistent storage is not available');
+    // Keys are flat paths: a directory is every key below `entry/`
+    const key = [...path, entry].join('/');
+    const below = IDBKeyRange.bound(key + '/', key + '0', false, true);
+    const counts = await Promise.all([key, below].map(range => idbRequest('readwrite', store => {
+      const count = store.count(range);
+      store.delete(range);
+      return count;
+    })));
+    return counts[0] + counts[1] > 0;
+  }
+
+  const dir = await opfsDir(path, false);
+  if (dir === null) return false;
+  try {
+    await dir.removeEntry(entry, { recursive: true });
+    return true;
+  } catch (error) {
+    if (error.name === 'NotFoundError') return false;
+    throw error;
+  }
+}
+
+/**
+ * Names of the entries directly below a storage directory
+ * @param {string[]} path
+ * @returns {Promise<string[]>}
+ */
+async function storageList(path) {
+  if (!hasOPFS()) {
+    if (typeof indexedDB === 'undefined') throw new Error('Persistent storage is not available');
+    const prefix = path.length ? path.join('/') + '/' : '';
+    const keys = await idbRequest('readonly', store => store.getAllKeys());
+    const names = new Set();
+    for (const key of keys) {
+      if (key.startsWith(prefix)) names.add(key.slice(prefix.length).split('/')[0]);
+    }
+    return [...names].sort();
+  }
+
+  const dir = await opfsDir(path, false);
+  if (dir === null) return [];
+  const names = [];
+  for await (const name of dir.keys()) names.push(name);
+  return names.sort();
+}
+
+// ============================================================================
+// Cooperative Scheduling
+// ============================================================================
+
+/**
+ * Give the event loop a turn (input, worker messages, abort listeners):
+ * scheduler.yield() where available, a zero-delay timer otherwise
+ * @returns {Promise<void>}
+ */
+function yieldTask() {
+  if (typeof globalThis.scheduler?.yield === 'function') return globalThis.scheduler.yield();
+  return new Promise(resolve => setTimeout(resolve, 0));
+}
+
 // ============================================================================
 // Main SDK Class
 // ============================================================================
@@ -86,98 +534,349 @@ class RayforceSDK {
   constructor(wasm) {
     this._wasm = wasm;
     this._cmdCounter = 0;
+    this._profiling = false;
     this._setupBindings();
+    this._setupHeapTracking();
+    this._symbolCache = new SymbolCache(SYMBOL_CACHE_SIZE);
+    this._setupReclamation();
+    // Polled by the native loops (js_rayforce_interrupted); reading it
+    // consumes a pending interrupt
+    this._interrupt = new Int32Array(1);
+    wasm.rayforce_interrupted = () => Atomics.exchange(this._interrupt, 0, 0);
+  }
+
+  /**
+   * Wrapped pointers are dropped by a FinalizationRegistry once their
+   * RayObject is garbage collected; drop()/release() unregister them.
+   * Objects created inside scope() are also tracked by the active arena.
+   */
+  _setupReclamation() {
+    this._scopes = [];
+    this._registry = typeof FinalizationRegistry === 'function'
+      ? new FinalizationRegistry((cell) => {
+        this._live.delete(cell);
+        if (cell.ptr !== 0) this._dropObj(cell.ptr);
+      })
+      : null;
+    // Cells of owned objects, for heapStats() live counts (never the objects)
+    this._live = new Set();
+    // WeakRefs of live TableIndexes; collected ones free their native index
+    this._indexes = new Set();
+    this._indexRegistry = typeof FinalizationRegistry === 'function'
+      ? new FinalizationRegistry(({ handle, ref }) => {
+        this._indexes.delete(ref);
+        this._indexFree(handle);
+      })
+      : null;
+  }
+
+  _track(obj) {
+    this._live.add(obj._cell);
+    if (this._registry !== null) this._registry.register(obj, obj._cell, obj);
+    if (this._scopes.length > 0) this._scopes[this._scopes.length - 1].push(obj);
+  }
+
+  _untrack(obj) {
+    this._live.delete(obj._cell);
+    if (this._registry !== null) this._registry.unregister(obj);
+  }
+
+  /**
+   * Run `fn` outside any active scope, for objects cached past it (still
+   * reclaimed on GC)
+   */
+  _unscoped(fn) {
+    const scopes = this._scopes;
+    this._scopes = [];
+    try {
+      return fn();
+    } finally {
+      this._scopes = scopes;
+    }
+  }
+
+  /**
+   * Run `fn` in an arena: every object created inside it is dropped when it
+   * returns, except those in the return value (the value itself, or members
+   * of a returned array / plain object), which move to the enclosing scope.
+   * The callback must be synchronous.
+   * @param {Function} fn - Called with the SDK
+   * @returns {any} The callback's return value
+   *
+   * @example
+   * const total = rf.scope(() => rf.eval('(sum (til 1000000))').toJS());
+   */
+  scope(fn) {
+    const arena = [];
+    this._scopes.push(arena);
+    let result;
+    let kept = new Set();
+
+    try {
+      result = fn(this);
+      if (result !== null && typeof result === 'object' && typeof result.then === 'function') {
+        throw new Error('scope() callback must be synchronous');
+      }
+      kept = scopeResults(result);
+    } finally {
+      this._scopes.pop();
+      const outer = this._scopes.length > 0 ? this._scopes[this._scopes.length - 1] : null;
+      for (const obj of arena) {
+        if (kept.has(obj)) {
+          if (outer !== null) outer.push(obj);
+        } else {
+          obj.drop();
+        }
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Pointer for a native call that takes ownership of `value`: caller-owned
+   * objects hand over a new reference, temporaries hand over themselves
+   * @param {RayObject|any} value
+   * @returns {number}
+   */
+  _handOff(value) {
+    if (value instanceof RayObject) return this._cloneObj(value._ptr);
+    return this._toRayObject(value).release();
+  }
+
+  /**
+   * Track heap generations. Memory growth swaps HEAPU8.buffer and detaches
+   * every view over the old one; rayforce.post.js calls onMemoryGrowth so
+   * Vector views only need an integer compare to know they are stale.
+   */
+  _setupHeapTracking() {
+    const w = this._wasm;
+    this._heapGeneration = 0;
+    const previous = w.onMemoryGrowth;
+    w.onMemoryGrowth = () => {
+      this._heapGeneration++;
+      if (previous) previous();
+    };
+  }
+
+  /**
+   * Number of times the WASM heap buffer has been replaced by growth
+   * @returns {number}
+   */
+  get heapGeneration() {
+    return this._heapGeneration;
+  }
+
+  /**
+   * Native pointer width in bytes: 4 for wasm32, 8 for the wasm64 build
+   * @returns {number}
+   */
+  get pointerSize() {
+    return this._ptrSize;
+  }
+
+  /**
+   * Whether the vector kernels were built with WASM SIMD (-msimd128)
+   * @returns {boolean}
+   */
+  get simd() {
+    return this._kernSimd() === 1;
   }
 
   _setupBindings() {
     const w = this._wasm;
-    
+
+    // Pointer width of the build: 4 for wasm32, 8 for wasm64 (MEMORY64)
+    this._ptrSize = w._ptr_size ? w._ptr_size() : 4;
+    const wide = this._ptrSize === 8;
+
+    // Exports are bound from their C signature, return type first:
+    // p pointer, j i64, i i32 (or narrower), d f64, v void, s string (a JS
+    // string marshalled through the stack, or a decoded result). Numeric
+    // wasm32 exports are Module._xxx itself; on wasm64 pointers and i64
+    // cross as BigInt and are converted so the SDK only sees Numbers.
+    const bind = (name, sig) => {
+      const fn = w['_' + name];
+      const ret = sig[0];
+      const args = sig.slice(1);
+      const strings = sig.includes('s');
+      if (!strings && !(wide && /[pj]/.test(sig))) return fn;
+
+      return (...a) => {
+        const stack = strings ? w.stackSave() : 0;
+        try {
+          for (let i = 0; i < args.length; i++) {
+            if (args[i] === 's') a[i] = this._stackString(a[i]);
+            if (wide && args[i] !== 'i' && args[i] !== 'd') a[i] = BigInt(a[i]);
+          }
+          const r = fn(...a);
+          if (ret === 's') return w.UTF8ToString(Number(r));
+          return wide && (ret === 'p' || ret === 'j') ? Number(r) : r;
+        } finally {
+          if (strings) w.stackRestore(stack);
+        }
+      };
+    };
+
+    this._malloc = bind('malloc', 'pp');
+    this._free = bind('free', 'vp');
+
     // Core functions
-    this._evalCmd = w.cwrap('eval_cmd', 'number', ['string', 'string']);
-    this._evalStr = w.cwrap('eval_str', 'number', ['string']);
-    this._strOfObj = w.cwrap('strof_obj', 'string', ['number']);
-    this._dropObj = w.cwrap('drop_obj', null, ['number']);
-    this._cloneObj = w.cwrap('clone_obj', 'number', ['number']);
-    this._versionStr = w.cwrap('version_str', 'string', []);
+    this._evalCmd = bind('eval_cmd', 'pss');
+    this._evalStr = bind('eval_str', 'ps');
+    this._evalNextForm = bind('eval_next_form', 'ipi');
+    this._evalFormEnd = bind('eval_form_end', 'ipi');
+    this._evalSpan = bind('eval_span', 'ppiis');
+    this._strOfObj = bind('strof_obj', 'sp');
+    this._dropObj = bind('drop_obj', 'vp');
+    this._cloneObj = bind('clone_obj', 'pp');
+    this._versionStr = bind('version_str', 's');
     
     // Type introspection
-    this._getObjType = w.cwrap('get_obj_type', 'number', ['number']);
-    this._getObjLen = w.cwrap('get_obj_len', 'number', ['number']);
-    this._isObjAtom = w.cwrap('is_obj_atom', 'number', ['number']);
-    this._isObjVector = w.cwrap('is_obj_vector', 'number', ['number']);
-    this._isObjNull = w.cwrap('is_obj_null', 'number', ['number']);
-    this._isObjError = w.cwrap('is_obj_error', 'number', ['number']);
-    this._getObjRc = w.cwrap('get_obj_rc', 'number', ['number']);
+    this._getObjType = bind('get_obj_type', 'ip');
+    this._getObjLen = bind('get_obj_len', 'jp');
+    this._isObjAtom = bind('is_obj_atom', 'ip');
+    this._isObjVector = bind('is_obj_vector', 'ip');
+    this._isObjNull = bind('is_obj_null', 'ip');
+    this._isObjError = bind('is_obj_error', 'ip');
+    this._getObjRc = bind('get_obj_rc', 'ip');
+    this._objHeader = bind('obj_header', 'vpp');
+    this._headerPtr = this._malloc(OBJ_HEADER_SIZE);
     
     // Memory access
-    this._getDataPtr = w.cwrap('get_data_ptr', 'number', ['number']);
-    this._getElementSize = w.cwrap('get_element_size', 'number', ['number']);
-    this._getDataByteSize = w.cwrap('get_data_byte_size', 'number', ['number']);
+    this._getDataPtr = bind('get_data_ptr', 'pp');
+    this._getElementSize = bind('get_element_size', 'ii');
+    this._getDataByteSize = bind('get_data_byte_size', 'jp');
     
     // Scalar constructors
-    this._initB8 = w.cwrap('init_b8', 'number', ['number']);
-    this._initU8 = w.cwrap('init_u8', 'number', ['number']);
-    this._initC8 = w.cwrap('init_c8', 'number', ['number']);
-    this._initI16 = w.cwrap('init_i16', 'number', ['number']);
-    this._initI32 = w.cwrap('init_i32', 'number', ['number']);
-    this._initI64 = w.cwrap('init_i64', 'number', ['number']);
-    this._initF64 = w.cwrap('init_f64', 'number', ['number']);
-    this._initDate = w.cwrap('init_date', 'number', ['number']);
-    this._initTime = w.cwrap('init_time', 'number', ['number']);
-    this._initTimestamp = w.cwrap('init_timestamp', 'number', ['number']);
-    this._initSymbolStr = w.cwrap('init_symbol_str', 'number', ['string', 'number']);
-    this._initStringStr = w.cwrap('init_string_str', 'number', ['string', 'number']);
+    this._initB8 = bind('init_b8', 'pi');
+    this._initU8 = bind('init_u8', 'pi');
+    this._initC8 = bind('init_c8', 'pi');
+    this._initI16 = bind('init_i16', 'pi');
+    this._initI32 = bind('init_i32', 'pi');
+    this._initI64 = bind('init_i64', 'pj');
+    this._initF64 = bind('init_f64', 'pd');
+    this._initDate = bind('init_date', 'pi');
+    this._initTime = bind('init_time', 'pi');
+    this._initTimestamp = bind('init_timestamp', 'pj');
+    this._initSymbolStr = bind('init_symbol_str', 'psj');
+    this._initStringStr = bind('init_string_str', 'psj');
     
     // Scalar readers
-    this._readB8 = w.cwrap('read_b8', 'number', ['number']);
-    this._readU8 = w.cwrap('read_u8', 'number', ['number']);
-    this._readC8 = w.cwrap('read_c8', 'number', ['number']);
-    this._readI16 = w.cwrap('read_i16', 'number', ['number']);
-    this._readI32 = w.cwrap('read_i32', 'number', ['number']);
-    this._readI64 = w.cwrap('read_i64', 'number', ['number']);
-    this._readF64 = w.cwrap('read_f64', 'number', ['number']);
-    this._readDate = w.cwrap('read_date', 'number', ['number']);
-    this._readTime = w.cwrap('read_time', 'number', ['number']);
-    this._readTimestamp = w.cwrap('read_timestamp', 'number', ['number']);
-    this._readSymbolId = w.cwrap('read_symbol_id', 'number', ['number']);
-    this._symbolToStr = w.cwrap('symbol_to_str', 'string', ['number']);
+    this._readB8 = bind('read_b8', 'ip');
+    this._readU8 = bind('read_u8', 'ip');
+    this._readC8 = bind('read_c8', 'ip');
+    this._readI16 = bind('read_i16', 'ip');
+    this._readI32 = bind('read_i32', 'ip');
+    this._readI64 = bind('read_i64', 'jp');
+    this._readF64 = bind('read_f64', 'dp');
+    this._readDate = bind('read_date', 'ip');
+    this._readTime = bind('read_time', 'ip');
+    this._readTimestamp = bind('read_timestamp', 'jp');
+    this._readSymbolId = bind('read_symbol_id', 'jp');
+    this._symbolToStr = bind('symbol_to_str', 'sj');
     
     // Vector operations
-    this._initVector = w.cwrap('init_vector', 'number', ['number', 'number']);
-    this._initList = w.cwrap('init_list', 'number', ['number']);
-    this._vecAtIdx = w.cwrap('vec_at_idx', 'number', ['number', 'number']);
-    this._atIdx = w.cwrap('at_idx', 'number', ['number', 'number']);
-    this._atObj = w.cwrap('at_obj', 'number', ['number', 'number']);
-    this._pushObj = w.cwrap('push_obj', 'number', ['number', 'number']);
-    this._insObj = w.cwrap('ins_obj', 'number', ['number', 'number', 'number']);
+    this._initVector = bind('init_vector', 'pij');
+    this._initTableBulk = bind('init_table_bulk', 'pipppppj');
+    this._initList = bind('init_list', 'pj');
+    this._vecAtIdx = bind('vec_at_idx', 'ppj');
+    this._atIdx = bind('at_idx', 'ppj');
+    this._atObj = bind('at_obj', 'ppp');
+    this._pushObj = bind('push_obj', 'ppp');
+    this._vecInsert = bind('vec_insert', 'pppj');
+    this._insObj = bind('ins_obj', 'ppjp');
     
     // Dict operations
-    this._initDict = w.cwrap('init_dict', 'number', ['number', 'number']);
-    this._dictKeys = w.cwrap('dict_keys', 'number', ['number']);
-    this._dictVals = w.cwrap('dict_vals', 'number', ['number']);
-    this._dictGet = w.cwrap('dict_get', 'number', ['number', 'number']);
+    this._initDict = bind('init_dict', 'ppp');
+    this._dictKeys = bind('dict_keys', 'pp');
+    this._dictVals = bind('dict_vals', 'pp');
+    this._dictGet = bind('dict_get', 'ppp');
     
     // Table operations
-    this._initTable = w.cwrap('init_table', 'number', ['number', 'number']);
-    this._tableKeys = w.cwrap('table_keys', 'number', ['number']);
-    this._tableVals = w.cwrap('table_vals', 'number', ['number']);
-    this._tableCol = w.cwrap('table_col', 'number', ['number', 'string', 'number']);
-    this._tableRow = w.cwrap('table_row', 'number', ['number', 'number']);
-    this._tableCount = w.cwrap('table_count', 'number', ['number']);
+    this._initTable = bind('init_table', 'ppp');
+    this._tableKeys = bind('table_keys', 'pp');
+    this._tableVals = bind('table_vals', 'pp');
+    this._tableCol = bind('table_col', 'ppsj');
+    this._tableRow = bind('table_row', 'ppj');
+    this._tableCount = bind('table_count', 'jp');
     
     // Query operations
-    this._querySelect = w.cwrap('query_select', 'number', ['number']);
-    this._queryUpdate = w.cwrap('query_update', 'number', ['number']);
-    this._tableInsert = w.cwrap('table_insert', 'number', ['number', 'number']);
-    this._tableUpsert = w.cwrap('table_upsert', 'number', ['number', 'number', 'number']);
+    this._querySelect = bind('query_select', 'pp');
+    this._querySelectUncached = bind('query_select_uncached', 'pp');
+    this._queryUpdate = bind('query_update', 'pp');
+    this._tableInsert = bind('table_insert', 'ppp');
+    this._tableUpsert = bind('table_upsert', 'pppp');
     
     // Other operations
-    this._internSymbol = w.cwrap('intern_symbol', 'number', ['string', 'number']);
-    this._globalSet = w.cwrap('global_set', null, ['number', 'number']);
-    this._quoteObj = w.cwrap('quote_obj', 'number', ['number']);
-    this._serialize = w.cwrap('serialize', 'number', ['number']);
-    this._deserialize = w.cwrap('deserialize', 'number', ['number']);
-    this._getTypeName = w.cwrap('get_type_name', 'string', ['number']);
+    this._internSymbol = bind('intern_symbol', 'jsj');
+    this._internSymbolsBulk = bind('intern_symbols_bulk', 'vpppj');
+    this._symbolsToStrsBulk = bind('symbols_to_strs_bulk', 'ppj');
+    this._globalSet = bind('global_set', 'ppp');
+    this._quoteObj = bind('quote_obj', 'pp');
+    this._buildPlan = bind('build_plan', 'ppipi');
+    this._evalPlan = bind('eval_plan', 'pp');
+    this._prepareCmd = bind('prepare_cmd', 'pss');
+    this._evalCached = bind('eval_cached', 'ps');
+    this._preparedCacheClear = bind('prepared_cache_clear', 'v');
+    this._resultCacheSetBudget = bind('result_cache_set_budget', 'vj');
+    this._resultCacheStats = bind('result_cache_stats', 'p');
+    this._resultCacheClear = bind('result_cache_clear', 'v');
+    this._profileBegin = bind('profile_begin', 'v');
+    this._profileEnd = bind('profile_end', 'p');
+    this._profileCmd = bind('profile_cmd', 'ps');
+    this._heapStats = bind('heap_stats', 'p');
+    this._heapEnd = bind('heap_end', 'p');
+    this._splitFeatures = w._split_features ? w._split_features() : 0;
+    this._loadedFeatures = 0;
+    this._featureLoads = new Map();
+    this._kernReduce = bind('kern_reduce', 'ppi');
+    this._kernCompare = bind('kern_compare', 'ppip');
+    this._kernCompact = bind('kern_compact', 'ppp');
+    this._kernSimd = bind('kern_simd', 'i');
+    this._temporalToMsF64 = bind('temporal_to_ms_f64', 'jpp');
+    this._temporalToMsI64 = bind('temporal_to_ms_i64', 'jpp');
+    this._temporalFromMsF64 = bind('temporal_from_ms_f64', 'pipj');
+    this._temporalFromMsI64 = bind('temporal_from_ms_i64', 'pipj');
+    this._serialize = bind('serialize', 'pp');
+    this._deserialize = bind('deserialize', 'pp');
+    this._ipcVersion = bind('ipc_version', 'i');
+    this._ipcHeaderSize = bind('ipc_header_size', 'i');
+    this._ipcEncode = bind('ipc_encode', 'ppi');
+    this._ipcMsgLen = bind('ipc_msg_len', 'jp');
+    this._ipcMsgType = bind('ipc_msg_type', 'ip');
+    this._splayEnum = bind('splay_enum', 'pp');
+    this._splayUnenum = bind('splay_unenum', 'ppp');
+    this._appendBegin = bind('append_begin', 'pp');
+    this._appendRows = bind('append_rows', 'jpppj');
+    this._appendFlush = bind('append_flush', 'pp');
+    this._appendEnd = bind('append_end', 'pp');
+    this._mviewNew = bind('mview_new', 'pppipi');
+    this._mviewUpdate = bind('mview_update', 'jpp');
+    this._mviewRead = bind('mview_read', 'ppp');
+    this._mviewFree = bind('mview_free', 'vp');
+    this._tableSort = bind('table_sort', 'ppsj');
+    this._vecIsSorted = bind('vec_is_sorted', 'ip');
+    this._indexNew = bind('index_new', 'ppsj');
+    this._indexKind = bind('index_kind', 'ip');
+    this._indexSource = bind('index_source', 'pp');
+    this._indexRebuild = bind('index_rebuild', 'ip');
+    this._indexRows = bind('index_rows', 'ppp');
+    this._indexWhere = bind('index_where', 'ppp');
+    this._indexGroups = bind('index_groups', 'pp');
+    this._indexFree = bind('index_free', 'vp');
+    this._indexKey = this._malloc(8);
+    this._exportArrow = bind('export_arrow', 'pp');
+    this._importArrow = bind('import_arrow', 'ppj');
+    this._getTypeName = bind('get_type_name', 'si');
+
+    // CSV ingest
+    this._readCsvTyped = bind('read_csv_typed', 'pppij');
+    this._csvBegin = bind('csv_begin', 'ppj');
+    this._csvFeed = bind('csv_feed', 'jppj');
+    this._csvEnd = bind('csv_end', 'pp');
+    this._csvAbort = bind('csv_abort', 'vp');
+    this._lastIngestStats = bind('last_ingest_stats', 'p');
   }
 
   // ==========================================================================
@@ -188,19 +887,423 @@ class RayforceSDK {
    * Get RayforceDB version string
    * @returns {string}
    */
-  get version() {
-    return this._versionStr();
+  get version() {
+    return this._versionStr();
+  }
+
+  /**
+   * Evaluate a Rayfall expression. Always parsed, since it runs at top
+   * level; repeated expressions that define nothing can use evalCached().
+   * @param {string} code - The expression to evaluate
+   * @param {string} [sourceName] - Optional source name for error tracking
+   * @returns {RayObject} The result wrapped in appropriate type
+   */
+  eval(code, sourceName) {
+    const ptr = this._evalCmd(code, sourceName || `eval:${++this._cmdCounter}`);
+    return this._wrapPtr(ptr);
+  }
+
+  /**
+   * Evaluate a program one top-level form at a time, giving the event loop
+   * a turn every `yieldMs` so the page (or worker) stays responsive and an
+   * AbortSignal can stop it between forms.
+   *
+   * The signal is checked at each yield, and interrupt() (from another
+   * thread through interruptFlag, as the worker proxy does) before every
+   * form. A form that is already running is inside the core evaluator,
+   * which has no interrupt check of its own, so it runs to completion: one
+   * large select, or a whole script wrapped in a single `(do ...)`, cannot
+   * be cut short. Split long work into separate top-level forms.
+   * @param {string} code - One or more Rayfall expressions
+   * @param {Object} [options]
+   * @param {AbortSignal} [options.signal] - Rejects with its reason at the
+   *   first yield after it aborts, never inside a running form
+   * @param {Function} [options.onProgress] - ({ forms, offset, length }) after
+   *   each form, offsets in UTF-8 bytes
+   * @param {number} [options.yieldMs=10] - Longest run between yields
+   * @param {string} [options.sourceName] - Source name for error tracking
+   * @returns {Promise<RayObject>} Result of the last form; stops at the first error
+   *
+   * @example
+   * const ctrl = new AbortController();
+   * cancelButton.onclick = () => ctrl.abort();
+   * const t = await rf.evalAsync(script, { signal: ctrl.signal });
+   */
+  async evalAsync(code, options = {}) {
+    const { signal, onProgress, yieldMs = 10 } = options;
+    const name = options.sourceName || `eval:${++this._cmdCounter}`;
+    signal?.throwIfAborted();
+
+    const w = this._wasm;
+    const length = w.lengthBytesUTF8(code);
+    const src = this._malloc(length + 1);
+    w.stringToUTF8(code, src, length + 1);
+
+    let result = null;
+    let forms = 0;
+    let slice = performance.now();
+    try {
+      for (let pos = this._evalNextForm(src, 0); pos >= 0; pos = this._evalNextForm(src, pos)) {
+        if (Atomics.exchange(this._interrupt, 0, 0) !== 0) {
+          throw signal?.aborted ? signal.reason : new DOMException('Interrupted', 'AbortError');
+        }
+        const end = this._evalFormEnd(src, pos);
+        if (result !== null) result.drop();
+        result = this._unscoped(() => this._wrapPtr(this._evalSpan(src, pos, end, name)));
+        if (result.isError) break;
+
+        pos = end;
+        forms++;
+        if (onProgress) onProgress({ forms, offset: end, length });
+        if (performance.now() - slice >= yieldMs) {
+          await yieldTask();
+          signal?.throwIfAborted();
+          slice = performance.now();
+        }
+      }
+    } catch (error) {
+      if (result !== null) result.drop();
+      throw error;
+    } finally {
+      this._free(src);
+    }
+
+    return result ?? new RayNull(this, 0);
+  }
+
+  /**
+   * Stop the native loop running now with an "Interrupted" error: Vector
+   * reductions, comparisons and filters, Table.sortBy and materialized view
+   * refreshes check every 64K elements, evalAsync before its next form.
+   * The engine's own thread is busy while those run, so this is called
+   * from another thread sharing interruptFlag. A pending interrupt is
+   * consumed by the first check that sees it.
+   */
+  interrupt() {
+    Atomics.store(this._interrupt, 0, 1);
+  }
+
+  /**
+   * The Int32Array slot interrupt() sets. Assign one over a
+   * SharedArrayBuffer to interrupt this SDK from another thread.
+   * @type {Int32Array}
+   */
+  get interruptFlag() {
+    return this._interrupt;
+  }
+
+  set interruptFlag(flag) {
+    this._interrupt = flag;
+  }
+
+  /**
+   * Evaluate a plan built with PlanBuilder (or Lambda.plan) by pointer.
+   * Plans can be kept and evaluated repeatedly without re-parsing.
+   * @param {RayObject} plan
+   * @returns {RayObject}
+   */
+  evalPlan(plan) {
+    return this._wrapPtr(this._evalPlan(plan._ptr));
+  }
+
+  /**
+   * Parse `code` once into a native lambda over named parameters. The
+   * compiled form is cached natively by source text, so preparing the same
+   * code again is cheap.
+   * @param {string} code - Rayfall expression using the parameter names
+   * @param {string[]} [params=[]] - Parameter names, in call order
+   * @returns {PreparedQuery}
+   *
+   * @example
+   * const q = rf.prepare('(select {from: trades where: (> price lim)})', ['lim']);
+   * q.execute({ lim: 100 });
+   */
+  prepare(code, params = []) {
+    for (const p of params) {
+      if (typeof p !== 'string' || !/^[^\s()[\]{}"`]+$/.test(p)) {
+        throw new Error(`Invalid parameter name: ${p}`);
+      }
+    }
+
+    const fn = this._wrapPtr(this._prepareCmd(code, params.join(' ')));
+    if (fn.isError) {
+      const message = fn.message;
+      fn.drop();
+      throw new Error(message);
+    }
+    return new PreparedQuery(this, fn, params);
+  }
+
+  /**
+   * Evaluate through the native prepared cache: repeated code is parsed
+   * only once. The code runs as a lambda body, so local bindings made by it
+   * do not persist (use eval() for definitions).
+   * @param {string} code
+   * @returns {RayObject}
+   */
+  evalCached(code) {
+    return this._wrapPtr(this._evalCached(code));
+  }
+
+  /**
+   * Drop every natively cached prepared command
+   */
+  clearPreparedCache() {
+    this._preparedCacheClear();
+  }
+
+  /**
+   * Cache select results natively within `bytes` (least recently used
+   * results are evicted; 0, the default, turns caching off). Identical
+   * SelectQuery.execute() calls over the same Table then run ray_select
+   * once. Table.insert, upserts, updates and set() evict the affected
+   * results. Every execute() gets its own copy of a cached result, so it
+   * may be written to. Call clearResultCache() after changing a table or a
+   * global the queries use through eval(), or a table's columns in place.
+   * Budgeted bytes cover the results and the tables they keep alive.
+   * @param {number} bytes
+   *
+   * @example
+   * rf.setResultCacheBudget(64 << 20);
+   * const q = trades.where(rf.col('sym').eq('AAPL'));
+   * q.execute(); q.execute();
+   * rf.resultCacheStats().hits; // 1
+   */
+  setResultCacheBudget(bytes) {
+    this._resultCacheSetBudget(bytes);
+  }
+
+  /**
+   * Result cache counters since the last clearResultCache()
+   * @returns {{hits: number, misses: number, bypassed: number,
+   *   evictions: number, invalidations: number, entries: number,
+   *   bytes: number, budget: number}}
+   */
+  resultCacheStats() {
+    const base = this._resultCacheStats() / 8;
+    const f = this._wasm.HEAPF64;
+    return {
+      hits: f[base],
+      misses: f[base + 1],
+      bypassed: f[base + 2],
+      evictions: f[base + 3],
+      invalidations: f[base + 4],
+      entries: f[base + 5],
+      bytes: f[base + 6],
+      budget: f[base + 7],
+    };
+  }
+
+  /**
+   * Drop every cached select result and reset the counters
+   */
+  clearResultCache() {
+    this._resultCacheClear();
+  }
+
+  /**
+   * Register a group-by aggregation as an incrementally maintained view.
+   * The query must group by columns and compute sum/avg/min/max/count/
+   * first/last of columns (no where). Pass an AppendSession bound to the
+   * query's table to refresh the view from the delta rows on every flush.
+   * @param {SelectQuery} query
+   * @param {Object} [options]
+   * @param {AppendSession} [options.session]
+   * @returns {MaterializedView}
+   *
+   * @example
+   * const session = trades.appender();
+   * const view = rf.materialize(trades.select('sym')
+   *   .withColumn('volume', rf.col('size').sum())
+   *   .groupBy('sym'), { session });
+   * session.append(batch);
+   * session.flush().drop();
+   * view.read();  // O(groups), history is not rescanned
+   */
+  materialize(query, options = {}) {
+    const view = new MaterializedView(this, query);
+    if (options.session) {
+      view._session = options.session;
+      options.session._views.add(view);
+    }
+    return view;
+  }
+
+  // Live TableIndex over `column` of `table`, or null
+  _indexFor(table, column) {
+    for (const ref of this._indexes) {
+      const index = ref.deref();
+      if (index !== undefined && index._column === column &&
+          this._indexSource(index._handle) === table._ptr) {
+        return index;
+      }
+    }
+    return null;
+  }
+
+  // Write i64 `key` (a BigInt) to the index key slot, returning its address
+  _stageIndexKey(key) {
+    new BigInt64Array(this._wasm.HEAPU8.buffer, this._indexKey, 1)[0] = key;
+    return this._indexKey;
+  }
+
+  /**
+   * Profile evaluation natively. A code string runs in separate parse, eval
+   * and format phases (as a lambda body, like evalCached); a function is run
+   * synchronously and every eval/select/update/plan/format call it makes is
+   * counted. Entries are also emitted as `rayforce:<entry>` performance
+   * measures (the last call of each) so they show in the browser profiler.
+   * @param {string|Function} code
+   * @returns {{result: any, totalMs: number, allocatedBytes: number,
+   *   maxEndBytes: number, heapBytes: number,
+   *   entries: Object<string, {calls: number, ms: number, bytes: number}>}}
+   *
+   * @example
+   * const { entries } = rf.profile('(select {from: trades by: sym})');
+   * entries.parse.ms; entries.eval.ms; entries.format.ms;
+   */
+  profile(code) {
+    if (this._profiling) throw new Error('A profile is already running');
+    const perf = globalThis.performance;
+    let result, base, start, end;
+
+    this._profiling = true;
+    this._profileBegin();
+    try {
+      start = perf.now();
+      result = typeof code === 'function' ? code() : this._wrapPtr(this._profileCmd(code));
+      end = perf.now();
+    } finally {
+      base = this._profileEnd() / 8;
+      this._profiling = false;
+    }
+
+    const f = this._wasm.HEAPF64;
+    const entries = {};
+    PROFILE_ENTRIES.forEach((name, i) => {
+      const at = base + i * PROFILE_SLOT_FIELDS;
+      if (f[at] === 0) return;
+      entries[name] = { calls: f[at], ms: f[at + 1], bytes: f[at + 2] };
+      this._measure(`rayforce:${name}`, f[at + 3], f[at + 4]);
+    });
+    this._measure('rayforce:profile', start, end - start);
+
+    const tail = base + PROFILE_ENTRIES.length * PROFILE_SLOT_FIELDS;
+    return {
+      result,
+      totalMs: end - start,
+      allocatedBytes: f[tail],
+      // In use after the fullest entry call: not a peak within calls
+      maxEndBytes: f[tail + 1],
+      heapBytes: this._wasm.HEAPU8.length,
+      entries,
+    };
+  }
+
+  /**
+   * Allocator statistics plus the objects this SDK still owns (not dropped,
+   * released or collected) by type name, to spot leaks and to compare
+   * `make wasm` with `make wasm-pool`. Sampling walks the native heap.
+   * @returns {{allocator: string, heapBytes: number, arenaBytes: number,
+   *   usedBytes: number, freeBytes: number, freeChunks: number,
+   *   releasableBytes: number, fragmentation: number, liveObjects: number,
+   *   liveByType: Object<string, number>}}
+   */
+  heapStats() {
+    const base = this._heapStats() / 8;
+    const f = this._wasm.HEAPF64;
+    const liveByType = {};
+    let liveObjects = 0;
+
+    for (const cell of this._live) {
+      if (cell.ptr === 0) continue;
+      const name = this._getTypeName(this._getObjType(cell.ptr));
+      liveByType[name] = (liveByType[name] || 0) + 1;
+      liveObjects++;
+    }
+
+    return {
+      allocator: f[base + 6] === 1 ? 'pool' : 'sys',
+      heapBytes: this._wasm.HEAPU8.length,
+      arenaBytes: f[base],
+      usedBytes: f[base + 1],
+      freeBytes: f[base + 2],
+      freeChunks: f[base + 3],
+      releasableBytes: f[base + 4],
+      fragmentation: f[base + 5],
+      liveObjects,
+      liveByType,
+    };
+  }
+
+  /**
+   * Copy of the module memory up to the top of the heap, for
+   * init({ snapshot }): restored instances skip main() and runtime setup.
+   * Take it from a fresh instance of the same build (ideally lean, see
+   * `make snapshot`); objects alive at this point live on in every restored
+   * instance. Not available for the multi-threaded build.
+   * @returns {Uint8Array}
+   */
+  snapshot() {
+    const heap = this._wasm.HEAPU8;
+    if (typeof SharedArrayBuffer !== 'undefined' && heap.buffer instanceof SharedArrayBuffer) {
+      throw new Error('Snapshots need the single-threaded build');
+    }
+    return heap.slice(0, this._heapEnd());
+  }
+
+  /**
+   * Whether a subsystem can be called now. Everything is built in except on
+   * the split build (make wasm-split), where 'io' (CSV ingest and
+   * serialization) is a side module until loadFeature('io') resolves.
+   * @param {string} name
+   * @returns {boolean}
+   */
+  hasFeature(name) {
+    const bit = SPLIT_FEATURES[name];
+    if (bit === undefined) throw new Error(`Unknown feature '${name}'`);
+    return (this._splitFeatures & bit) === 0 || (this._loadedFeatures & bit) !== 0;
   }
 
   /**
-   * Evaluate a Rayfall expression
-   * @param {string} code - The expression to evaluate
-   * @param {string} [sourceName] - Optional source name for error tracking
-   * @returns {RayObject} The result wrapped in appropriate type
+   * Fetch and link a side module of the split build (rayforce-<name>.wasm,
+   * located like the main .wasm). Resolves at once on other builds; async
+   * SDK calls that need a feature load it themselves.
+   * @param {string} name - 'io'
+   * @returns {Promise<void>}
    */
-  eval(code, sourceName) {
-    const ptr = this._evalCmd(code, sourceName || `eval:${++this._cmdCounter}`);
-    return this._wrapPtr(ptr);
+  loadFeature(name) {
+    if (this.hasFeature(name)) return Promise.resolve();
+
+    let pending = this._featureLoads.get(name);
+    if (pending === undefined) {
+      const options = { loadAsync: true, global: true, nodelete: true };
+      pending = this._wasm.loadDynamicLibrary(`rayforce-${name}.wasm`, options).then(
+        () => { this._loadedFeatures |= SPLIT_FEATURES[name]; },
+        (error) => {
+          this._featureLoads.delete(name);
+          throw new Error(`Failed to load feature '${name}': ${error.message || error}`);
+        });
+      this._featureLoads.set(name, pending);
+    }
+    return pending;
+  }
+
+  _requireFeature(name) {
+    if (!this.hasFeature(name)) {
+      throw new Error(`'${name}' is a side module in this build: await sdk.loadFeature('${name}') first`);
+    }
+  }
+
+  // User Timing entry; older engines without measure options are skipped
+  _measure(name, start, duration) {
+    const perf = globalThis.performance;
+    if (typeof perf.measure !== 'function') return;
+    try {
+      perf.measure(name, { start, duration });
+    } catch (error) {
+      // performance.measure(name, options) is User Timing Level 3
+    }
   }
 
   /**
@@ -226,6 +1329,70 @@ class RayforceSDK {
   // Type Wrapping
   // ==========================================================================
 
+  /**
+   * Read an object's header in one native call
+   * @param {number} ptr
+   * @returns {{type: number, attrs: number, rc: number, flags: number, length: number, data: number}}
+   */
+  _header(ptr) {
+    this._objHeader(ptr, this._headerPtr);
+    const h = this._wasm.HEAP32;
+    const i = this._headerPtr / 4;
+    return {
+      type: h[i],
+      attrs: h[i + 1],
+      rc: h[i + 2] >>> 0,
+      flags: h[i + 3],
+      length: (h[i + 4] >>> 0) + h[i + 5] * 4294967296,
+      data: this._getPtr(this._headerPtr + 24),
+    };
+  }
+
+  /**
+   * Read a native pointer (raw_p) stored at a heap address
+   * @param {number} addr
+   * @returns {number}
+   */
+  _getPtr(addr) {
+    const h = this._wasm.HEAPU32;
+    const i = addr / 4;
+    return this._ptrSize === 8 ? h[i] + h[i + 1] * 4294967296 : h[i];
+  }
+
+  /**
+   * Store heap addresses as a native pointer array (raw_p[])
+   * @param {number} addr
+   * @param {ArrayLike<number>} ptrs
+   */
+  _setPtrs(addr, ptrs) {
+    const array = this._ptrArray(ptrs);
+    this._wasm.HEAPU8.set(new Uint8Array(array.buffer), addr);
+  }
+
+  /**
+   * Heap addresses laid out as a native pointer array
+   * @param {ArrayLike<number>} ptrs
+   * @returns {Uint32Array|BigUint64Array}
+   */
+  _ptrArray(ptrs) {
+    return this._ptrSize === 8 ? BigUint64Array.from(ptrs, BigInt) : Uint32Array.from(ptrs);
+  }
+
+  /**
+   * Copy a string to the stack as NUL-terminated UTF-8, for calls made
+   * inside stackSave/stackRestore; null and undefined pass NULL
+   * @param {string|null} str
+   * @returns {number}
+   */
+  _stackString(str) {
+    if (str === null || str === undefined) return 0;
+    const w = this._wasm;
+    const size = w.lengthBytesUTF8(str) + 1;
+    const ptr = w.stackAlloc(size);
+    w.stringToUTF8(str, ptr, size);
+    return ptr;
+  }
+
   /**
    * Wrap a raw pointer in the appropriate RayObject subclass
    * @param {number} ptr
@@ -233,9 +1400,16 @@ class RayforceSDK {
    */
   _wrapPtr(ptr) {
     if (ptr === 0) return new RayNull(this, 0);
-    
-    const type = this._getObjType(ptr);
-    const isAtom = this._isObjAtom(ptr);
+
+    const header = this._header(ptr);
+    const obj = this._wrapHeader(ptr, header);
+    obj._type = header.type;
+    return obj;
+  }
+
+  _wrapHeader(ptr, header) {
+    const type = header.type;
+    const isAtom = (header.flags & OBJ_HEADER_ATOM) !== 0;
     const absType = type < 0 ? -type : type;
     
     // Check for error
@@ -244,7 +1418,7 @@ class RayforceSDK {
     }
     
     // Check for null
-    if (type === Types.NULL || this._isObjNull(ptr)) {
+    if (type === Types.NULL || (header.flags & OBJ_HEADER_NULL) !== 0) {
       return new RayNull(this, ptr);
     }
     
@@ -361,8 +1535,7 @@ class RayforceSDK {
     let days;
     if (value instanceof Date) {
       // Convert JS Date to days since 2000-01-01
-      const epoch = new Date(2000, 0, 1);
-      days = Math.floor((value - epoch) / (1000 * 60 * 60 * 24));
+      days = Math.floor((value.getTime() - RAY_EPOCH_MS) / DAY_MS);
     } else {
       days = value | 0;
     }
@@ -395,8 +1568,7 @@ class RayforceSDK {
   timestamp(value) {
     let ns;
     if (value instanceof Date) {
-      const epoch = new Date(2000, 0, 1);
-      ns = Number(value - epoch) * 1000000; // ms to ns
+      ns = (value.getTime() - RAY_EPOCH_MS) * 1000000; // ms to ns
     } else {
       ns = Number(value);
     }
@@ -468,27 +1640,32 @@ class RayforceSDK {
   dict(obj) {
     const keys = Object.keys(obj);
     const keyVec = this.vector(Types.SYMBOL, keys.length);
-    const keyView = keyVec.typedArray;
-    for (let i = 0; i < keys.length; i++) {
-      keyView[i] = BigInt(this._internSymbol(keys[i], keys[i].length));
-    }
+    // Interning may grow the heap: fetch the view after it
+    const keyIds = this.internSymbols(keys);
+    keyVec.typedArray.set(keyIds);
     
     const valList = this.list(Object.values(obj).map(v => this._toRayObject(v)));
-    return new Dict(this, this._initDict(keyVec._ptr, valList._ptr));
+    return new Dict(this, this._initDict(keyVec.release(), valList.release()));
   }
 
   /**
    * Create a table from column definitions
+   *
+   * Takes the bulk path only when every column converts the same way there;
+   * call tableFromColumns directly for narrower typed arrays (I32, B8, ...)
    * @param {Object} columns - Object with column names as keys and arrays as values
    * @returns {Table}
    */
   table(columns) {
+    const values = Object.values(columns);
+    if (values.length > 0 && values.every(isBulkIdentical)) {
+      return this.tableFromColumns(columns);
+    }
+
     const colNames = Object.keys(columns);
     const keyVec = this.vector(Types.SYMBOL, colNames.length);
-    const keyView = keyVec.typedArray;
-    for (let i = 0; i < colNames.length; i++) {
-      keyView[i] = BigInt(this._internSymbol(colNames[i], colNames[i].length));
-    }
+    const keyIds = this.internSymbols(colNames);
+    keyVec.typedArray.set(keyIds);
     
     const valList = this.list();
     for (const name of colNames) {
@@ -497,7 +1674,222 @@ class RayforceSDK {
       valList.push(col);
     }
     
-    return new Table(this, this._initTable(keyVec._ptr, valList._ptr));
+    return new Table(this, this._initTable(keyVec.release(), valList.release()));
+  }
+
+  /**
+   * Resolve a symbol id to its string (cached)
+   * @param {number|bigint} id
+   * @returns {string}
+   */
+  symbolString(id) {
+    const key = Number(id);
+    let str = this._symbolCache.get(key);
+    if (str === undefined) {
+      str = this._symbolToStr(key);
+      this._symbolCache.set(key, str);
+    }
+    return str;
+  }
+
+  /**
+   * Resolve many symbol ids to strings. Cache misses are resolved in one
+   * native call and decoded from a single packed UTF-8 blob.
+   * @param {BigInt64Array|Array<number|bigint>} ids
+   * @returns {string[]}
+   */
+  resolveSymbols(ids) {
+    const n = ids.length;
+    const result = new Array(n);
+    const missing = new Map(); // id -> positions
+
+    for (let i = 0; i < n; i++) {
+      const id = Number(ids[i]);
+      const str = this._symbolCache.get(id);
+      if (str !== undefined) {
+        result[i] = str;
+      } else if (missing.has(id)) {
+        missing.get(id).push(i);
+      } else {
+        missing.set(id, [i]);
+      }
+    }
+
+    if (missing.size === 0) return result;
+
+    const w = this._wasm;
+    const unique = BigInt64Array.from(missing.keys(), BigInt);
+    const idsPtr = this._malloc(unique.byteLength);
+    if (idsPtr === 0) throw new Error('Out of memory: failed to stage symbol ids');
+
+    try {
+      new BigInt64Array(w.HEAPU8.buffer, idsPtr, unique.length).set(unique);
+      const blob = this._symbolsToStrsBulk(idsPtr, unique.length);
+      if (blob === 0) throw new Error('Out of memory: failed to resolve symbols');
+
+      const heap = w.HEAPU8;
+      const offsets = new Int32Array(heap.buffer, blob, unique.length + 1);
+      const strs = decodePacked(heap, blob + offsets.byteLength, offsets);
+
+      for (let k = 0; k < unique.length; k++) {
+        const id = Number(unique[k]);
+        this._symbolCache.set(id, strs[k]);
+        for (const i of missing.get(id)) result[i] = strs[k];
+      }
+    } finally {
+      this._free(idsPtr);
+    }
+
+    return result;
+  }
+
+  /**
+   * Intern many strings in one native call
+   * @param {string[]} strings
+   * @returns {BigInt64Array} Symbol ids
+   */
+  internSymbols(strings) {
+    const w = this._wasm;
+    const n = strings.length;
+    const ids = new BigInt64Array(n);
+    if (n === 0) return ids;
+
+    const { bytes, offsets } = packStrings(strings);
+    const bytesPtr = this._malloc(Math.max(bytes.length, 1));
+    const offsetsPtr = this._malloc(offsets.byteLength);
+    const idsPtr = this._malloc(ids.byteLength);
+
+    try {
+      if (bytesPtr === 0 || offsetsPtr === 0 || idsPtr === 0) {
+        throw new Error('Out of memory: failed to stage symbols');
+      }
+      w.HEAPU8.set(bytes, bytesPtr);
+      w.HEAPU8.set(new Uint8Array(offsets.buffer), offsetsPtr);
+      this._internSymbolsBulk(bytesPtr, offsetsPtr, idsPtr, n);
+      ids.set(new BigInt64Array(w.HEAPU8.buffer, idsPtr, n));
+    } finally {
+      this._free(idsPtr);
+      this._free(offsetsPtr);
+      this._free(bytesPtr);
+    }
+
+    for (let i = 0; i < n; i++) this._symbolCache.set(Number(ids[i]), String(strings[i]));
+    return ids;
+  }
+
+  /**
+   * Build a DATE, TIME or TIMESTAMP vector from Unix epoch milliseconds in
+   * one native pass (TIME takes ms since midnight). NaN, or the i64 null
+   * in a BigInt64Array, becomes a null element.
+   * @param {number} type - Types.DATE, Types.TIME or Types.TIMESTAMP
+   * @param {Float64Array|BigInt64Array|number[]} ms
+   * @returns {Vector|RayError}
+   *
+   * @example
+   * const ts = rf.fromEpochMillis(Types.TIMESTAMP, Float64Array.from(dates, d => d.getTime()));
+   */
+  fromEpochMillis(type, ms) {
+    const w = this._wasm;
+    const wide = ms instanceof BigInt64Array;
+    const view = wide || ms instanceof Float64Array ? ms : Float64Array.from(ms);
+    const ptr = this._malloc(Math.max(view.byteLength, 1));
+    if (ptr === 0) throw new Error('Out of memory: failed to stage epoch values');
+
+    try {
+      w.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+      const convert = wide ? this._temporalFromMsI64 : this._temporalFromMsF64;
+      return this._wrapPtr(convert(type, ptr, view.length));
+    } finally {
+      this._free(ptr);
+    }
+  }
+
+  /**
+   * Build a table in a single WASM call from columnar data. TypedArray
+   * columns are memcpy'd into native vectors; symbol columns (string
+   * arrays, or pre-packed `{ bytes, offsets }` where string i is
+   * `bytes[offsets[i] .. offsets[i + 1])`) are interned natively.
+   * @param {Object<string, TypedArray|string[]|{bytes: Uint8Array, offsets: Int32Array}>} columns
+   * @param {Object} [options]
+   * @param {Object<string, number>} [options.types] - Type codes by column
+   *   name for arrays whose element type is ambiguous (Int32Array as DATE or
+   *   TIME, BigInt64Array as TIMESTAMP, Uint8Array as B8 or C8)
+   * @returns {Table}
+   */
+  tableFromColumns(columns, options = {}) {
+    const w = this._wasm;
+    const names = Object.keys(columns);
+    const ncols = names.length;
+    if (ncols === 0) throw new Error('tableFromColumns: no columns');
+
+    const types = new Int8Array(ncols);
+    const data = new Array(ncols);
+    const packed = new Array(ncols).fill(null);
+    let rows = -1;
+
+    for (let i = 0; i < ncols; i++) {
+      const name = names[i];
+      let col = columns[name];
+      let len;
+
+      if (Array.isArray(col)) col = packStrings(col);
+
+      if (isPackedStrings(col)) {
+        types[i] = Types.SYMBOL;
+        packed[i] = col;
+        data[i] = col.bytes;
+        len = col.offsets.length - 1;
+      } else if (ArrayBuffer.isView(col) && BULK_COLUMN_TYPES.has(col.constructor)) {
+        const override = options.types && options.types[name];
+        types[i] = override !== undefined ? override : BULK_COLUMN_TYPES.get(col.constructor);
+        if (ELEMENT_SIZES[types[i]] !== col.BYTES_PER_ELEMENT) {
+          throw new TypeError(`Column '${name}': ${col.constructor.name} cannot hold type ${types[i]}`);
+        }
+        data[i] = col;
+        len = col.length;
+      } else {
+        throw new TypeError(`Column '${name}': expected a TypedArray or strings`);
+      }
+
+      if (rows !== -1 && len !== rows) {
+        throw new RangeError(`Column '${name}' has ${len} rows, expected ${rows}`);
+      }
+      rows = len;
+    }
+
+    // Stage everything in the heap; each malloc may grow it, so HEAPU8 is
+    // re-read for every copy
+    const allocs = [];
+    const stage = (view) => {
+      const ptr = this._malloc(Math.max(view.byteLength, 1));
+      if (ptr === 0) throw new Error('Out of memory: failed to stage table columns');
+      allocs.push(ptr);
+      w.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+      return ptr;
+    };
+
+    try {
+      const nameList = packStrings(names);
+      const namesPtr = stage(nameList.bytes);
+      const nameOffsPtr = stage(nameList.offsets);
+      const typesPtr = stage(types);
+
+      const dataPtrs = new Array(ncols).fill(0);
+      const symOffPtrs = new Array(ncols).fill(0);
+      for (let i = 0; i < ncols; i++) {
+        dataPtrs[i] = stage(data[i]);
+        if (packed[i] !== null) {
+          const offsets = packed[i].offsets;
+          symOffPtrs[i] = stage(offsets instanceof Int32Array ? offsets : Int32Array.from(offsets));
+        }
+      }
+
+      const ptr = this._initTableBulk(ncols, namesPtr, nameOffsPtr, typesPtr,
+        stage(this._ptrArray(dataPtrs)), stage(this._ptrArray(symOffPtrs)), rows);
+      return this._wrapPtr(ptr);
+    } finally {
+      for (const ptr of allocs) this._free(ptr);
+    }
   }
 
   /**
@@ -522,25 +1914,29 @@ class RayforceSDK {
     } else if (typeof first === 'string') {
       type = Types.SYMBOL;
     } else if (first instanceof Date) {
-      type = Types.TIMESTAMP;
+      // One native pass over the epoch ms instead of a BigInt per element
+      const ms = new Float64Array(arr.length);
+      for (let i = 0; i < arr.length; i++) {
+        ms[i] = arr[i] == null ? NaN : arr[i] instanceof Date ? arr[i].getTime() : Number(arr[i]);
+      }
+      return this.fromEpochMillis(Types.TIMESTAMP, ms);
     } else {
       // Default to list for mixed types
       return this.list(arr.map(v => this._toRayObject(v)));
     }
     
     const vec = this.vector(type, arr.length);
+    if (type === Types.SYMBOL) {
+      const ids = this.internSymbols(arr);
+      vec.typedArray.set(ids);
+      return vec;
+    }
+
     const view = vec.typedArray;
     
     for (let i = 0; i < arr.length; i++) {
-      if (type === Types.SYMBOL) {
-        view[i] = BigInt(this._internSymbol(arr[i], arr[i].length));
-      } else if (type === Types.I64 || type === Types.TIMESTAMP) {
-        if (arr[i] instanceof Date) {
-          const epoch = new Date(2000, 0, 1);
-          view[i] = BigInt((arr[i] - epoch) * 1000000);
-        } else {
-          view[i] = BigInt(arr[i]);
-        }
+      if (type === Types.I64) {
+        view[i] = BigInt(arr[i]);
       } else if (type === Types.B8) {
         view[i] = arr[i] ? 1 : 0;
       } else {
@@ -603,6 +1999,436 @@ class RayforceSDK {
   typeName(typeCode) {
     return this._getTypeName(typeCode);
   }
+
+  // ==========================================================================
+  // CSV Ingest
+  // ==========================================================================
+
+  /**
+   * Parse CSV content into a table with native typed columns.
+   * Column types are inferred from a sample of the first rows; use
+   * `options.types` to override them.
+   * @param {string} content - CSV text, first line is the header
+   * @param {Object} [options]
+   * @param {Object<string, number>|number[]} [options.types] - Type codes by
+   *   column name or position (Types.C8 keeps raw strings)
+   * @returns {Table}
+   */
+  readCsv(content, options = {}) {
+    if (typeof content !== 'string') throw new Error('Content must be a string');
+    this._requireFeature('io');
+
+    const w = this._wasm;
+    const lengthBytes = w.lengthBytesUTF8(content) + 1;
+    const contentPtr = this._malloc(lengthBytes);
+    let typesPtr = 0;
+    let ntypes = 0;
+
+    try {
+      w.stringToUTF8(content, contentPtr, lengthBytes);
+
+      const schema = this._csvSchema(content, options.types);
+      if (schema !== null) {
+        ntypes = schema.length;
+        typesPtr = this._malloc(ntypes);
+        w.HEAP8.set(schema, typesPtr);
+      }
+
+      return this._wrapPtr(this._readCsvTyped(contentPtr, typesPtr, ntypes, lengthBytes - 1));
+    } finally {
+      if (typesPtr !== 0) this._free(typesPtr);
+      this._free(contentPtr);
+    }
+  }
+
+  /**
+   * Import an Apache Arrow IPC stream or file (e.g. apache-arrow's
+   * `tableToIPC` output) into a native table in one call. Fixed-width
+   * columns are copied as-is, Utf8 and dictionary columns become symbols
+   * and validity bitmaps become nulls.
+   * @param {Uint8Array|ArrayBufferView|ArrayBuffer} bytes
+   * @returns {Table}
+   */
+  readArrow(bytes) {
+    const data = ArrayBuffer.isView(bytes)
+      ? new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+      : new Uint8Array(bytes);
+
+    const w = this._wasm;
+    const ptr = this._malloc(data.length || 1);
+    if (ptr === 0) throw new Error('Out of memory: failed to stage Arrow buffer');
+
+    try {
+      w.HEAPU8.set(data, ptr);
+      return this._wrapPtr(this._importArrow(ptr, data.length));
+    } finally {
+      this._free(ptr);
+    }
+  }
+
+  /**
+   * Ingest CSV from a stream chunk by chunk without holding the whole file
+   * in the WASM heap. Accepts `File.stream()`, `fetch()` bodies or any
+   * ReadableStream / async iterable of Uint8Array or string chunks.
+   * @param {ReadableStream|AsyncIterable} stream
+   * @param {Object} [options]
+   * @param {Object<string, number>|number[]} [options.types] - Type codes by
+   *   column name or position
+   * @param {Function} [options.onProgress] - Called with rows ingested so far
+   * @returns {Promise<Table>}
+   */
+  async readCsvStream(stream, options = {}) {
+    await this.loadFeature('io');
+    const w = this._wasm;
+    const encoder = new TextEncoder();
+    const decoder = new TextDecoder('utf-8');
+    let session = 0;
+    let staging = 0;
+    let stagingSize = 0;
+    let header = '';
+
+    const begin = (firstLine) => {
+      const schema = this._csvSchema(firstLine, options.types);
+      let typesPtr = 0;
+      if (schema !== null) {
+        typesPtr = this._malloc(schema.length);
+        w.HEAP8.set(schema, typesPtr);
+      }
+      try {
+        session = this._csvBegin(typesPtr, schema ? schema.length : 0);
+      } finally {
+        if (typesPtr !== 0) this._free(typesPtr);
+      }
+      if (session === 0) throw new Error('Failed to start CSV stream');
+    };
+
+    const feed = (bytes) => {
+      if (bytes.length > stagingSize) {
+        if (staging !== 0) this._free(staging);
+        stagingSize = Math.max(bytes.length, stagingSize * 2, 65536);
+        staging = this._malloc(stagingSize);
+        if (staging === 0) throw new Error('Out of memory: failed to allocate CSV chunk');
+      }
+      w.HEAPU8.set(bytes, staging);
+      const rows = this._csvFeed(session, staging, bytes.length);
+      if (rows >= 0 && options.onProgress) options.onProgress(rows);
+    };
+
+    const pending = [];
+    try {
+      for await (const chunk of this._streamChunks(stream)) {
+        const bytes = typeof chunk === 'string' ? encoder.encode(chunk) : chunk;
+        if (session === 0) {
+          // Buffer until the header is known so overrides can be resolved by name
+          pending.push(bytes);
+          header += decoder.decode(bytes, { stream: true });
+          if (header.indexOf('\n') === -1) continue;
+          begin(header);
+          for (const b of pending) feed(b);
+          pending.length = 0;
+          continue;
+        }
+        feed(bytes);
+      }
+
+      if (session === 0) {
+        begin(header);
+        for (const b of pending) feed(b);
+      }
+
+      const ptr = this._csvEnd(session);
+      session = 0;
+      return this._wrapPtr(ptr);
+    } finally {
+      if (session !== 0) this._csvAbort(session);
+      if (staging !== 0) this._free(staging);
+    }
+  }
+
+  /**
+   * Get statistics of the last CSV ingest (readCsv or readCsvStream)
+   * @returns {{rows: number, columns: number, bytes: number, countMs: number,
+   *   headerMs: number, allocMs: number, parseMs: number, totalMs: number}}
+   */
+  lastIngestStats() {
+    const base = this._lastIngestStats() / 8;
+    const f = this._wasm.HEAPF64;
+    return {
+      rows: f[base],
+      columns: f[base + 1],
+      bytes: f[base + 2],
+      countMs: f[base + 3],
+      headerMs: f[base + 4],
+      allocMs: f[base + 5],
+      parseMs: f[base + 6],
+      totalMs: f[base + 7],
+    };
+  }
+
+  /**
+   * Iterate chunks of a ReadableStream or async iterable
+   * @param {ReadableStream|AsyncIterable} stream
+   */
+  async *_streamChunks(stream) {
+    if (typeof stream.getReader !== 'function') {
+      yield* stream;
+      return;
+    }
+    const reader = stream.getReader();
+    try {
+      while (true) {
+        const { done, value } = await reader.read();
+        if (done) return;
+        yield value;
+      }
+    } finally {
+      reader.releaseLock();
+    }
+  }
+
+  /**
+   * Resolve a CSV type override into per-position type codes (0 = infer)
+   * @param {string} content
+   * @param {Object|number[]|undefined} types
+   * @returns {Int8Array|null}
+   */
+  _csvSchema(content, types) {
+    if (!types) return null;
+    if (Array.isArray(types)) return Int8Array.from(types, t => t || 0);
+
+    const eol = content.indexOf('\n');
+    const header = (eol === -1 ? content : content.slice(0, eol)).replace(/\r$/, '');
+    const names = header.split(',').map(n => n.trim().replace(/^"|"$/g, ''));
+    return Int8Array.from(names, n => types[n] || 0);
+  }
+
+  // ==========================================================================
+  // Persistence
+  // ==========================================================================
+
+  /**
+   * Serialize an object into rayforce's binary format
+   * @param {RayObject} obj
+   * @returns {Vector} U8 vector of the encoded bytes
+   */
+  serialize(obj) {
+    this._requireFeature('io');
+    return this._wrapPtr(this._serialize(obj._ptr));
+  }
+
+  /**
+   * Decode bytes produced by serialize()
+   * @param {Vector|Uint8Array|ArrayBuffer} bytes - U8 vector or raw bytes
+   * @returns {RayObject}
+   */
+  deserialize(bytes) {
+    this._requireFeature('io');
+    if (bytes instanceof RayObject) return this._wrapPtr(this._deserialize(bytes._ptr));
+
+    const data = ArrayBuffer.isView(bytes)
+      ? new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+      : new Uint8Array(bytes);
+    const buf = this._unscoped(() => this.vector(Types.U8, data.length));
+    try {
+      buf.typedArray.set(data);
+      return this._wrapPtr(this._deserialize(buf._ptr));
+    } finally {
+      buf.drop();
+    }
+  }
+
+  /**
+   * Persist an object (typically a table) under `name` in the Origin
+   * Private File System, falling back to IndexedDB where OPFS is missing.
+   * Inside a worker (init({ worker: true })) the serialized bytes are
+   * written straight from the WASM heap through a sync access handle.
+   * @param {string} name - Letters, digits, '_', '-' and '.'
+   * @param {RayObject} obj
+   * @returns {Promise<number>} Bytes written
+   */
+  async save(name, obj) {
+    return this._writeObject([], storageName(name), obj);
+  }
+
+  /**
+   * Load an object saved with save(). The file is read directly into a
+   * native U8 vector and decoded in place.
+   * @param {string} name
+   * @returns {Promise<RayObject|null>} null if nothing is saved under `name`
+   */
+  load(name) {
+    return this._readObject([], storageName(name));
+  }
+
+  /**
+   * Save a table splayed: one file per column, symbol columns stored as I32
+   * positions into a shared `.sym` file, all in a new generation directory
+   * below `name/`, then `name/.d` with the column names, types, row count
+   * and generation. Until `.d` is replaced the previous save stays intact;
+   * it is removed afterwards. Open it with openSplayed() to page in only
+   * the columns a query touches.
+   * @param {string} name
+   * @param {Table} table
+   * @returns {Promise<number>} Bytes written
+   */
+  async saveSplayed(name, table) {
+    const dir = storageName(name);
+    const gen = splayGeneration();
+    const names = table.columnNames();
+    names.forEach(splayFile);
+
+    const parts = this._unscoped(() => this._wrapPtr(this._splayEnum(table._ptr)));
+    if (parts.isError) {
+      const message = parts.message;
+      parts.drop();
+      throw new Error(message);
+    }
+
+    const meta = this._unscoped(() => this.scope(() => {
+      const vals = table.values();
+      const types = names.map((_, i) => vals.at(i).type);
+      return this.list([table.columns(), this.vector(Types.I16, types), this.i64(table.rowCount),
+        this.string(gen)]);
+    }));
+
+    let size;
+    try {
+      size = await this._writeObject([dir, gen], '.sym', parts.at(0));
+      for (let i = 0; i < names.length; i++) {
+        size += await this._writeObject([dir, gen], splayFile(names[i]), parts.at(i + 1));
+      }
+      // Written last: it switches readers over to the new generation
+      size += await this._writeObject([dir], '.d', meta);
+    } catch (error) {
+      await storageRemove([dir], gen).catch(() => {});
+      throw error;
+    } finally {
+      meta.drop();
+      parts.drop();
+    }
+
+    // Previous generations, and column files of the flat layout
+    for (const entry of await storageList([dir])) {
+      if (entry !== '.d' && entry !== gen) await storageRemove([dir], entry);
+    }
+    return size;
+  }
+
+  /**
+   * Open a table saved with saveSplayed(). Nothing but the `.d` file is
+   * read until columns are requested.
+   * @param {string} name
+   * @param {Object} [options]
+   * @param {number} [options.maxBytes] - Column cache budget; least recently
+   *   used columns are dropped beyond it (default 256 MiB)
+   * @returns {Promise<SplayedTable|null>} null if no such table is saved
+   */
+  async openSplayed(name, options = {}) {
+    const dir = storageName(name);
+    const meta = await this._readObject([dir], '.d');
+    if (meta === null) return null;
+
+    try {
+      if (meta.isError || !(meta instanceof List) || (meta.length !== 3 && meta.length !== 4)) {
+        throw new Error(`Corrupt splayed table '${name}'`);
+      }
+      const names = meta.at(0).toJS();
+      const types = Array.from(meta.at(1).typedArray);
+      const rows = Number(meta.at(2).value);
+      // Tables saved before generations keep their files next to `.d`
+      const path = meta.length === 4 ? [dir, storageName(meta.at(3).toJS())] : [dir];
+      return new SplayedTable(this, path, names, types, rows, options.maxBytes);
+    } finally {
+      meta.drop();
+    }
+  }
+
+  /**
+   * Serialize an object into a storage file
+   * @returns {Promise<number>} Bytes written
+   */
+  async _writeObject(path, file, obj) {
+    await this.loadFeature('io');
+    const buf = this._unscoped(() => this.serialize(obj));
+    if (buf.isError) {
+      const message = buf.message;
+      buf.drop();
+      throw new Error(message);
+    }
+
+    try {
+      const size = buf.length;
+      await storageWrite(path, file, () => buf.typedArray);
+      return size;
+    } finally {
+      buf.drop();
+    }
+  }
+
+  /**
+   * Read a storage file straight into a U8 vector and deserialize it
+   * @returns {Promise<RayObject|null>} null if the file does not exist
+   */
+  async _readObject(path, file) {
+    await this.loadFeature('io');
+    let buf = null;
+
+    try {
+      const found = await storageRead(path, file, (size) => {
+        buf = this._unscoped(() => this.vector(Types.U8, size));
+        return () => buf.typedArray;
+      });
+      if (!found) return null;
+      return this._wrapPtr(this._deserialize(buf._ptr));
+    } finally {
+      if (buf !== null) buf.drop();
+    }
+  }
+
+  /**
+   * Delete a saved object or splayed table
+   * @param {string} name
+   * @returns {Promise<boolean>} false if nothing was saved under `name`
+   */
+  removeSaved(name) {
+    return storageRemove([], storageName(name));
+  }
+
+  /**
+   * Names of all saved objects and splayed tables
+   * @returns {Promise<string[]>}
+   */
+  listSaved() {
+    return storageList([]);
+  }
+
+  // ==========================================================================
+  // Remote IPC
+  // ==========================================================================
+
+  /**
+   * Connect to a native rayforce server over a WebSocket carrying its binary
+   * IPC protocol: a server with a WebSocket listener, or a WebSocket-to-TCP
+   * bridge (e.g. websockify) in front of its IPC port. Results arrive
+   * serialized and are decoded straight into the WASM heap.
+   * @param {string} url - ws:// or wss:// address
+   * @param {Object} [options]
+   * @param {string} [options.auth=''] - 'user:password' sent in the handshake
+   * @param {boolean} [options.handshake=true] - Open with rayforce's handshake
+   * @param {number} [options.timeout=10000] - Connect timeout in ms (0: none)
+   * @param {Function} [options.WebSocket] - WebSocket class (for Node < 22)
+   * @returns {Promise<RemoteConnection>}
+   *
+   * @example
+   * const conn = await rf.connect('ws://db.internal:5100');
+   * const totals = await conn.query('(select {from: trades by: sym total: (sum size)})');
+   */
+  async connect(url, options = {}) {
+    await this.loadFeature('io');
+    const conn = new RemoteConnection(this, options);
+    await conn._open(url, options);
+    return conn;
+  }
 }
 
 // ============================================================================
@@ -612,8 +2438,19 @@ class RayforceSDK {
 class RayObject {
   constructor(sdk, ptr) {
     this._sdk = sdk;
-    this._ptr = ptr;
+    // Shared with the FinalizationRegistry, so it sees pointer updates
+    this._cell = { ptr };
     this._owned = true;
+    this._type = undefined;
+    if (ptr !== 0) sdk._track(this);
+  }
+
+  get _ptr() {
+    return this._cell.ptr;
+  }
+
+  set _ptr(ptr) {
+    this._cell.ptr = ptr;
   }
 
   /**
@@ -629,7 +2466,9 @@ class RayObject {
    * @returns {number}
    */
   get type() {
-    return this._sdk._getObjType(this._ptr);
+    // Type never changes for the object; length can (push/resize)
+    if (this._type === undefined) this._type = this._sdk._getObjType(this._ptr);
+    return this._type;
   }
 
   /**
@@ -718,6 +2557,7 @@ class RayObject {
    */
   drop() {
     if (this._owned && this._ptr !== 0) {
+      this._sdk._untrack(this);
       this._sdk._dropObj(this._ptr);
       this._ptr = 0;
       this._owned = false;
@@ -729,6 +2569,7 @@ class RayObject {
    * @returns {number} The raw pointer
    */
   release() {
+    if (this._owned) this._sdk._untrack(this);
     this._owned = false;
     return this._ptr;
   }
@@ -836,8 +2677,7 @@ class RayDate extends RayObject {
    * Convert to JS Date
    */
   toJS() {
-    const epoch = new Date(2000, 0, 1);
-    return new Date(epoch.getTime() + this.value * 24 * 60 * 60 * 1000);
+    return new Date(RAY_EPOCH_MS + this.value * DAY_MS);
   }
 }
 
@@ -872,8 +2712,7 @@ class RayTimestamp extends RayObject {
   }
   
   toJS() {
-    const epoch = new Date(2000, 0, 1);
-    return new Date(epoch.getTime() + this.value / 1000000);
+    return new Date(RAY_EPOCH_MS + Number(this.value) / 1000000);
   }
 }
 
@@ -891,7 +2730,7 @@ class Symbol extends RayObject {
    * Get symbol string value
    */
   get value() {
-    return this._sdk._symbolToStr(this.id);
+    return this._sdk.symbolString(this.id);
   }
   
   toJS() {
@@ -949,6 +2788,8 @@ class Vector extends RayObject {
     super(sdk, ptr);
     this._elementType = elementType !== undefined ? elementType : sdk._getObjType(ptr);
     this._typedArray = null;
+    this._heapGeneration = -1;
+    this._epochMillis = null;
   }
 
   get elementType() {
@@ -957,20 +2798,24 @@ class Vector extends RayObject {
 
   /**
    * Get zero-copy TypedArray view over the vector data.
-   * WARNING: This view is only valid while the Vector exists.
+   * The view is cached and rebuilt only after the heap has grown, so
+   * re-read this getter after any call that may allocate instead of
+   * holding the returned view across it.
+   * A reachable view keeps its Vector from being garbage collected, but
+   * not from drop()/release() or a scope() ending: the view must not be
+   * used after the Vector is dropped (copy with slice() to keep the data).
    * @returns {TypedArray}
    */
   get typedArray() {
-    if (this._typedArray === null) {
+    if (this._typedArray === null || this._heapGeneration !== this._sdk._heapGeneration) {
       const ArrayType = TYPED_ARRAY_MAP[this._elementType];
       if (!ArrayType) {
         throw new Error(`No TypedArray for type ${this._elementType}`);
       }
       
-      const dataPtr = this._sdk._getDataPtr(this._ptr);
-      const byteSize = this._sdk._getDataByteSize(this._ptr);
-      const elementSize = ELEMENT_SIZES[this._elementType];
-      const length = byteSize / elementSize;
+      const header = this._sdk._header(this._ptr);
+      const dataPtr = header.data;
+      const length = header.length;
       
       // Create view over WASM memory
       this._typedArray = new ArrayType(
@@ -978,6 +2823,8 @@ class Vector extends RayObject {
         dataPtr,
         length
       );
+      VIEW_OWNERS.set(this._typedArray, this);
+      this._heapGeneration = this._sdk._heapGeneration;
     }
     return this._typedArray;
   }
@@ -997,7 +2844,7 @@ class Vector extends RayObject {
     
     // Convert symbol IDs to strings
     if (!raw && this._elementType === Types.SYMBOL) {
-      return this._sdk._symbolToStr(Number(val));
+      return this._sdk.symbolString(val);
     }
     
     // Convert BigInt to Number if safe
@@ -1020,6 +2867,7 @@ class Vector extends RayObject {
       throw new RangeError(`Index ${idx} out of bounds [0, ${this.length})`);
     }
     this.typedArray[idx] = value;
+    this._epochMillis = null;
   }
 
   /**
@@ -1027,16 +2875,16 @@ class Vector extends RayObject {
    * @returns {Array}
    */
   toJS() {
+    if (this._elementType === Types.SYMBOL) {
+      return this._sdk.resolveSymbols(this.typedArray);
+    }
+
     const arr = Array.from(this.typedArray);
     
     // Convert BigInt to Number for I64 types if safe
     if (this._elementType === Types.I64 || 
-        this._elementType === Types.TIMESTAMP ||
-        this._elementType === Types.SYMBOL) {
+        this._elementType === Types.TIMESTAMP) {
       return arr.map(v => {
-        if (this._elementType === Types.SYMBOL) {
-          return this._sdk._symbolToStr(Number(v));
-        }
         const n = Number(v);
         return Number.isSafeInteger(n) ? n : v;
       });
@@ -1045,6 +2893,127 @@ class Vector extends RayObject {
     return arr;
   }
 
+  /**
+   * Sum of the non-null elements (native SIMD kernel, no eval round trip).
+   * I64/I32/F64 vectors only; I32 sums widen to I64.
+   * @returns {number|bigint}
+   */
+  sum() {
+    return this._reduce(KERNEL_REDUCE.sum);
+  }
+
+  /**
+   * Mean of the non-null elements, as a float
+   * @returns {number}
+   */
+  avg() {
+    return this._reduce(KERNEL_REDUCE.avg);
+  }
+
+  /**
+   * Smallest non-null element (temporal vectors keep their type)
+   * @returns {any}
+   */
+  min() {
+    return this._reduce(KERNEL_REDUCE.min);
+  }
+
+  /**
+   * Largest non-null element (temporal vectors keep their type)
+   * @returns {any}
+   */
+  max() {
+    return this._reduce(KERNEL_REDUCE.max);
+  }
+
+  /**
+   * Compare every element with `value` into a B8 mask
+   * @param {'eq'|'ne'|'lt'|'le'|'gt'|'ge'} op
+   * @param {number|bigint|RayObject} value - Number, BigInt or a numeric atom
+   * @returns {Vector|RayError} B8 vector of the same length
+   *
+   * @example
+   * const big = prices.filter(prices.compare('gt', 100));
+   */
+  compare(op, value) {
+    const code = KERNEL_COMPARE[op];
+    if (code === undefined) throw new Error(`Unknown comparison '${op}'`);
+    const sdk = this._sdk;
+    const atom = value instanceof RayObject ? value
+      : typeof value === 'bigint' || Number.isInteger(value) ? sdk.i64(value) : sdk.f64(value);
+    try {
+      return sdk._wrapPtr(sdk._kernCompare(this._ptr, code, atom._ptr));
+    } finally {
+      if (atom !== value) atom.drop();
+    }
+  }
+
+  /**
+   * Elements where the B8 `mask` (same length, e.g. from compare()) is set
+   * @param {Vector} mask
+   * @returns {Vector|RayError}
+   */
+  filter(mask) {
+    return this._sdk._wrapPtr(this._sdk._kernCompact(this._ptr, mask._ptr));
+  }
+
+  /**
+   * Whether the elements ascend (nulls first), checked natively in one pass.
+   * Symbols are never reported sorted: their ids are not alphabetical.
+   * @returns {boolean}
+   */
+  isSorted() {
+    return this._sdk._vecIsSorted(this._ptr) === 1;
+  }
+
+  /**
+   * DATE, TIME or TIMESTAMP elements as Unix epoch milliseconds (TIME: ms
+   * since midnight), converted natively in one pass, for charting code
+   * that would otherwise build a Date per element. Nulls are NaN, or the
+   * i64 null with `bigint`. Converted on first use and cached until set()
+   * (write through typedArray and the cache goes stale); every call returns
+   * its own copy, so callers may modify the result.
+   * @param {Object} [options]
+   * @param {boolean} [options.bigint=false] - Whole ms as a BigInt64Array
+   *   (TIMESTAMP rounds down) instead of a Float64Array keeping sub-ms
+   *   digits
+   * @returns {Float64Array|BigInt64Array} JS-owned copy, valid after drop()
+   */
+  asEpochMillis(options = {}) {
+    const bigint = options.bigint === true;
+    const cached = this._epochMillis;
+    if (cached !== null && (cached instanceof BigInt64Array) === bigint) return cached.slice();
+
+    const sdk = this._sdk;
+    const n = this.length;
+    const ArrayType = bigint ? BigInt64Array : Float64Array;
+    const ptr = sdk._malloc(Math.max(n * 8, 1));
+    if (ptr === 0) throw new Error('Out of memory: failed to stage epoch values');
+
+    try {
+      const convert = bigint ? sdk._temporalToMsI64 : sdk._temporalToMsF64;
+      if (Number(convert(this._ptr, ptr)) < 0) {
+        throw new TypeError(`asEpochMillis() needs a DATE, TIME or TIMESTAMP vector, got type ${this._elementType}`);
+      }
+      this._epochMillis = new ArrayType(sdk._wasm.HEAPU8.buffer, ptr, n).slice();
+    } finally {
+      sdk._free(ptr);
+    }
+    return this._epochMillis.slice();
+  }
+
+  _reduce(op) {
+    const result = this._sdk._wrapPtr(this._sdk._kernReduce(this._ptr, op));
+    if (result.isError) {
+      const message = result.message;
+      result.drop();
+      throw new Error(message);
+    }
+    const value = result.toJS();
+    result.drop();
+    return value;
+  }
+
   /**
    * Iterator support
    */
@@ -1109,10 +3078,14 @@ class List extends RayObject {
    */
   set(idx, value) {
     if (idx < 0) idx = this.length + idx;
-    const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
-    this._sdk._wasm.ccall('ins_obj', 'number', 
-      ['number', 'number', 'number'], 
-      [this._ptr, idx, obj._ptr]);
+    const valPtr = this._sdk._handOff(value);
+    // ins_obj takes the list by reference, like push()
+    const stackSave = this._sdk._wasm.stackSave();
+    const ptrPtr = this._sdk._wasm.stackAlloc(this._sdk._ptrSize);
+    this._sdk._setPtrs(ptrPtr, [this._ptr]);
+    this._sdk._vecInsert(ptrPtr, valPtr, idx);
+    this._ptr = this._sdk._getPtr(ptrPtr);
+    this._sdk._wasm.stackRestore(stackSave);
   }
 
   /**
@@ -1120,13 +3093,13 @@ class List extends RayObject {
    * @param {RayObject|any} value
    */
   push(value) {
-    const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
+    const valPtr = this._sdk._handOff(value);
     // Use stack allocation for the pointer-to-pointer
     const stackSave = this._sdk._wasm.stackSave();
-    const ptrPtr = this._sdk._wasm.stackAlloc(4);
-    this._sdk._wasm.setValue(ptrPtr, this._ptr, 'i32');
-    this._sdk._pushObj(ptrPtr, obj._ptr);
-    this._ptr = this._sdk._wasm.getValue(ptrPtr, 'i32');
+    const ptrPtr = this._sdk._wasm.stackAlloc(this._sdk._ptrSize);
+    this._sdk._setPtrs(ptrPtr, [this._ptr]);
+    this._sdk._pushObj(ptrPtr, valPtr);
+    this._ptr = this._sdk._getPtr(ptrPtr);
     this._sdk._wasm.stackRestore(stackSave);
   }
 
@@ -1196,23 +3169,21 @@ class Dict extends RayObject {
    */
   toJS() {
     const result = {};
-    const keys = this.keys();
+    const keys = this.keys().toJS();
     const vals = this.values();
     
     for (let i = 0; i < keys.length; i++) {
-      const keyStr = this._sdk._symbolToStr(Number(keys.at(i)));
-      result[keyStr] = vals.at(i).toJS();
+      result[keys[i]] = vals.at(i).toJS();
     }
     
     return result;
   }
 
   *[globalThis.Symbol.iterator]() {
-    const keys = this.keys();
+    const keys = this.keys().toJS();
     const vals = this.values();
     for (let i = 0; i < keys.length; i++) {
-      const keyStr = this._sdk._symbolToStr(Number(keys.at(i)));
-      yield [keyStr, vals.at(i)];
+      yield [keys[i], vals.at(i)];
     }
   }
 }
@@ -1235,13 +3206,7 @@ class Table extends RayObject {
    * @returns {string[]}
    */
   columnNames() {
-    const cols = this.columns();
-    const names = [];
-    for (let i = 0; i < cols.length; i++) {
-      // at() already converts symbol IDs to strings
-      names.push(cols.at(i));
-    }
-    return names;
+    return this.columns().toJS();
   }
 
   /**
@@ -1312,6 +3277,43 @@ class Table extends RayObject {
     return this._sdk._wrapPtr(newPtr);
   }
 
+  /**
+   * Copy of the table ordered by `column` (stable, ascending, nulls first),
+   * sorted natively. Boolean, numeric and temporal columns only; an index
+   * on the sorted column probes it by binary search.
+   * @param {string} column
+   * @returns {Table|RayError}
+   */
+  sortBy(column) {
+    return this._sdk._wrapPtr(this._sdk._tableSort(this._ptr, column, column.length));
+  }
+
+  /**
+   * Build a native equality index on a SYMBOL, boolean, integer or temporal
+   * column. It follows insert() and upserts to the table they return, and
+   * `where(col.eq(value))` queries on that table probe it instead of
+   * scanning. Drop it when done.
+   * @param {string} column
+   * @returns {TableIndex}
+   *
+   * @example
+   * const bySym = trades.createIndex('sym');
+   * trades.where(rf.col('sym').eq('AAPL')).execute(); // index probe
+   * bySym.groups();                                   // sym -> row positions
+   */
+  createIndex(column) {
+    return new TableIndex(this._sdk, this, column);
+  }
+
+  /**
+   * Open a native append session for streaming rows into this table
+   * (which itself is left unchanged)
+   * @returns {AppendSession}
+   */
+  appender() {
+    return new AppendSession(this._sdk, this);
+  }
+
   /**
    * Convert to JS object with column arrays
    * @returns {Object}
@@ -1334,23 +3336,38 @@ class Table extends RayObject {
    */
   toRows() {
     const names = this.columnNames();
+    const cols = this.toJS();
     const count = this.rowCount;
     const rows = [];
-    
+
+    // Columns are converted once, then transposed
     for (let i = 0; i < count; i++) {
       const row = {};
       for (const name of names) {
-        row[name] = this.col(name).at(i);
-        if (typeof row[name] === 'bigint') {
-          const n = Number(row[name]);
-          row[name] = Number.isSafeInteger(n) ? n : row[name];
-        }
+        row[name] = cols[name][i];
       }
       rows.push(row);
     }
-    
+
     return rows;
   }
+
+  /**
+   * Export as an Apache Arrow IPC stream, built natively in one call.
+   * Symbol columns are dictionary-encoded; pass the result to
+   * apache-arrow's `tableFromIPC` for a columnar copy without per-element
+   * conversion.
+   * @returns {Uint8Array}
+   */
+  toArrow() {
+    const buf = this._sdk._wrapPtr(this._sdk._exportArrow(this._ptr));
+    try {
+      if (buf.isError) throw new Error(buf.message);
+      return buf.typedArray.slice();
+    } finally {
+      buf.drop();
+    }
+  }
 }
 
 // ============================================================================
@@ -1359,20 +3376,491 @@ class Table extends RayObject {
 
 class Lambda extends RayObject {
   /**
-   * Call the lambda with arguments
+   * Call the lambda with arguments. Arguments go to the evaluator by
+   * pointer (strings as symbols), nothing is formatted or re-parsed.
    * @param {...any} args
    * @returns {RayObject}
    */
   call(...args) {
-    // Build call expression
-    const argList = args.map(a => {
-      if (a instanceof RayObject) return a.toString();
-      if (typeof a === 'string') return `\`${a}`;
-      return String(a);
-    }).join(' ');
-    
-    const expr = `(${this.toString()} ${argList})`;
-    return this._sdk.eval(expr);
+    const plan = this.plan(...args);
+    try {
+      return this._sdk.evalPlan(plan);
+    } finally {
+      plan.drop();
+    }
+  }
+
+  /**
+   * Build the call as a plan for repeated sdk.evalPlan()
+   * @param {...any} args
+   * @returns {List}
+   */
+  plan(...args) {
+    const p = new PlanBuilder(this._sdk).push(this);
+    for (const a of args) p.literal(a);
+    return p.call(args.length + 1).build();
+  }
+}
+
+// ============================================================================
+// Prepared Query
+// ============================================================================
+
+/**
+ * Code parsed once into a native lambda; execute() binds arguments by
+ * pointer and evaluates without parsing
+ */
+class PreparedQuery {
+  constructor(sdk, fn, params) {
+    this._sdk = sdk;
+    this._fn = fn;
+    this.params = params;
+  }
+
+  /**
+   * Evaluate with parameter values (strings are passed as symbols)
+   * @param {Object|Array} [values] - By name, or positional
+   * @returns {RayObject}
+   */
+  execute(values = {}) {
+    const args = Array.isArray(values) ? values : this.params.map(p => {
+      if (!(p in values)) throw new Error(`Missing parameter: ${p}`);
+      return values[p];
+    });
+    if (args.length !== this.params.length) {
+      throw new Error(`Expected ${this.params.length} parameters, got ${args.length}`);
+    }
+    return this._fn.call(...args);
+  }
+
+  /**
+   * Release the compiled lambda (the native cache keeps its own reference)
+   */
+  drop() {
+    this._fn.drop();
+  }
+}
+
+// ============================================================================
+// Append Session
+// ============================================================================
+
+/**
+ * Native append buffer bound to a table (Table.appender()). Row batches of
+ * packed columns are copied into spare column capacity in one call; queries
+ * see them only once flush() publishes a snapshot.
+ */
+class AppendSession {
+  constructor(sdk, table) {
+    const session = sdk._appendBegin(table._ptr);
+    if (session === 0) {
+      throw new Error('Append sessions need fixed-width or symbol columns');
+    }
+
+    this._sdk = sdk;
+    this._session = session;
+    this._names = table.columnNames();
+    this._types = sdk.scope(() => {
+      const vals = table.values();
+      return this._names.map((_, i) => vals.at(i).type);
+    });
+    this._staging = 0;
+    this._stagingSize = 0;
+    this._views = new Set();
+    this.pending = 0;
+  }
+
+  /**
+   * Append a batch of rows. Numeric columns are TypedArrays of the column's
+   * own kind (Float64Array for F64, Int32Array for DATE, BigInt64Array for
+   * TIMESTAMP...) or plain arrays; symbol columns are
+   * string arrays or packed { bytes, offsets }; GUID columns Uint8Array of
+   * 16 bytes per row.
+   * @param {Object|Array} batch - Columns by name, or in column order
+   * @returns {number} Rows pending since the last flush
+   */
+  append(batch) {
+    if (this._session === 0) throw new Error('Append session is closed');
+
+    const cols = Array.isArray(batch) ? batch : this._names.map(name => {
+      if (!(name in batch)) throw new Error(`Missing column: ${name}`);
+      return batch[name];
+    });
+    if (cols.length !== this._names.length) {
+      throw new Error(`Expected ${this._names.length} columns, got ${cols.length}`);
+    }
+
+    const parts = cols.map((col, i) => this._encode(col, i));
+    const n = parts.length > 0 ? parts[0].rows : 0;
+    for (let i = 1; i < parts.length; i++) {
+      if (parts[i].rows !== n) throw new Error(`Column ${this._names[i]} has ${parts[i].rows} rows, expected ${n}`);
+    }
+
+    // Staging layout: data pointers, offset pointers, then 8-aligned buffers
+    const ncols = parts.length;
+    const width = this._sdk._ptrSize;
+    let size = ncols * 2 * width;
+    for (const p of parts) {
+      size = align8(size) + p.bytes.byteLength;
+      if (p.offsets) size = align8(size) + p.offsets.byteLength;
+    }
+    const base = this._reserve(size);
+
+    const w = this._sdk._wasm;
+    const datas = new Array(ncols).fill(0);
+    const offs = new Array(ncols).fill(0);
+    let pos = ncols * 2 * width;
+    for (let i = 0; i < ncols; i++) {
+      const { bytes, offsets } = parts[i];
+      pos = align8(pos);
+      w.HEAPU8.set(bytes, base + pos);
+      datas[i] = base + pos;
+      pos += bytes.byteLength;
+      if (offsets) {
+        pos = align8(pos);
+        w.HEAPU8.set(new Uint8Array(offsets.buffer, offsets.byteOffset, offsets.byteLength), base + pos);
+        offs[i] = base + pos;
+        pos += offsets.byteLength;
+      }
+    }
+    this._sdk._setPtrs(base, datas);
+    this._sdk._setPtrs(base + ncols * width, offs);
+
+    const pending = Number(this._sdk._appendRows(this._session, base, base + ncols * width, n));
+    if (pending < 0) {
+      const err = this._sdk._wrapPtr(this._sdk._appendFlush(this._session));
+      const message = err.message;
+      err.drop();
+      throw new Error(message);
+    }
+    this.pending = pending;
+    return pending;
+  }
+
+  /**
+   * Publish pending rows and refresh views following this session. Drop
+   * the previous snapshot before flushing: while it is alive the session
+   * has to copy the table to keep it unchanged.
+   * @returns {Table} Snapshot including every appended row
+   */
+  flush() {
+    if (this._session === 0) throw new Error('Append session is closed');
+    this.pending = 0;
+    return this._publish(this._sdk._wrapPtr(this._sdk._appendFlush(this._session)));
+  }
+
+  /**
+   * Flush and release the session
+   * @returns {Table} The final table
+   */
+  close() {
+    if (this._session === 0) throw new Error('Append session is closed');
+    const ptr = this._sdk._appendEnd(this._session);
+    this._session = 0;
+    this.pending = 0;
+    if (this._staging !== 0) this._sdk._free(this._staging);
+    this._staging = 0;
+    try {
+      return this._publish(this._sdk._wrapPtr(ptr));
+    } finally {
+      for (const view of this._views) view._session = null;
+      this._views.clear();
+    }
+  }
+
+  _publish(table) {
+    if (table.isError) return table;
+    try {
+      for (const view of this._views) view.refresh(table);
+    } catch (error) {
+      // The caller never gets the snapshot to drop
+      table.drop();
+      throw error;
+    }
+    return table;
+  }
+
+  /**
+   * Bytes (and row count) of one batch column in the native layout
+   */
+  _encode(col, i) {
+    const type = this._types[i];
+    const name = this._names[i];
+
+    if (type === Types.SYMBOL) {
+      const packed = isPackedStrings(col) ? col : Array.isArray(col) ? packStrings(col) : null;
+      if (packed === null) throw new Error(`Column ${name}: expected strings or { bytes, offsets }`);
+      return { bytes: packed.bytes, offsets: Int32Array.from(packed.offsets), rows: packed.offsets.length - 1 };
+    }
+
+    if (type === Types.GUID) {
+      if (!(col instanceof Uint8Array)) throw new Error(`Column ${name}: expected a Uint8Array of 16-byte GUIDs`);
+      return { bytes: col, rows: col.length / 16 };
+    }
+
+    const Ctor = TYPED_ARRAY_MAP[type];
+    let view = col;
+    if (Array.isArray(col)) {
+      if (Ctor === BigInt64Array) view = BigInt64Array.from(col, v => BigInt(v));
+      else if (type === Types.B8) view = Int8Array.from(col, v => (v ? 1 : 0));
+      else view = Ctor.from(col);
+    } else if (!(col instanceof Ctor)) {
+      // Same-width arrays of another kind (Float64Array for I64) would be
+      // reinterpreted bit for bit
+      throw new Error(`Column ${name}: expected ${Ctor.name} or an array`);
+    }
+
+    return { bytes: new Uint8Array(view.buffer, view.byteOffset, view.byteLength), rows: view.length };
+  }
+
+  /**
+   * Staging buffer of at least `size` bytes, grown geometrically
+   * @returns {number} Heap address
+   */
+  _reserve(size) {
+    if (size > this._stagingSize) {
+      if (this._staging !== 0) this._sdk._free(this._staging);
+      this._stagingSize = Math.max(size, this._stagingSize * 2, 65536);
+      this._staging = this._sdk._malloc(this._stagingSize);
+      if (this._staging === 0) {
+        this._stagingSize = 0;
+        throw new Error('Out of memory: failed to stage append batch');
+      }
+    }
+    return this._staging;
+  }
+}
+
+function align8(n) {
+  return (n + 7) & ~7;
+}
+
+// ============================================================================
+// Materialized View
+// ============================================================================
+
+// Aggregate opcodes of the native mview_* exports, by Expr aggregation
+const MVIEW_OPS = { sum: 0, avg: 1, min: 2, max: 3, count: 4, first: 5, last: 6 };
+
+/**
+ * Group-by aggregation kept up to date incrementally (sdk.materialize).
+ * refresh() folds only rows appended since the previous refresh into native
+ * per-group accumulators; read() builds the result from them in O(groups).
+ */
+class MaterializedView {
+  constructor(sdk, query) {
+    const table = query._table;
+    if (!(table instanceof Table)) throw new Error('Materialized views need a query over a table');
+    if (!query._byCols || query._byCols.length === 0) {
+      throw new Error('Materialized views need groupBy() columns');
+    }
+    if (query._whereCond) throw new Error('Materialized views do not support where()');
+
+    const columns = table.columnNames();
+    const position = (name) => {
+      const i = columns.indexOf(name);
+      if (i === -1) throw new Error(`Unknown column '${name}'`);
+      return i;
+    };
+
+    for (const col of query._selectCols || []) {
+      if (!query._byCols.includes(col)) {
+        throw new Error(`Selected column '${col}' must be a groupBy() key or an aggregate`);
+      }
+    }
+
+    const keys = query._byCols.map(position);
+    const aggs = [];
+    const names = [...query._byCols];
+    for (const [name, expr] of Object.entries(query._computedCols)) {
+      const op = MVIEW_OPS[expr._op];
+      const arg = expr._args[0];
+      if (op === undefined || !(arg instanceof Expr) || arg._op !== null) {
+        throw new Error(`Column '${name}': expected sum/avg/min/max/count/first/last of a column`);
+      }
+      aggs.push(op, position(arg._args[0]));
+      names.push(name);
+    }
+    if (aggs.length === 0) throw new Error('Materialized views need an aggregate (withColumn)');
+
+    const w = sdk._wasm;
+    const keysPtr = sdk._malloc(keys.length * 4);
+    const aggsPtr = sdk._malloc(aggs.length * 4);
+    try {
+      w.HEAP32.set(keys, keysPtr / 4);
+      w.HEAP32.set(aggs, aggsPtr / 4);
+      this._view = sdk._mviewNew(table._ptr, keysPtr, keys.length, aggsPtr, aggs.length / 2);
+    } finally {
+      sdk._free(aggsPtr);
+      sdk._free(keysPtr);
+    }
+    if (this._view === 0) {
+      throw new Error('Unsupported view: sum/avg need numeric columns, min/max non-symbol ones');
+    }
+
+    this._sdk = sdk;
+    this._session = null;
+    this._names = sdk._unscoped(() => {
+      const vec = sdk.vector(Types.SYMBOL, names.length);
+      vec.typedArray.set(sdk.internSymbols(names));
+      return vec;
+    });
+    this.refresh(table);
+  }
+
+  /**
+   * Fold in the rows of `table` not seen yet. `table` must be the source
+   * table or a later snapshot of it (AppendSession.flush()).
+   * @param {Table} table
+   * @returns {MaterializedView}
+   */
+  refresh(table) {
+    if (this._view === 0) throw new Error('Materialized view is dropped');
+    const groups = Number(this._sdk._mviewUpdate(this._view, table._ptr));
+    if (groups === -2) throw new Error('Interrupted');
+    if (groups < 0) throw new Error('Table does not extend the materialized view source');
+    return this;
+  }
+
+  /**
+   * Current result: the groupBy() keys, then one column per aggregate
+   * @returns {Table}
+   */
+  read() {
+    if (this._view === 0) throw new Error('Materialized view is dropped');
+    return this._sdk._wrapPtr(this._sdk._mviewRead(this._view, this._names._ptr));
+  }
+
+  /**
+   * Release the accumulators and stop following an append session
+   */
+  drop() {
+    if (this._view === 0) return;
+    if (this._session !== null) this._session._views.delete(this);
+    this._sdk._mviewFree(this._view);
+    this._names.drop();
+    this._view = 0;
+  }
+}
+
+// ============================================================================
+// Table Index
+// ============================================================================
+
+/**
+ * Native equality index on one column (Table.createIndex). Ascending
+ * columns are probed by binary search, others through a hash of their
+ * values whose row chains are also the column's groups. Inserts and
+ * upserts move the index to the table they return. Changes made through
+ * eval(), Vector.set() or a column's typedArray are not seen: call
+ * rebuild() after writing to an indexed column in place. An index that is
+ * garbage collected without drop() is freed by a FinalizationRegistry.
+ */
+class TableIndex {
+  constructor(sdk, table, column) {
+    const col = table.col(column);
+    const type = col.isError ? null : col.elementType;
+    col.drop();
+
+    this._sdk = sdk;
+    this._column = column;
+    this._type = type;
+    this._handle = type === null ? 0 : sdk._indexNew(table._ptr, column, column.length);
+    if (this._handle === 0) {
+      throw new TypeError(`Column '${column}' cannot be indexed: expected a SYMBOL, boolean, integer or temporal column`);
+    }
+    this._ref = typeof WeakRef === 'function' ? new WeakRef(this) : { deref: () => this };
+    sdk._indexes.add(this._ref);
+    if (sdk._indexRegistry !== null) {
+      sdk._indexRegistry.register(this, { handle: this._handle, ref: this._ref }, this);
+    }
+  }
+
+  get column() {
+    return this._column;
+  }
+
+  /**
+   * 'sorted' (binary search), 'hash', or null once the column left the table
+   * @returns {'sorted'|'hash'|null}
+   */
+  get kind() {
+    this._check();
+    const kind = this._sdk._indexKind(this._handle);
+    return kind === 1 ? 'sorted' : kind === 2 ? 'hash' : null;
+  }
+
+  /**
+   * Positions of the rows equal to `value`, ascending
+   * @param {string|number|bigint|boolean} value - Strings for SYMBOL columns
+   * @returns {Vector} I64 vector
+   */
+  rows(value) {
+    return this._sdk._wrapPtr(this._sdk._indexRows(this._handle, this._probeKey(value)));
+  }
+
+  /**
+   * Rebuild from the column's current values, after in-place writes
+   * (Vector.set(), typedArray) the index cannot see
+   * @returns {TableIndex} this
+   */
+  rebuild() {
+    this._check();
+    this._sdk._indexRebuild(this._handle);
+    return this;
+  }
+
+  /**
+   * Rows equal to `value` as a table
+   * @param {string|number|bigint|boolean} value
+   * @returns {Table}
+   */
+  where(value) {
+    return this._sdk._wrapPtr(this._sdk._indexWhere(this._handle, this._probeKey(value)));
+  }
+
+  /**
+   * Distinct values (first-seen order, ascending for sorted columns) to I64
+   * vectors of their row positions, without a group-by scan
+   * @returns {Dict}
+   */
+  groups() {
+    this._check();
+    return this._sdk._wrapPtr(this._sdk._indexGroups(this._handle));
+  }
+
+  /**
+   * Free the index and stop maintaining it
+   */
+  drop() {
+    if (this._handle === 0) return;
+    const sdk = this._sdk;
+    sdk._indexes.delete(this._ref);
+    if (sdk._indexRegistry !== null) sdk._indexRegistry.unregister(this);
+    sdk._indexFree(this._handle);
+    this._handle = 0;
+  }
+
+  _check() {
+    if (this._handle === 0) throw new Error('Index is dropped');
+  }
+
+  _probeKey(value) {
+    this._check();
+    const key = this._key(value);
+    if (key === null) throw new TypeError(`Cannot look up ${typeof value} in column '${this._column}'`);
+    return this._sdk._stageIndexKey(key);
+  }
+
+  // Widened i64 key of `value` as a BigInt, or null when it cannot match
+  // the column exactly (Numbers past 2^53, BigInts past 64 bits)
+  _key(value) {
+    if (this._type === Types.SYMBOL) {
+      return typeof value === 'string' ? this._sdk.internSymbols([value])[0] : null;
+    }
+    if (typeof value === 'boolean') return BigInt(value ? 1 : 0);
+    if (typeof value === 'bigint') return BigInt.asIntN(64, value) === value ? value : null;
+    return Number.isSafeInteger(value) ? BigInt(value) : null;
   }
 }
 
@@ -1384,9 +3872,15 @@ class Lambda extends RayObject {
  * Expression builder for query conditions
  */
 class Expr {
-  constructor(sdk, parts) {
+  /**
+   * @param {RayforceSDK} sdk
+   * @param {string|null} op - Function name, or null for a column reference
+   * @param {Array} args - Operand Exprs and literal values (column name for references)
+   */
+  constructor(sdk, op, args) {
     this._sdk = sdk;
-    this._parts = parts;
+    this._op = op;
+    this._args = args;
   }
 
   /**
@@ -1395,7 +3889,7 @@ class Expr {
    * @returns {Expr}
    */
   static col(sdk, name) {
-    return new Expr(sdk, [`\`${name}`]);
+    return new Expr(sdk, null, [name]);
   }
 
   // Comparison operators
@@ -1409,25 +3903,47 @@ class Expr {
   // Logical operators
   and(other) { return this._logicOp('and', other); }
   or(other) { return this._logicOp('or', other); }
-  not() { return new Expr(this._sdk, ['(not', ...this._parts, ')']); }
+  not() { return this._unOp('not'); }
   
   // Aggregations
-  sum() { return new Expr(this._sdk, ['(sum', ...this._parts, ')']); }
-  avg() { return new Expr(this._sdk, ['(avg', ...this._parts, ')']); }
-  min() { return new Expr(this._sdk, ['(min', ...this._parts, ')']); }
-  max() { return new Expr(this._sdk, ['(max', ...this._parts, ')']); }
-  count() { return new Expr(this._sdk, ['(count', ...this._parts, ')']); }
-  first() { return new Expr(this._sdk, ['(first', ...this._parts, ')']); }
-  last() { return new Expr(this._sdk, ['(last', ...this._parts, ')']); }
-  distinct() { return new Expr(this._sdk, ['(distinct', ...this._parts, ')']); }
+  sum() { return this._unOp('sum'); }
+  avg() { return this._unOp('avg'); }
+  min() { return this._unOp('min'); }
+  max() { return this._unOp('max'); }
+  count() { return this._unOp('count'); }
+  first() { return this._unOp('first'); }
+  last() { return this._unOp('last'); }
+  distinct() { return this._unOp('distinct'); }
+  
+  _unOp(op) {
+    return new Expr(this._sdk, op, [this]);
+  }
   
   _binOp(op, value) {
-    const valStr = this._valueToStr(value);
-    return new Expr(this._sdk, [`(${op}`, ...this._parts, valStr, ')']);
+    return new Expr(this._sdk, op, [this, value]);
   }
   
   _logicOp(op, other) {
-    return new Expr(this._sdk, [`(${op}`, ...this._parts, ...other._parts, ')']);
+    return new Expr(this._sdk, op, [this, other]);
+  }
+  
+  /**
+   * Append this expression to a plan: columns as name references, calls
+   * as native lists, literals by handle (strings as string values)
+   * @param {PlanBuilder} plan
+   */
+  _emit(plan) {
+    if (this._op === null) {
+      plan.name(this._args[0]);
+      return;
+    }
+    plan.name(this._op);
+    for (const arg of this._args) {
+      if (arg instanceof Expr) arg._emit(plan);
+      else if (typeof arg === 'string') plan.literal(this._sdk.string(arg), true);
+      else plan.literal(arg);
+    }
+    plan.call(this._args.length + 1);
   }
   
   _valueToStr(value) {
@@ -1441,7 +3957,113 @@ class Expr {
   }
   
   toString() {
-    return this._parts.join(' ');
+    if (this._op === null) return `\`${this._args[0]}`;
+    return `(${[this._op, ...this._args.map(a => this._valueToStr(a))].join(' ')})`;
+  }
+}
+
+/**
+ * Postfix program for the native build_plan export. Leaves are object
+ * handles; call lists and dicts are assembled natively, so plans never go
+ * through formatting and re-parsing.
+ */
+class PlanBuilder {
+  constructor(sdk) {
+    this._sdk = sdk;
+    this._code = [];
+    this._objs = [];
+    this._temps = [];
+  }
+
+  /**
+   * Push an object as-is (evaluates to itself, or as a call if a list)
+   * @param {RayObject} obj
+   * @returns {PlanBuilder}
+   */
+  push(obj) {
+    this._code.push(PLAN_PUSH, this._objs.push(obj) - 1);
+    return this;
+  }
+
+  /**
+   * Push an object as a quoted literal
+   * @param {RayObject} obj
+   * @returns {PlanBuilder}
+   */
+  quote(obj) {
+    this._code.push(PLAN_QUOTE, this._objs.push(obj) - 1);
+    return this;
+  }
+
+  /**
+   * Push a name reference (function, global or column)
+   * @param {string} name
+   * @returns {PlanBuilder}
+   */
+  name(name) {
+    return this.push(this._temp(this._sdk.symbol(name)));
+  }
+
+  /**
+   * Push a value: JS values are converted (strings become symbols); symbols
+   * and lists are quoted so they are not evaluated as names or calls
+   * @param {any} value
+   * @param {boolean} [temp=false] - Drop the RayObject once the plan is built
+   * @returns {PlanBuilder}
+   */
+  literal(value, temp = false) {
+    const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
+    if (temp || obj !== value) this._temp(obj);
+    const type = obj.type;
+    return type === -Types.SYMBOL || type === Types.LIST ? this.quote(obj) : this.push(obj);
+  }
+
+  /**
+   * Pop `n` items (head first) into a call
+   * @param {number} n
+   * @returns {PlanBuilder}
+   */
+  call(n) {
+    this._code.push(PLAN_CALL, n);
+    return this;
+  }
+
+  /**
+   * Pop `n` (name, value) pairs into a dict; push each name with name()
+   * @param {number} n
+   * @returns {PlanBuilder}
+   */
+  dict(n) {
+    this._code.push(PLAN_DICT, n);
+    return this;
+  }
+
+  /**
+   * Assemble the plan natively in one call
+   * @returns {RayObject}
+   */
+  build() {
+    const w = this._sdk._wasm;
+    const code = Int32Array.from(this._code);
+    const codePtr = this._sdk._malloc(code.byteLength);
+    const objsPtr = this._sdk._malloc((this._objs.length || 1) * this._sdk._ptrSize);
+
+    try {
+      w.HEAP32.set(code, codePtr / 4);
+      this._sdk._setPtrs(objsPtr, this._objs.map(o => o._ptr));
+      return this._sdk._wrapPtr(
+        this._sdk._buildPlan(codePtr, code.length / 2, objsPtr, this._objs.length));
+    } finally {
+      this._sdk._free(objsPtr);
+      this._sdk._free(codePtr);
+      for (const obj of this._temps) obj.drop();
+      this._temps.length = 0;
+    }
+  }
+
+  _temp(obj) {
+    this._temps.push(obj);
+    return obj;
   }
 }
 
@@ -1456,6 +4078,8 @@ class SelectQuery {
     this._whereCond = null;
     this._byCols = null;
     this._computedCols = {};
+    this._plan = null;
+    this._keep = false;
   }
 
   /**
@@ -1513,52 +4137,129 @@ class SelectQuery {
   }
 
   /**
-   * Execute the query
+   * Keep the plan built by execute() for later runs. A plan pins its table,
+   * so it stays alive until drop()
+   * @returns {SelectQuery} This query
+   */
+  keep() {
+    this._keep = true;
+    return this;
+  }
+
+  /**
+   * Release the cached plan (and with it the table)
+   */
+  drop() {
+    if (this._plan !== null) {
+      this._plan.drop();
+      this._plan = null;
+    }
+  }
+
+  /**
+   * Execute the query. The plan it builds is dropped afterwards unless the
+   * query is kept (keep()) or the plan was already built by plan()
    * @returns {Table}
    */
   execute() {
-    // Build query dict
-    const query = {};
-    
-    // from clause
-    query.from = this._table._ptr;
+    const probed = this._probeIndex();
+    if (probed !== null) return probed;
+    const transient = this._plan === null && !this._keep;
+    try {
+      return this._sdk._wrapPtr(this._sdk._querySelect(this.plan()._ptr));
+    } finally {
+      if (transient) this.drop();
+    }
+  }
+
+  /**
+   * `where(col.eq(literal))` over a column with a TableIndex: probe the
+   * index, then run the rest of the query over the matching rows only
+   * @returns {Table|RayError|null} null when no index applies
+   */
+  _probeIndex() {
+    const sdk = this._sdk;
+    const cond = this._whereCond;
+    if (sdk._indexes.size === 0 || cond === null || cond._op !== '=' || !(this._table instanceof Table)) {
+      return null;
+    }
+    let [column, value] = cond._args;
+    if (!(column instanceof Expr)) [column, value] = [value, column];
+    if (!(column instanceof Expr) || column._op !== null || value instanceof Expr) return null;
+
+    const index = sdk._indexFor(this._table, column._args[0]);
+    const key = index !== null ? index._key(value) : null;
+    if (key === null) return null;
+
+    const rows = sdk._wrapPtr(sdk._indexWhere(index._handle, sdk._stageIndexKey(key)));
+    if (rows.isError || (this._selectCols === null && this._byCols === null &&
+        Object.keys(this._computedCols).length === 0)) {
+      return rows;
+    }
+
+    const q = this._clone();
+    q._table = rows;
+    q._whereCond = null;
+    try {
+      const plan = q.plan();
+      try {
+        return sdk._wrapPtr(sdk._querySelectUncached(plan._ptr));
+      } finally {
+        plan.drop();
+      }
+    } finally {
+      rows.drop();
+    }
+  }
+
+  /**
+   * Native query dict, built once from handles and cached on this query
+   * until drop(). The table goes in by pointer; expressions as parsed call
+   * lists.
+   * @returns {Dict}
+   */
+  plan() {
+    if (this._plan !== null) return this._plan;
+
+    const p = new PlanBuilder(this._sdk);
+    let entries = 1;
+    p.name('from').push(this._table);
     
-    // select columns
     if (this._selectCols) {
       for (const col of this._selectCols) {
-        if (typeof col === 'string') {
-          query[col] = col;
-        } else if (col instanceof Expr) {
-          // Need alias for expressions
-        }
+        // Expressions need an alias: use withColumn()
+        if (typeof col !== 'string') continue;
+        p.name(col).name(col);
+        entries++;
       }
     }
     
-    // computed columns
     for (const [name, expr] of Object.entries(this._computedCols)) {
-      query[name] = expr.toString();
+      p.name(name);
+      expr._emit(p);
+      entries++;
     }
     
-    // where clause
     if (this._whereCond) {
-      query.where = this._whereCond.toString();
+      p.name('where');
+      this._whereCond._emit(p);
+      entries++;
     }
     
-    // group by
-    if (this._byCols) {
-      query.by = {};
-      for (const col of this._byCols) {
-        query.by[col] = col;
-      }
+    if (this._byCols && this._byCols.length > 0) {
+      p.name('by');
+      for (const col of this._byCols) p.name(col).name(col);
+      p.dict(this._byCols.length);
+      entries++;
     }
     
-    // Build and execute query
-    const queryDict = this._sdk.dict(query);
-    return this._sdk._wrapPtr(this._sdk._querySelect(queryDict._ptr));
+    // Cached past any scope() the first execute() runs in
+    this._plan = this._sdk._unscoped(() => p.dict(entries).build());
+    return this._plan;
   }
 
   _clone() {
-    const q = new SelectQuery(this._sdk, this._table);
+    const q = new this.constructor(this._sdk, this._table);
     q._selectCols = this._selectCols;
     q._whereCond = this._whereCond;
     q._byCols = this._byCols;
@@ -1567,6 +4268,524 @@ class SelectQuery {
   }
 }
 
+// ============================================================================
+// Splayed Table
+// ============================================================================
+
+// Default column cache budget of a SplayedTable
+const SPLAYED_CACHE_BYTES = 256 * 1024 * 1024;
+
+/**
+ * Table saved with saveSplayed(), paged into the heap one column at a time.
+ * Columns are cached least-recently-used within a byte budget; queries
+ * load only the columns they reference.
+ */
+class SplayedTable {
+  constructor(sdk, path, names, types, rows, maxBytes = SPLAYED_CACHE_BYTES) {
+    this._sdk = sdk;
+    this._path = path;
+    this._names = names;
+    this._types = types;
+    this._rows = rows;
+    this._maxBytes = maxBytes;
+    this._cache = new Map(); // name -> { vec, bytes }, in LRU order
+    this._loading = new Map(); // name -> Promise<Vector> of reads in flight
+    this._bytes = 0;
+    this._syms = null;
+    this._symsLoading = null;
+  }
+
+  /**
+   * Column names, without loading anything
+   * @returns {string[]}
+   */
+  columnNames() {
+    return this._names.slice();
+  }
+
+  /**
+   * Column types by name, without loading anything
+   * @returns {Object<string, number>}
+   */
+  schema() {
+    const result = {};
+    this._names.forEach((name, i) => { result[name] = this._types[i]; });
+    return result;
+  }
+
+  /** @returns {number} */
+  get rowCount() {
+    return this._rows;
+  }
+
+  /**
+   * Bytes of column data currently paged in
+   * @returns {number}
+   */
+  get cachedBytes() {
+    return this._bytes;
+  }
+
+  /**
+   * Load one column (or take it from the cache)
+   * @param {string} name
+   * @returns {Promise<Vector>} Caller-owned reference
+   */
+  async col(name) {
+    const vec = await this._column(name, new Set([name]));
+    return vec.clone();
+  }
+
+  /**
+   * Native table over the given columns (all by default), loading only those
+   * @param {...string} names
+   * @returns {Promise<Table>}
+   */
+  async table(...names) {
+    if (names.length === 0) names = this._names;
+    const pinned = new Set(names);
+    const cols = [];
+    for (const name of names) cols.push(await this._column(name, pinned));
+
+    const sdk = this._sdk;
+    return sdk._unscoped(() => {
+      const keys = sdk.vector(Types.SYMBOL, names.length);
+      keys.typedArray.set(sdk.internSymbols(names));
+      const vals = sdk.list();
+      for (const col of cols) vals.push(col);
+      return new Table(sdk, sdk._initTable(keys.release(), vals.release()));
+    });
+  }
+
+  /**
+   * Create a select query; execute() is async and pages in only the
+   * columns the query references
+   * @param {...string} cols
+   * @returns {SplayedQuery}
+   */
+  select(...cols) {
+    return new SplayedQuery(this._sdk, this).select(...cols);
+  }
+
+  /**
+   * Create a filtered query
+   * @param {Expr} condition
+   * @returns {SplayedQuery}
+   */
+  where(condition) {
+    return new SplayedQuery(this._sdk, this).where(condition);
+  }
+
+  /**
+   * Drop cached columns: one by name, or all of them
+   * @param {string} [name]
+   */
+  evict(name) {
+    for (const [key, entry] of [...this._cache]) {
+      if (name !== undefined && key !== name) continue;
+      entry.vec.drop();
+      this._bytes -= entry.bytes;
+      this._cache.delete(key);
+    }
+  }
+
+  /**
+   * Release every cached column and the symbol file
+   */
+  drop() {
+    this.evict();
+    if (this._syms !== null) {
+      this._syms.drop();
+      this._syms = null;
+    }
+  }
+
+  /**
+   * Cached column, loaded on a miss. Columns in `pinned` are never evicted
+   * to make room, so a query's own columns stay resident while it runs.
+   * Concurrent misses on one column share a single read.
+   */
+  async _column(name, pinned) {
+    const i = this._names.indexOf(name);
+    if (i === -1) throw new Error(`Unknown column '${name}'`);
+
+    const hit = this._cache.get(name);
+    if (hit !== undefined) {
+      this._cache.delete(name);
+      this._cache.set(name, hit);
+      return hit.vec;
+    }
+
+    let loading = this._loading.get(name);
+    if (loading === undefined) {
+      loading = this._load(name, i, pinned).finally(() => this._loading.delete(name));
+      this._loading.set(name, loading);
+    }
+    return loading;
+  }
+
+  async _load(name, i, pinned) {
+    let vec = await this._read(splayFile(name), pinned);
+    if (this._types[i] === Types.SYMBOL) {
+      const syms = await this._symbols(pinned);
+      const idx = vec;
+      vec = this._sdk._unscoped(() => this._sdk._wrapPtr(this._sdk._splayUnenum(idx._ptr, syms._ptr)));
+      idx.drop();
+      if (vec.isError) {
+        const message = vec.message;
+        vec.drop();
+        throw new Error(message);
+      }
+    }
+
+    const bytes = this._sdk._getDataByteSize(vec._ptr);
+    this._cache.set(name, { vec, bytes });
+    this._bytes += bytes;
+    this._shrink(pinned);
+    return vec;
+  }
+
+  async _symbols(pinned) {
+    if (this._syms !== null) return this._syms;
+    if (this._symsLoading === null) {
+      this._symsLoading = this._read('.sym', pinned)
+        .then((syms) => { this._syms = syms; return syms; })
+        .finally(() => { this._symsLoading = null; });
+    }
+    return this._symsLoading;
+  }
+
+  /**
+   * Read one file of the table; if decoding fails (e.g. the heap is
+   * exhausted), evict unpinned columns and retry once
+   */
+  async _read(file, pinned) {
+    for (let attempt = 0; ; attempt++) {
+      const obj = await this._sdk._readObject(this._path, file);
+      if (obj === null) throw new Error(`Splayed table '${this._path[0]}' is missing '${file}'`);
+      if (!obj.isError) return obj;
+
+      const message = obj.message;
+      obj.drop();
+      if (attempt > 0 || this._bytes === 0) throw new Error(message);
+      this._shrink(pinned, 0);
+    }
+  }
+
+  /**
+   * Evict least recently used, unpinned columns down to `limit` bytes
+   */
+  _shrink(pinned, limit = this._maxBytes) {
+    for (const [key, entry] of [...this._cache]) {
+      if (this._bytes <= limit) return;
+      if (pinned.has(key)) continue;
+      entry.vec.drop();
+      this._bytes -= entry.bytes;
+      this._cache.delete(key);
+    }
+  }
+}
+
+/**
+ * SELECT over a SplayedTable. The referenced columns are paged in and the
+ * query runs over a native table of just those columns.
+ */
+class SplayedQuery extends SelectQuery {
+  /**
+   * Execute the query
+   * @returns {Promise<Table>}
+   */
+  async execute() {
+    const splayed = this._table;
+    const table = await splayed.table(...this.columnsUsed());
+    const q = this._clone();
+    q._table = table;
+
+    try {
+      const plan = q.plan();
+      try {
+        return this._sdk._wrapPtr(this._sdk._querySelectUncached(plan._ptr));
+      } finally {
+        plan.drop();
+      }
+    } finally {
+      table.drop();
+    }
+  }
+
+  /**
+   * Columns of the splayed table the query reads: all of them for a bare
+   * select, otherwise those named in select, computed columns, where and by
+   * @returns {string[]}
+   */
+  columnsUsed() {
+    const all = this._table.columnNames();
+    if (this._selectCols === null && Object.keys(this._computedCols).length === 0) return all;
+
+    const used = new Set();
+    const visit = (e) => {
+      if (!(e instanceof Expr)) return;
+      if (e._op === null) used.add(e._args[0]);
+      else e._args.forEach(visit);
+    };
+
+    for (const col of this._selectCols || []) {
+      if (typeof col === 'string') used.add(col);
+      else visit(col);
+    }
+    Object.values(this._computedCols).forEach(visit);
+    visit(this._whereCond);
+    for (const col of this._byCols || []) used.add(col);
+
+    return all.filter(name => used.has(name));
+  }
+
+  plan() {
+    if (!(this._table instanceof RayObject)) {
+      throw new Error('Splayed queries are planned on execute()');
+    }
+    return super.plan();
+  }
+}
+
+// ============================================================================
+// Remote IPC Connection
+// ============================================================================
+
+/**
+ * Connection to a native rayforce server (sdk.connect). Outgoing messages
+ * are ipc_encode buffers sent as binary frames. Incoming bytes are framed by
+ * their IPC header and copied into a U8 vector on the WASM heap, which
+ * de_obj then decodes in place. Frame boundaries carry no meaning, so
+ * bridges that split or coalesce the TCP stream work as well.
+ */
+class RemoteConnection {
+  constructor(sdk, options) {
+    this._sdk = sdk;
+    this._socket = null;
+    this._pending = [];
+    this._opening = null;
+    this._awaitHello = options.handshake !== false;
+    this._headerSize = sdk._ipcHeaderSize();
+    this._header = new Uint8Array(this._headerSize);
+    this._headerFill = 0;
+    this._scratch = 0;
+    this._message = null;
+    this._messageType = 0;
+    this._messageFill = 0;
+    this.bytesSent = 0;
+    this.bytesReceived = 0;
+    /**
+     * Server-initiated messages: (obj, sync) => reply. The handler owns obj;
+     * for sync messages the returned RayObject (or null) is sent back.
+     * @type {Function|null}
+     */
+    this.onmessage = null;
+    /** @type {Function|null} */
+    this.onclose = null;
+  }
+
+  /**
+   * Whether the socket is open and the handshake is done
+   * @returns {boolean}
+   */
+  get connected() {
+    return this._socket !== null && this._opening === null && this._socket.readyState === 1;
+  }
+
+  /**
+   * Evaluate on the server and wait for the result. Replies come back in
+   * request order.
+   * @param {string|RayObject} expr - Rayfall source, or any object the
+   *   server evaluates (e.g. a list of a function name and arguments)
+   * @returns {Promise<RayObject>} The result (a RayError on server errors)
+   */
+  query(expr) {
+    return new Promise((resolve, reject) => {
+      this._send(expr, IPC_MSG.SYNC);
+      this._pending.push({ resolve, reject });
+    });
+  }
+
+  /**
+   * Send without waiting for a result
+   * @param {string|RayObject} expr
+   */
+  send(expr) {
+    this._send(expr, IPC_MSG.ASYNC);
+  }
+
+  /**
+   * Close the connection; unanswered queries reject
+   */
+  close() {
+    if (this._socket !== null) this._socket.close();
+  }
+
+  _open(url, options) {
+    const Socket = options.WebSocket || globalThis.WebSocket;
+    if (typeof Socket !== 'function') {
+      throw new Error('No WebSocket implementation: pass options.WebSocket');
+    }
+    const timeout = options.timeout ?? 10000;
+
+    return new Promise((resolve, reject) => {
+      this._scratch = this._sdk._malloc(this._headerSize);
+      const socket = new Socket(url);
+      let timer = 0;
+
+      this._opening = {
+        resolve: () => {
+          clearTimeout(timer);
+          this._opening = null;
+          resolve();
+        },
+        reject: (message) => {
+          clearTimeout(timer);
+          this._opening = null;
+          reject(new Error(message));
+          if (this._socket !== null) socket.close();
+        },
+      };
+      if (timeout > 0) {
+        timer = setTimeout(() => this._opening.reject(`Connection to ${url} timed out`), timeout);
+      }
+
+      socket.binaryType = 'arraybuffer';
+      socket.onopen = () => {
+        if (!this._awaitHello) {
+          this._opening.resolve();
+          return;
+        }
+        // Handshake: credentials, our version byte and a terminating zero;
+        // the server answers with its version byte
+        const auth = new TextEncoder().encode(options.auth || '');
+        const hello = new Uint8Array(auth.length + 2);
+        hello.set(auth);
+        hello[auth.length] = this._sdk._ipcVersion();
+        socket.send(hello);
+      };
+      socket.onmessage = (event) => this._receive(new Uint8Array(event.data));
+      socket.onerror = () => {
+        if (this._opening !== null) this._opening.reject(`Cannot connect to ${url}`);
+      };
+      socket.onclose = () => this._closed(url);
+      this._socket = socket;
+    });
+  }
+
+  _send(expr, msgtype) {
+    if (!this.connected) throw new Error('Connection is closed');
+
+    const sdk = this._sdk;
+    const obj = typeof expr === 'string' ? sdk.string(expr) : sdk._toRayObject(expr);
+    const msg = sdk._unscoped(() => sdk._wrapPtr(sdk._ipcEncode(obj._ptr, msgtype)));
+    try {
+      if (msg.isError) throw new Error(msg.message);
+      // A copy: sockets may queue the bytes past this call, and views over
+      // a shared heap cannot be sent at all
+      const bytes = msg.typedArray.slice();
+      this._socket.send(bytes);
+      this.bytesSent += bytes.length;
+    } finally {
+      msg.drop();
+      if (obj !== expr) obj.drop();
+    }
+  }
+
+  _receive(bytes) {
+    let pos = 0;
+    this.bytesReceived += bytes.length;
+
+    if (this._awaitHello && bytes.length > 0) {
+      this._awaitHello = false;
+      pos = 1;
+      if (this._opening !== null) this._opening.resolve();
+    }
+
+    try {
+      while (pos < bytes.length) {
+        if (this._message === null) {
+          const n = Math.min(this._headerSize - this._headerFill, bytes.length - pos);
+          this._header.set(bytes.subarray(pos, pos + n), this._headerFill);
+          this._headerFill += n;
+          pos += n;
+          if (this._headerFill < this._headerSize) return;
+          this._begin();
+        }
+
+        const view = this._message.typedArray;
+        const n = Math.min(view.length - this._messageFill, bytes.length - pos);
+        view.set(bytes.subarray(pos, pos + n), this._messageFill);
+        this._messageFill += n;
+        pos += n;
+        if (this._messageFill === view.length) this._dispatch();
+      }
+    } catch (error) {
+      // Out of sync with the stream: nothing after this can be framed
+      this._fail(error);
+    }
+  }
+
+  // Header complete: allocate the whole message on the heap
+  _begin() {
+    const sdk = this._sdk;
+    sdk._wasm.HEAPU8.set(this._header, this._scratch);
+
+    const len = Number(sdk._ipcMsgLen(this._scratch));
+    if (len < this._headerSize) throw new Error('Malformed rayforce IPC message header');
+
+    this._messageType = sdk._ipcMsgType(this._scratch);
+    this._message = sdk._unscoped(() => sdk.vector(Types.U8, len));
+    this._message.typedArray.set(this._header);
+    this._messageFill = this._headerSize;
+    this._headerFill = 0;
+  }
+
+  _dispatch() {
+    const sdk = this._sdk;
+    const buf = this._message;
+    let obj;
+
+    this._message = null;
+    try {
+      obj = sdk._unscoped(() => sdk._wrapPtr(sdk._deserialize(buf._ptr)));
+    } finally {
+      buf.drop();
+    }
+
+    if (this._messageType === IPC_MSG.RESPONSE) {
+      const pending = this._pending.shift();
+      if (pending !== undefined) pending.resolve(obj);
+      else obj.drop();
+      return;
+    }
+
+    const sync = this._messageType === IPC_MSG.SYNC;
+    let reply = null;
+    if (typeof this.onmessage === 'function') reply = this.onmessage(obj, sync);
+    else obj.drop();
+    if (sync) this._send(reply instanceof RayObject ? reply : null, IPC_MSG.RESPONSE);
+  }
+
+  _fail(error) {
+    for (const pending of this._pending.splice(0)) pending.reject(error);
+    this.close();
+  }
+
+  _closed(url) {
+    if (this._socket === null) return;
+    this._socket = null;
+    if (this._opening !== null) this._opening.reject(`Connection to ${url} closed during handshake`);
+    for (const pending of this._pending.splice(0)) pending.reject(new Error('Connection closed'));
+    if (this._message !== null) this._message.drop();
+    this._message = null;
+    this._sdk._free(this._scratch);
+    this._scratch = 0;
+    if (typeof this.onclose === 'function') this.onclose();
+  }
+}
+
 // ============================================================================
 // Exports
 // ============================================================================
@@ -1580,7 +4799,8 @@ export {
   RayDate, RayTime, RayTimestamp,
   Symbol, GUID,
   Vector, RayString, List, Dict, Table, Lambda,
-  Expr, SelectQuery,
+  Expr, SelectQuery, PlanBuilder, PreparedQuery,
+  SplayedTable, SplayedQuery, AppendSession, MaterializedView, TableIndex, RemoteConnection,
 };
 
 // Default export for UMD/CDN usage
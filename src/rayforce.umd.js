@@ -84,6 +84,46 @@
     [Types.SYMBOL]: BigInt64Array,
   };
 
+  // Zero-copy views to their Vector, so a view held alone keeps the
+  // wrapper (and the native vector) from being finalized
+  const VIEW_OWNERS = new WeakMap();
+
+  // obj_header() scratch struct: i32 type, attrs, rc, flags; i64 len; data ptr
+  const OBJ_HEADER_SIZE = 32;
+  const OBJ_HEADER_ATOM = 1;
+  const OBJ_HEADER_NULL = 4;
+
+  // build_plan() instructions, encoded as (op, arg) i32 pairs
+  const PLAN_PUSH = 0;
+  const PLAN_QUOTE = 1;
+  const PLAN_CALL = 2;
+  const PLAN_DICT = 3;
+
+  const PROFILE_ENTRIES = [
+    'parse', 'eval', 'format', 'evalCmd', 'evalCached', 'evalPlan', 'select', 'update',
+  ];
+  const PROFILE_SLOT_FIELDS = 5;
+
+  const KERNEL_REDUCE = { sum: 0, min: 1, max: 2, avg: 3 };
+  const KERNEL_COMPARE = { eq: 0, ne: 1, lt: 2, le: 3, gt: 4, ge: 5 };
+  // Side modules of the split build (split_features() bits)
+  const SPLIT_FEATURES = { io: 1 };
+  // Message types of rayforce's IPC header
+  const IPC_MSG = { ASYNC: 0, SYNC: 1, RESPONSE: 2 };
+  // Rayforce temporal epoch (2000-01-01 UTC) in Unix ms, and one day in ms
+  const RAY_EPOCH_MS = Date.UTC(2000, 0, 1);
+  const DAY_MS = 86400000;
+
+  // Column type implied by a TypedArray in bulk table construction
+  const BULK_COLUMN_TYPES = new Map([
+    [Int8Array, Types.B8],
+    [Uint8Array, Types.U8],
+    [Int16Array, Types.I16],
+    [Int32Array, Types.I32],
+    [BigInt64Array, Types.I64],
+    [Float64Array, Types.F64],
+  ]);
+
   // ============================================================================
   // RayObject Base Class
   // ============================================================================
@@ -91,12 +131,21 @@
   class RayObject {
     constructor(sdk, ptr) {
       this._sdk = sdk;
-      this._ptr = ptr;
+      // Shared with the FinalizationRegistry, so it sees pointer updates
+      this._cell = { ptr };
       this._owned = true;
+      this._type = undefined;
+      if (ptr !== 0) sdk._track(this);
     }
 
+    get _ptr() { return this._cell.ptr; }
+    set _ptr(ptr) { this._cell.ptr = ptr; }
+
     get ptr() { return this._ptr; }
-    get type() { return this._sdk._getObjType(this._ptr); }
+    get type() {
+      if (this._type === undefined) this._type = this._sdk._getObjType(this._ptr);
+      return this._type;
+    }
     get absType() { const t = this.type; return t < 0 ? -t : t; }
     get isAtom() { return this._sdk._isObjAtom(this._ptr) !== 0; }
     get isVector() { return this._sdk._isObjVector(this._ptr) !== 0; }
@@ -111,6 +160,7 @@
 
     drop() {
       if (this._owned && this._ptr !== 0) {
+        this._sdk._untrack(this);
         this._sdk._dropObj(this._ptr);
         this._ptr = 0;
         this._owned = false;
@@ -118,6 +168,7 @@
     }
 
     release() {
+      if (this._owned) this._sdk._untrack(this);
       this._owned = false;
       return this._ptr;
     }
@@ -164,10 +215,7 @@
 
   class RayDate extends RayObject {
     get value() { return this._sdk._readDate(this._ptr); }
-    toJS() {
-      const epoch = new Date(2000, 0, 1);
-      return new Date(epoch.getTime() + this.value * 24 * 60 * 60 * 1000);
-    }
+    toJS() { return new Date(RAY_EPOCH_MS + this.value * DAY_MS); }
   }
 
   class RayTime extends RayObject {
@@ -185,15 +233,12 @@
 
   class RayTimestamp extends RayObject {
     get value() { return this._sdk._readTimestamp(this._ptr); }
-    toJS() {
-      const epoch = new Date(2000, 0, 1);
-      return new Date(epoch.getTime() + this.value / 1000000);
-    }
+    toJS() { return new Date(RAY_EPOCH_MS + Number(this.value) / 1000000); }
   }
 
   class RaySymbol extends RayObject {
     get id() { return this._sdk._readSymbolId(this._ptr); }
-    get value() { return this._sdk._symbolToStr(this.id); }
+    get value() { return this._sdk.symbolString(this.id); }
     toJS() { return this.value; }
   }
 
@@ -221,21 +266,24 @@
       super(sdk, ptr);
       this._elementType = elementType !== undefined ? elementType : sdk._getObjType(ptr);
       this._typedArray = null;
+      this._heapGeneration = -1;
+      this._epochMillis = null;
     }
 
     get elementType() { return this._elementType; }
 
     get typedArray() {
-      if (this._typedArray === null) {
+      if (this._typedArray === null || this._heapGeneration !== this._sdk._heapGeneration) {
         const ArrayType = TYPED_ARRAY_MAP[this._elementType];
         if (!ArrayType) throw new Error(`No TypedArray for type ${this._elementType}`);
 
-        const dataPtr = this._sdk._getDataPtr(this._ptr);
-        const byteSize = this._sdk._getDataByteSize(this._ptr);
-        const elementSize = ELEMENT_SIZES[this._elementType];
-        const length = byteSize / elementSize;
+        const header = this._sdk._header(this._ptr);
+        const dataPtr = header.data;
+        const length = header.length;
 
         this._typedArray = new ArrayType(this._sdk._wasm.HEAPU8.buffer, dataPtr, length);
+        VIEW_OWNERS.set(this._typedArray, this);
+        this._heapGeneration = this._sdk._heapGeneration;
       }
       return this._typedArray;
     }
@@ -250,13 +298,14 @@
       if (idx < 0) idx = this.length + idx;
       if (idx < 0 || idx >= this.length) throw new RangeError(`Index ${idx} out of bounds`);
       this.typedArray[idx] = value;
+      this._epochMillis = null;
     }
 
     toJS() {
+      if (this._elementType === Types.SYMBOL) return this._sdk.resolveSymbols(this.typedArray);
       const arr = Array.from(this.typedArray);
-      if (this._elementType === Types.I64 || this._elementType === Types.TIMESTAMP || this._elementType === Types.SYMBOL) {
+      if (this._elementType === Types.I64 || this._elementType === Types.TIMESTAMP) {
         return arr.map(v => {
-          if (this._elementType === Types.SYMBOL) return this._sdk._symbolToStr(Number(v));
           const n = Number(v);
           return Number.isSafeInteger(n) ? n : v;
         });
@@ -264,6 +313,64 @@
       return arr;
     }
 
+    // Native SIMD kernels
+    sum() { return this._reduce(KERNEL_REDUCE.sum); }
+    avg() { return this._reduce(KERNEL_REDUCE.avg); }
+    min() { return this._reduce(KERNEL_REDUCE.min); }
+    max() { return this._reduce(KERNEL_REDUCE.max); }
+
+    compare(op, value) {
+      const code = KERNEL_COMPARE[op];
+      if (code === undefined) throw new Error(`Unknown comparison '${op}'`);
+      const sdk = this._sdk;
+      const atom = value instanceof RayObject ? value
+        : typeof value === 'bigint' || Number.isInteger(value) ? sdk.i64(value) : sdk.f64(value);
+      try {
+        return sdk._wrapPtr(sdk._kernCompare(this._ptr, code, atom._ptr));
+      } finally {
+        if (atom !== value) atom.drop();
+      }
+    }
+
+    filter(mask) { return this._sdk._wrapPtr(this._sdk._kernCompact(this._ptr, mask._ptr)); }
+    isSorted() { return this._sdk._vecIsSorted(this._ptr) === 1; }
+
+    // Temporal elements as epoch ms in one native pass, cached until set();
+    // each call returns its own copy
+    asEpochMillis(options = {}) {
+      const bigint = options.bigint === true;
+      const cached = this._epochMillis;
+      if (cached !== null && (cached instanceof BigInt64Array) === bigint) return cached.slice();
+
+      const sdk = this._sdk;
+      const n = this.length;
+      const ArrayType = bigint ? BigInt64Array : Float64Array;
+      const ptr = sdk._malloc(Math.max(n * 8, 1));
+      if (ptr === 0) throw new Error('Out of memory: failed to stage epoch values');
+      try {
+        const convert = bigint ? sdk._temporalToMsI64 : sdk._temporalToMsF64;
+        if (Number(convert(this._ptr, ptr)) < 0) {
+          throw new TypeError(`asEpochMillis() needs a DATE, TIME or TIMESTAMP vector, got type ${this._elementType}`);
+        }
+        this._epochMillis = new ArrayType(sdk._wasm.HEAPU8.buffer, ptr, n).slice();
+      } finally {
+        sdk._free(ptr);
+      }
+      return this._epochMillis.slice();
+    }
+
+    _reduce(op) {
+      const result = this._sdk._wrapPtr(this._sdk._kernReduce(this._ptr, op));
+      if (result.isError) {
+        const message = result.message;
+        result.drop();
+        throw new Error(message);
+      }
+      const value = result.toJS();
+      result.drop();
+      return value;
+    }
+
     *[Symbol.iterator]() {
       const view = this.typedArray;
       for (let i = 0; i < view.length; i++) yield view[i];
@@ -294,17 +401,22 @@
 
     set(idx, value) {
       if (idx < 0) idx = this.length + idx;
-      const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
-      this._sdk._wasm.ccall('ins_obj', 'number', ['number', 'number', 'number'], [this._ptr, idx, obj._ptr]);
+      const valPtr = this._sdk._handOff(value);
+      const stackSave = this._sdk._wasm.stackSave();
+      const ptrPtr = this._sdk._wasm.stackAlloc(this._sdk._ptrSize);
+      this._sdk._setPtrs(ptrPtr, [this._ptr]);
+      this._sdk._vecInsert(ptrPtr, valPtr, idx);
+      this._ptr = this._sdk._getPtr(ptrPtr);
+      this._sdk._wasm.stackRestore(stackSave);
     }
 
     push(value) {
-      const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
+      const valPtr = this._sdk._handOff(value);
       const stackSave = this._sdk._wasm.stackSave();
-      const ptrPtr = this._sdk._wasm.stackAlloc(4);
-      this._sdk._wasm.setValue(ptrPtr, this._ptr, 'i32');
-      this._sdk._pushObj(ptrPtr, obj._ptr);
-      this._ptr = this._sdk._wasm.getValue(ptrPtr, 'i32');
+      const ptrPtr = this._sdk._wasm.stackAlloc(this._sdk._ptrSize);
+      this._sdk._setPtrs(ptrPtr, [this._ptr]);
+      this._sdk._pushObj(ptrPtr, valPtr);
+      this._ptr = this._sdk._getPtr(ptrPtr);
       this._sdk._wasm.stackRestore(stackSave);
     }
 
@@ -336,20 +448,19 @@
 
     toJS() {
       const result = {};
-      const keys = this.keys();
+      const keys = this.keys().toJS();
       const vals = this.values();
       for (let i = 0; i < keys.length; i++) {
-        const keyStr = this._sdk._symbolToStr(Number(keys.at(i)));
-        result[keyStr] = vals.at(i).toJS();
+        result[keys[i]] = vals.at(i).toJS();
       }
       return result;
     }
 
     *[Symbol.iterator]() {
-      const keys = this.keys();
+      const keys = this.keys().toJS();
       const vals = this.values();
       for (let i = 0; i < keys.length; i++) {
-        yield [this._sdk._symbolToStr(Number(keys.at(i))), vals.at(i)];
+        yield [keys[i], vals.at(i)];
       }
     }
   }
@@ -361,14 +472,7 @@
   class Table extends RayObject {
     columns() { return this._sdk._wrapPtr(this._sdk._tableKeys(this._ptr)); }
 
-    columnNames() {
-      const cols = this.columns();
-      const names = [];
-      for (let i = 0; i < cols.length; i++) {
-        names.push(this._sdk._symbolToStr(Number(cols.at(i))));
-      }
-      return names;
-    }
+    columnNames() { return this.columns().toJS(); }
 
     values() { return this._sdk._wrapPtr(this._sdk._tableVals(this._ptr)); }
     col(name) { return this._sdk._wrapPtr(this._sdk._tableCol(this._ptr, name, name.length)); }
@@ -388,6 +492,14 @@
       return this._sdk._wrapPtr(this._sdk._tableInsert(this._ptr, insertData._ptr));
     }
 
+    // Natively sorted copy (boolean/numeric/temporal column, stable ascending)
+    sortBy(column) { return this._sdk._wrapPtr(this._sdk._tableSort(this._ptr, column, column.length)); }
+
+    // Native equality index, followed through insert()/upserts
+    createIndex(column) { return new TableIndex(this._sdk, this, column); }
+
+    appender() { return new AppendSession(this._sdk, this); }
+
     toJS() {
       const result = {};
       const names = this.columnNames();
@@ -400,21 +512,26 @@
 
     toRows() {
       const names = this.columnNames();
+      const cols = this.toJS();
       const count = this.rowCount;
       const rows = [];
       for (let i = 0; i < count; i++) {
         const row = {};
-        for (const name of names) {
-          row[name] = this.col(name).at(i);
-          if (typeof row[name] === 'bigint') {
-            const n = Number(row[name]);
-            row[name] = Number.isSafeInteger(n) ? n : row[name];
-          }
-        }
+        for (const name of names) row[name] = cols[name][i];
         rows.push(row);
       }
       return rows;
     }
+
+    toArrow() {
+      const buf = this._sdk._wrapPtr(this._sdk._exportArrow(this._ptr));
+      try {
+        if (buf.isError) throw new Error(buf.message);
+        return buf.typedArray.slice();
+      } finally {
+        buf.drop();
+      }
+    }
   }
 
   // ============================================================================
@@ -423,12 +540,357 @@
 
   class Lambda extends RayObject {
     call(...args) {
-      const argList = args.map(a => {
-        if (a instanceof RayObject) return a.toString();
-        if (typeof a === 'string') return `\`${a}`;
-        return String(a);
-      }).join(' ');
-      return this._sdk.eval(`(${this.toString()} ${argList})`);
+      const plan = this.plan(...args);
+      try {
+        return this._sdk.evalPlan(plan);
+      } finally {
+        plan.drop();
+      }
+    }
+
+    plan(...args) {
+      const p = new PlanBuilder(this._sdk).push(this);
+      for (const a of args) p.literal(a);
+      return p.call(args.length + 1).build();
+    }
+  }
+
+  // ============================================================================
+  // Prepared Query
+  // ============================================================================
+
+  class PreparedQuery {
+    constructor(sdk, fn, params) {
+      this._sdk = sdk;
+      this._fn = fn;
+      this.params = params;
+    }
+
+    execute(values = {}) {
+      const args = Array.isArray(values) ? values : this.params.map(p => {
+        if (!(p in values)) throw new Error(`Missing parameter: ${p}`);
+        return values[p];
+      });
+      if (args.length !== this.params.length) {
+        throw new Error(`Expected ${this.params.length} parameters, got ${args.length}`);
+      }
+      return this._fn.call(...args);
+    }
+
+    drop() { this._fn.drop(); }
+  }
+
+  // ============================================================================
+  // Append Session
+  // ============================================================================
+
+  // Native append buffer; batches become visible to queries on flush()
+  class AppendSession {
+    constructor(sdk, table) {
+      const session = sdk._appendBegin(table._ptr);
+      if (session === 0) throw new Error('Append sessions need fixed-width or symbol columns');
+      this._sdk = sdk;
+      this._session = session;
+      this._names = table.columnNames();
+      this._types = sdk.scope(() => {
+        const vals = table.values();
+        return this._names.map((_, i) => vals.at(i).type);
+      });
+      this._staging = 0;
+      this._stagingSize = 0;
+      this._views = new Set();
+      this.pending = 0;
+    }
+
+    append(batch) {
+      if (this._session === 0) throw new Error('Append session is closed');
+      const cols = Array.isArray(batch) ? batch : this._names.map(name => {
+        if (!(name in batch)) throw new Error(`Missing column: ${name}`);
+        return batch[name];
+      });
+      if (cols.length !== this._names.length) {
+        throw new Error(`Expected ${this._names.length} columns, got ${cols.length}`);
+      }
+      const parts = cols.map((col, i) => this._encode(col, i));
+      const n = parts.length > 0 ? parts[0].rows : 0;
+      for (let i = 1; i < parts.length; i++) {
+        if (parts[i].rows !== n) throw new Error(`Column ${this._names[i]} has ${parts[i].rows} rows, expected ${n}`);
+      }
+
+      // Data pointers, offset pointers, then 8-aligned buffers
+      const ncols = parts.length;
+      const width = this._sdk._ptrSize;
+      let size = ncols * 2 * width;
+      for (const p of parts) {
+        size = align8(size) + p.bytes.byteLength;
+        if (p.offsets) size = align8(size) + p.offsets.byteLength;
+      }
+      const base = this._reserve(size);
+      const w = this._sdk._wasm;
+      const datas = new Array(ncols).fill(0);
+      const offs = new Array(ncols).fill(0);
+      let pos = ncols * 2 * width;
+      for (let i = 0; i < ncols; i++) {
+        const { bytes, offsets } = parts[i];
+        pos = align8(pos);
+        w.HEAPU8.set(bytes, base + pos);
+        datas[i] = base + pos;
+        pos += bytes.byteLength;
+        if (offsets) {
+          pos = align8(pos);
+          w.HEAPU8.set(new Uint8Array(offsets.buffer, offsets.byteOffset, offsets.byteLength), base + pos);
+          offs[i] = base + pos;
+          pos += offsets.byteLength;
+        }
+      }
+      this._sdk._setPtrs(base, datas);
+      this._sdk._setPtrs(base + ncols * width, offs);
+
+      const pending = Number(this._sdk._appendRows(this._session, base, base + ncols * width, n));
+      if (pending < 0) {
+        const err = this._sdk._wrapPtr(this._sdk._appendFlush(this._session));
+        const message = err.message;
+        err.drop();
+        throw new Error(message);
+      }
+      this.pending = pending;
+      return pending;
+    }
+
+    // Drop the previous snapshot first, or the session copies the table
+    flush() {
+      if (this._session === 0) throw new Error('Append session is closed');
+      this.pending = 0;
+      return this._publish(this._sdk._wrapPtr(this._sdk._appendFlush(this._session)));
+    }
+
+    close() {
+      if (this._session === 0) throw new Error('Append session is closed');
+      const ptr = this._sdk._appendEnd(this._session);
+      this._session = 0;
+      this.pending = 0;
+      if (this._staging !== 0) this._sdk._free(this._staging);
+      this._staging = 0;
+      try {
+        return this._publish(this._sdk._wrapPtr(ptr));
+      } finally {
+        for (const view of this._views) view._session = null;
+        this._views.clear();
+      }
+    }
+
+    // Refresh the views following this session from the new rows
+    _publish(table) {
+      if (table.isError) return table;
+      try {
+        for (const view of this._views) view.refresh(table);
+      } catch (error) {
+        // The caller never gets the snapshot to drop
+        table.drop();
+        throw error;
+      }
+      return table;
+    }
+
+    _encode(col, i) {
+      const type = this._types[i];
+      const name = this._names[i];
+      if (type === Types.SYMBOL) {
+        const packed = isPackedStrings(col) ? col : Array.isArray(col) ? packStrings(col) : null;
+        if (packed === null) throw new Error(`Column ${name}: expected strings or { bytes, offsets }`);
+        return { bytes: packed.bytes, offsets: Int32Array.from(packed.offsets), rows: packed.offsets.length - 1 };
+      }
+      if (type === Types.GUID) {
+        if (!(col instanceof Uint8Array)) throw new Error(`Column ${name}: expected a Uint8Array of 16-byte GUIDs`);
+        return { bytes: col, rows: col.length / 16 };
+      }
+      const Ctor = TYPED_ARRAY_MAP[type];
+      let view = col;
+      if (Array.isArray(col)) {
+        if (Ctor === BigInt64Array) view = BigInt64Array.from(col, v => BigInt(v));
+        else if (type === Types.B8) view = Int8Array.from(col, v => (v ? 1 : 0));
+        else view = Ctor.from(col);
+      } else if (!(col instanceof Ctor)) {
+        throw new Error(`Column ${name}: expected ${Ctor.name} or an array`);
+      }
+      return { bytes: new Uint8Array(view.buffer, view.byteOffset, view.byteLength), rows: view.length };
+    }
+
+    _reserve(size) {
+      if (size > this._stagingSize) {
+        if (this._staging !== 0) this._sdk._free(this._staging);
+        this._stagingSize = Math.max(size, this._stagingSize * 2, 65536);
+        this._staging = this._sdk._malloc(this._stagingSize);
+        if (this._staging === 0) {
+          this._stagingSize = 0;
+          throw new Error('Out of memory: failed to stage append batch');
+        }
+      }
+      return this._staging;
+    }
+  }
+
+  function align8(n) { return (n + 7) & ~7; }
+
+  // ============================================================================
+  // Materialized View
+  // ============================================================================
+
+  const MVIEW_OPS = { sum: 0, avg: 1, min: 2, max: 3, count: 4, first: 5, last: 6 };
+
+  // Group-by aggregation folded incrementally into native accumulators
+  class MaterializedView {
+    constructor(sdk, query) {
+      const table = query._table;
+      if (!(table instanceof Table)) throw new Error('Materialized views need a query over a table');
+      if (!query._byCols || query._byCols.length === 0) {
+        throw new Error('Materialized views need groupBy() columns');
+      }
+      if (query._whereCond) throw new Error('Materialized views do not support where()');
+      const columns = table.columnNames();
+      const position = (name) => {
+        const i = columns.indexOf(name);
+        if (i === -1) throw new Error(`Unknown column '${name}'`);
+        return i;
+      };
+      for (const col of query._selectCols || []) {
+        if (!query._byCols.includes(col)) {
+          throw new Error(`Selected column '${col}' must be a groupBy() key or an aggregate`);
+        }
+      }
+      const keys = query._byCols.map(position);
+      const aggs = [];
+      const names = [...query._byCols];
+      for (const [name, expr] of Object.entries(query._computedCols)) {
+        const op = MVIEW_OPS[expr._op];
+        const arg = expr._args[0];
+        if (op === undefined || !(arg instanceof Expr) || arg._op !== null) {
+          throw new Error(`Column '${name}': expected sum/avg/min/max/count/first/last of a column`);
+        }
+        aggs.push(op, position(arg._args[0]));
+        names.push(name);
+      }
+      if (aggs.length === 0) throw new Error('Materialized views need an aggregate (withColumn)');
+
+      const w = sdk._wasm;
+      const keysPtr = sdk._malloc(keys.length * 4);
+      const aggsPtr = sdk._malloc(aggs.length * 4);
+      try {
+        w.HEAP32.set(keys, keysPtr / 4);
+        w.HEAP32.set(aggs, aggsPtr / 4);
+        this._view = sdk._mviewNew(table._ptr, keysPtr, keys.length, aggsPtr, aggs.length / 2);
+      } finally {
+        sdk._free(aggsPtr);
+        sdk._free(keysPtr);
+      }
+      if (this._view === 0) {
+        throw new Error('Unsupported view: sum/avg need numeric columns, min/max non-symbol ones');
+      }
+      this._sdk = sdk;
+      this._session = null;
+      this._names = sdk._unscoped(() => {
+        const vec = sdk.vector(Types.SYMBOL, names.length);
+        vec.typedArray.set(sdk.internSymbols(names));
+        return vec;
+      });
+      this.refresh(table);
+    }
+
+    // `table` must be the source or a later snapshot of it
+    refresh(table) {
+      if (this._view === 0) throw new Error('Materialized view is dropped');
+      const groups = Number(this._sdk._mviewUpdate(this._view, table._ptr));
+      if (groups === -2) throw new Error('Interrupted');
+      if (groups < 0) throw new Error('Table does not extend the materialized view source');
+      return this;
+    }
+
+    read() {
+      if (this._view === 0) throw new Error('Materialized view is dropped');
+      return this._sdk._wrapPtr(this._sdk._mviewRead(this._view, this._names._ptr));
+    }
+
+    drop() {
+      if (this._view === 0) return;
+      if (this._session !== null) this._session._views.delete(this);
+      this._sdk._mviewFree(this._view);
+      this._names.drop();
+      this._view = 0;
+    }
+  }
+
+  // Native equality index on one column: binary search over ascending
+  // columns, otherwise a hash whose row chains double as groups. In-place
+  // writes (Vector.set(), typedArray) are not seen until rebuild().
+  class TableIndex {
+    constructor(sdk, table, column) {
+      const col = table.col(column);
+      const type = col.isError ? null : col.elementType;
+      col.drop();
+      this._sdk = sdk;
+      this._column = column;
+      this._type = type;
+      this._handle = type === null ? 0 : sdk._indexNew(table._ptr, column, column.length);
+      if (this._handle === 0) {
+        throw new TypeError(`Column '${column}' cannot be indexed: expected a SYMBOL, boolean, integer or temporal column`);
+      }
+      this._ref = typeof WeakRef === 'function' ? new WeakRef(this) : { deref: () => this };
+      sdk._indexes.add(this._ref);
+      if (sdk._indexRegistry !== null) {
+        sdk._indexRegistry.register(this, { handle: this._handle, ref: this._ref }, this);
+      }
+    }
+
+    get column() { return this._column; }
+
+    get kind() {
+      this._check();
+      const kind = this._sdk._indexKind(this._handle);
+      return kind === 1 ? 'sorted' : kind === 2 ? 'hash' : null;
+    }
+
+    rows(value) { return this._sdk._wrapPtr(this._sdk._indexRows(this._handle, this._probeKey(value))); }
+    where(value) { return this._sdk._wrapPtr(this._sdk._indexWhere(this._handle, this._probeKey(value))); }
+
+    rebuild() {
+      this._check();
+      this._sdk._indexRebuild(this._handle);
+      return this;
+    }
+
+    groups() {
+      this._check();
+      return this._sdk._wrapPtr(this._sdk._indexGroups(this._handle));
+    }
+
+    drop() {
+      if (this._handle === 0) return;
+      const sdk = this._sdk;
+      sdk._indexes.delete(this._ref);
+      if (sdk._indexRegistry !== null) sdk._indexRegistry.unregister(this);
+      sdk._indexFree(this._handle);
+      this._handle = 0;
+    }
+
+    _check() {
+      if (this._handle === 0) throw new Error('Index is dropped');
+    }
+
+    _probeKey(value) {
+      this._check();
+      const key = this._key(value);
+      if (key === null) throw new TypeError(`Cannot look up ${typeof value} in column '${this._column}'`);
+      return this._sdk._stageIndexKey(key);
+    }
+
+    // Exact i64 key as a BigInt, or null (Numbers past 2^53, BigInts past 64 bits)
+    _key(value) {
+      if (this._type === Types.SYMBOL) {
+        return typeof value === 'string' ? this._sdk.internSymbols([value])[0] : null;
+      }
+      if (typeof value === 'boolean') return BigInt(value ? 1 : 0);
+      if (typeof value === 'bigint') return BigInt.asIntN(64, value) === value ? value : null;
+      return Number.isSafeInteger(value) ? BigInt(value) : null;
     }
   }
 
@@ -437,12 +899,13 @@
   // ============================================================================
 
   class Expr {
-    constructor(sdk, parts) {
+    constructor(sdk, op, args) {
       this._sdk = sdk;
-      this._parts = parts;
+      this._op = op; // null for a column reference
+      this._args = args;
     }
 
-    static col(sdk, name) { return new Expr(sdk, [`\`${name}`]); }
+    static col(sdk, name) { return new Expr(sdk, null, [name]); }
 
     eq(value) { return this._binOp('=', value); }
     ne(value) { return this._binOp('<>', value); }
@@ -453,24 +916,33 @@
 
     and(other) { return this._logicOp('and', other); }
     or(other) { return this._logicOp('or', other); }
-    not() { return new Expr(this._sdk, ['(not', ...this._parts, ')']); }
-
-    sum() { return new Expr(this._sdk, ['(sum', ...this._parts, ')']); }
-    avg() { return new Expr(this._sdk, ['(avg', ...this._parts, ')']); }
-    min() { return new Expr(this._sdk, ['(min', ...this._parts, ')']); }
-    max() { return new Expr(this._sdk, ['(max', ...this._parts, ')']); }
-    count() { return new Expr(this._sdk, ['(count', ...this._parts, ')']); }
-    first() { return new Expr(this._sdk, ['(first', ...this._parts, ')']); }
-    last() { return new Expr(this._sdk, ['(last', ...this._parts, ')']); }
-    distinct() { return new Expr(this._sdk, ['(distinct', ...this._parts, ')']); }
-
-    _binOp(op, value) {
-      const valStr = this._valueToStr(value);
-      return new Expr(this._sdk, [`(${op}`, ...this._parts, valStr, ')']);
-    }
-
-    _logicOp(op, other) {
-      return new Expr(this._sdk, [`(${op}`, ...this._parts, ...other._parts, ')']);
+    not() { return this._unOp('not'); }
+
+    sum() { return this._unOp('sum'); }
+    avg() { return this._unOp('avg'); }
+    min() { return this._unOp('min'); }
+    max() { return this._unOp('max'); }
+    count() { return this._unOp('count'); }
+    first() { return this._unOp('first'); }
+    last() { return this._unOp('last'); }
+    distinct() { return this._unOp('distinct'); }
+
+    _unOp(op) { return new Expr(this._sdk, op, [this]); }
+    _binOp(op, value) { return new Expr(this._sdk, op, [this, value]); }
+    _logicOp(op, other) { return new Expr(this._sdk, op, [this, other]); }
+
+    _emit(plan) {
+      if (this._op === null) {
+        plan.name(this._args[0]);
+        return;
+      }
+      plan.name(this._op);
+      for (const arg of this._args) {
+        if (arg instanceof Expr) arg._emit(plan);
+        else if (typeof arg === 'string') plan.literal(this._sdk.string(arg), true);
+        else plan.literal(arg);
+      }
+      plan.call(this._args.length + 1);
     }
 
     _valueToStr(value) {
@@ -479,7 +951,77 @@
       return String(value);
     }
 
-    toString() { return this._parts.join(' '); }
+    toString() {
+      if (this._op === null) return `\`${this._args[0]}`;
+      return `(${[this._op, ...this._args.map(a => this._valueToStr(a))].join(' ')})`;
+    }
+  }
+
+  // ============================================================================
+  // Plan Builder
+  // ============================================================================
+
+  // Postfix program for build_plan: leaves are handles, calls and dicts are
+  // assembled natively
+  class PlanBuilder {
+    constructor(sdk) {
+      this._sdk = sdk;
+      this._code = [];
+      this._objs = [];
+      this._temps = [];
+    }
+
+    push(obj) {
+      this._code.push(PLAN_PUSH, this._objs.push(obj) - 1);
+      return this;
+    }
+
+    quote(obj) {
+      this._code.push(PLAN_QUOTE, this._objs.push(obj) - 1);
+      return this;
+    }
+
+    name(name) { return this.push(this._temp(this._sdk.symbol(name))); }
+
+    literal(value, temp = false) {
+      const obj = value instanceof RayObject ? value : this._sdk._toRayObject(value);
+      if (temp || obj !== value) this._temp(obj);
+      const type = obj.type;
+      return type === -Types.SYMBOL || type === Types.LIST ? this.quote(obj) : this.push(obj);
+    }
+
+    call(n) {
+      this._code.push(PLAN_CALL, n);
+      return this;
+    }
+
+    dict(n) {
+      this._code.push(PLAN_DICT, n);
+      return this;
+    }
+
+    build() {
+      const w = this._sdk._wasm;
+      const code = Int32Array.from(this._code);
+      const codePtr = this._sdk._malloc(code.byteLength);
+      const objsPtr = this._sdk._malloc((this._objs.length || 1) * this._sdk._ptrSize);
+      try {
+        w.HEAP32.set(code, codePtr / 4);
+        this._sdk._setPtrs(objsPtr, this._objs.map(o => o._ptr));
+        return this._sdk._wrapPtr(
+          this._sdk._buildPlan(codePtr, code.length / 2, objsPtr, this._objs.length));
+      } finally {
+        this._sdk._free(objsPtr);
+        this._sdk._free(codePtr);
+        for (const obj of this._temps) obj.drop();
+        this._temps.length = 0;
+      }
+    }
+
+    _temp(obj) {
+      this._temps.push(obj);
+      return obj;
+    }
   }
 
   // ============================================================================
@@ -494,6 +1036,8 @@
       this._whereCond = null;
       this._byCols = null;
       this._computedCols = {};
+      this._plan = null;
+      this._keep = false;
     }
 
     select(...cols) {
@@ -522,27 +1066,101 @@
 
     col(name) { return Expr.col(this._sdk, name); }
 
+    // A plan pins its table: keep() holds it across execute() until drop()
+    keep() {
+      this._keep = true;
+      return this;
+    }
+
+    drop() {
+      if (this._plan !== null) {
+        this._plan.drop();
+        this._plan = null;
+      }
+    }
+
     execute() {
-      const query = { from: this._table._ptr };
+      const probed = this._probeIndex();
+      if (probed !== null) return probed;
+      const transient = this._plan === null && !this._keep;
+      try {
+        return this._sdk._wrapPtr(this._sdk._querySelect(this.plan()._ptr));
+      } finally {
+        if (transient) this.drop();
+      }
+    }
+
+    // where(col.eq(literal)) over an indexed column: probe, then run the
+    // rest of the query over the matching rows; null when no index applies
+    _probeIndex() {
+      const sdk = this._sdk;
+      const cond = this._whereCond;
+      if (sdk._indexes.size === 0 || cond === null || cond._op !== '=' || !(this._table instanceof Table)) {
+        return null;
+      }
+      let [column, value] = cond._args;
+      if (!(column instanceof Expr)) [column, value] = [value, column];
+      if (!(column instanceof Expr) || column._op !== null || value instanceof Expr) return null;
+
+      const index = sdk._indexFor(this._table, column._args[0]);
+      const key = index !== null ? index._key(value) : null;
+      if (key === null) return null;
+
+      const rows = sdk._wrapPtr(sdk._indexWhere(index._handle, sdk._stageIndexKey(key)));
+      if (rows.isError || (this._selectCols === null && this._byCols === null &&
+          Object.keys(this._computedCols).length === 0)) {
+        return rows;
+      }
+      const q = this._clone();
+      q._table = rows;
+      q._whereCond = null;
+      try {
+        const plan = q.plan();
+        try {
+          return sdk._wrapPtr(sdk._querySelectUncached(plan._ptr));
+        } finally {
+          plan.drop();
+        }
+      } finally {
+        rows.drop();
+      }
+    }
+
+    // Native query dict, built once from handles and cached until drop()
+    plan() {
+      if (this._plan !== null) return this._plan;
+      const p = new PlanBuilder(this._sdk);
+      let entries = 1;
+      p.name('from').push(this._table);
       if (this._selectCols) {
         for (const col of this._selectCols) {
-          if (typeof col === 'string') query[col] = col;
+          if (typeof col !== 'string') continue;
+          p.name(col).name(col);
+          entries++;
         }
       }
       for (const [name, expr] of Object.entries(this._computedCols)) {
-        query[name] = expr.toString();
+        p.name(name);
+        expr._emit(p);
+        entries++;
       }
-      if (this._whereCond) query.where = this._whereCond.toString();
-      if (this._byCols) {
-        query.by = {};
-        for (const col of this._byCols) query.by[col] = col;
+      if (this._whereCond) {
+        p.name('where');
+        this._whereCond._emit(p);
+        entries++;
       }
-      const queryDict = this._sdk.dict(query);
-      return this._sdk._wrapPtr(this._sdk._querySelect(queryDict._ptr));
+      if (this._byCols && this._byCols.length > 0) {
+        p.name('by');
+        for (const col of this._byCols) p.name(col).name(col);
+        p.dict(this._byCols.length);
+        entries++;
+      }
+      this._plan = this._sdk._unscoped(() => p.dict(entries).build());
+      return this._plan;
     }
 
     _clone() {
-      const q = new SelectQuery(this._sdk, this._table);
+      const q = new this.constructor(this._sdk, this._table);
       q._selectCols = this._selectCols;
       q._whereCond = this._whereCond;
       q._byCols = this._byCols;
@@ -552,146 +1170,1247 @@
   }
 
   // ============================================================================
-  // Main SDK Class
+  // Splayed Table
   // ============================================================================
 
-  class RayforceSDK {
-    constructor(wasm) {
-      this._wasm = wasm;
-      this._cmdCounter = 0;
-      this._setupBindings();
+  const SPLAYED_CACHE_BYTES = 256 * 1024 * 1024;
+
+  // Columns paged in on demand, cached LRU within a byte budget
+  class SplayedTable {
+    constructor(sdk, path, names, types, rows, maxBytes = SPLAYED_CACHE_BYTES) {
+      this._sdk = sdk;
+      this._path = path;
+      this._names = names;
+      this._types = types;
+      this._rows = rows;
+      this._maxBytes = maxBytes;
+      this._cache = new Map();
+      this._loading = new Map();
+      this._bytes = 0;
+      this._syms = null;
+      this._symsLoading = null;
     }
 
-    _setupBindings() {
-      const w = this._wasm;
+    columnNames() { return this._names.slice(); }
 
-      this._evalCmd = w.cwrap('eval_cmd', 'number', ['string', 'string']);
-      this._evalStr = w.cwrap('eval_str', 'number', ['string']);
-      this._strOfObj = w.cwrap('strof_obj', 'string', ['number']);
-      this._dropObj = w.cwrap('drop_obj', null, ['number']);
-      this._cloneObj = w.cwrap('clone_obj', 'number', ['number']);
-      this._versionStr = w.cwrap('version_str', 'string', []);
-
-      this._getObjType = w.cwrap('get_obj_type', 'number', ['number']);
-      this._getObjLen = w.cwrap('get_obj_len', 'number', ['number']);
-      this._isObjAtom = w.cwrap('is_obj_atom', 'number', ['number']);
-      this._isObjVector = w.cwrap('is_obj_vector', 'number', ['number']);
-      this._isObjNull = w.cwrap('is_obj_null', 'number', ['number']);
-      this._isObjError = w.cwrap('is_obj_error', 'number', ['number']);
-      this._getObjRc = w.cwrap('get_obj_rc', 'number', ['number']);
-
-      this._getDataPtr = w.cwrap('get_data_ptr', 'number', ['number']);
-      this._getElementSize = w.cwrap('get_element_size', 'number', ['number']);
-      this._getDataByteSize = w.cwrap('get_data_byte_size', 'number', ['number']);
-
-      this._initB8 = w.cwrap('init_b8', 'number', ['number']);
-      this._initU8 = w.cwrap('init_u8', 'number', ['number']);
-      this._initC8 = w.cwrap('init_c8', 'number', ['number']);
-      this._initI16 = w.cwrap('init_i16', 'number', ['number']);
-      this._initI32 = w.cwrap('init_i32', 'number', ['number']);
-      this._initI64 = w.cwrap('init_i64', 'number', ['number']);
-      this._initF64 = w.cwrap('init_f64', 'number', ['number']);
-      this._initDate = w.cwrap('init_date', 'number', ['number']);
-      this._initTime = w.cwrap('init_time', 'number', ['number']);
-      this._initTimestamp = w.cwrap('init_timestamp', 'number', ['number']);
-      this._initSymbolStr = w.cwrap('init_symbol_str', 'number', ['string', 'number']);
-      this._initStringStr = w.cwrap('init_string_str', 'number', ['string', 'number']);
-
-      this._readB8 = w.cwrap('read_b8', 'number', ['number']);
-      this._readU8 = w.cwrap('read_u8', 'number', ['number']);
-      this._readC8 = w.cwrap('read_c8', 'number', ['number']);
-      this._readI16 = w.cwrap('read_i16', 'number', ['number']);
-      this._readI32 = w.cwrap('read_i32', 'number', ['number']);
-      this._readI64 = w.cwrap('read_i64', 'number', ['number']);
-      this._readF64 = w.cwrap('read_f64', 'number', ['number']);
-      this._readDate = w.cwrap('read_date', 'number', ['number']);
-      this._readTime = w.cwrap('read_time', 'number', ['number']);
-      this._readTimestamp = w.cwrap('read_timestamp', 'number', ['number']);
-      this._readSymbolId = w.cwrap('read_symbol_id', 'number', ['number']);
-      this._symbolToStr = w.cwrap('symbol_to_str', 'string', ['number']);
-      // Change signature to number (ptr) to handle manual heap allocation
-      this._readCSV = w.cwrap('read_csv', 'number', ['number', 'number']);
-
-      this._initVector = w.cwrap('init_vector', 'number', ['number', 'number']);
-      this._initList = w.cwrap('init_list', 'number', ['number']);
-      this._vecAtIdx = w.cwrap('vec_at_idx', 'number', ['number', 'number']);
-      this._atIdx = w.cwrap('at_idx', 'number', ['number', 'number']);
-      this._atObj = w.cwrap('at_obj', 'number', ['number', 'number']);
-      this._pushObj = w.cwrap('push_obj', 'number', ['number', 'number']);
-      this._insObj = w.cwrap('ins_obj', 'number', ['number', 'number', 'number']);
-
-      this._initDict = w.cwrap('init_dict', 'number', ['number', 'number']);
-      this._dictKeys = w.cwrap('dict_keys', 'number', ['number']);
-      this._dictVals = w.cwrap('dict_vals', 'number', ['number']);
-      this._dictGet = w.cwrap('dict_get', 'number', ['number', 'number']);
-
-      this._initTable = w.cwrap('init_table', 'number', ['number', 'number']);
-      this._tableKeys = w.cwrap('table_keys', 'number', ['number']);
-      this._tableVals = w.cwrap('table_vals', 'number', ['number']);
-      this._tableCol = w.cwrap('table_col', 'number', ['number', 'string', 'number']);
-      this._tableRow = w.cwrap('table_row', 'number', ['number', 'number']);
-      this._tableCount = w.cwrap('table_count', 'number', ['number']);
-
-      this._querySelect = w.cwrap('query_select', 'number', ['number']);
-      this._queryUpdate = w.cwrap('query_update', 'number', ['number']);
-      this._tableInsert = w.cwrap('table_insert', 'number', ['number', 'number']);
-      this._tableUpsert = w.cwrap('table_upsert', 'number', ['number', 'number', 'number']);
-
-      this._internSymbol = w.cwrap('intern_symbol', 'number', ['string', 'number']);
-      this._globalSet = w.cwrap('global_set', null, ['number', 'number']);
-      this._quoteObj = w.cwrap('quote_obj', 'number', ['number']);
-      this._getTypeName = w.cwrap('get_type_name', 'string', ['number']);
+    schema() {
+      const result = {};
+      this._names.forEach((name, i) => { result[name] = this._types[i]; });
+      return result;
     }
 
-    get version() { return this._versionStr(); }
+    get rowCount() { return this._rows; }
+    get cachedBytes() { return this._bytes; }
 
-    eval(code, sourceName) {
-      const ptr = this._evalCmd(code, sourceName || `eval:${++this._cmdCounter}`);
-      return this._wrapPtr(ptr);
+    async col(name) {
+      const vec = await this._column(name, new Set([name]));
+      return vec.clone();
     }
 
-    format(obj) {
-      const ptr = obj instanceof RayObject ? obj._ptr : obj;
-      return this._strOfObj(ptr);
+    async table(...names) {
+      if (names.length === 0) names = this._names;
+      const pinned = new Set(names);
+      const cols = [];
+      for (const name of names) cols.push(await this._column(name, pinned));
+      const sdk = this._sdk;
+      return sdk._unscoped(() => {
+        const keys = sdk.vector(Types.SYMBOL, names.length);
+        keys.typedArray.set(sdk.internSymbols(names));
+        const vals = sdk.list();
+        for (const col of cols) vals.push(col);
+        return new Table(sdk, sdk._initTable(keys.release(), vals.release()));
+      });
     }
 
-    _wrapPtr(ptr) {
-      if (ptr === 0) return new RayNull(this, 0);
+    select(...cols) { return new SplayedQuery(this._sdk, this).select(...cols); }
+    where(condition) { return new SplayedQuery(this._sdk, this).where(condition); }
 
-      const type = this._getObjType(ptr);
-      const isAtom = this._isObjAtom(ptr);
-      const absType = type < 0 ? -type : type;
+    evict(name) {
+      for (const [key, entry] of [...this._cache]) {
+        if (name !== undefined && key !== name) continue;
+        entry.vec.drop();
+        this._bytes -= entry.bytes;
+        this._cache.delete(key);
+      }
+    }
 
-      if (type === Types.ERR) return new RayError(this, ptr);
-      if (type === Types.NULL || this._isObjNull(ptr)) return new RayNull(this, ptr);
+    drop() {
+      this.evict();
+      if (this._syms !== null) {
+        this._syms.drop();
+        this._syms = null;
+      }
+    }
 
-      if (isAtom) {
-        switch (absType) {
-          case Types.B8: return new B8(this, ptr);
-          case Types.U8: return new U8(this, ptr);
-          case Types.C8: return new C8(this, ptr);
-          case Types.I16: return new I16(this, ptr);
-          case Types.I32: return new I32(this, ptr);
-          case Types.I64: return new I64(this, ptr);
-          case Types.F64: return new F64(this, ptr);
-          case Types.DATE: return new RayDate(this, ptr);
-          case Types.TIME: return new RayTime(this, ptr);
-          case Types.TIMESTAMP: return new RayTimestamp(this, ptr);
-          case Types.SYMBOL: return new RaySymbol(this, ptr);
-          case Types.GUID: return new GUID(this, ptr);
-          default: return new RayObject(this, ptr);
+    // Pinned columns are never evicted to make room; concurrent misses on
+    // one column share a single read
+    async _column(name, pinned) {
+      const i = this._names.indexOf(name);
+      if (i === -1) throw new Error(`Unknown column '${name}'`);
+      const hit = this._cache.get(name);
+      if (hit !== undefined) {
+        this._cache.delete(name);
+        this._cache.set(name, hit);
+        return hit.vec;
+      }
+      let loading = this._loading.get(name);
+      if (loading === undefined) {
+        loading = this._load(name, i, pinned).finally(() => this._loading.delete(name));
+        this._loading.set(name, loading);
+      }
+      return loading;
+    }
+
+    async _load(name, i, pinned) {
+      let vec = await this._read(splayFile(name), pinned);
+      if (this._types[i] === Types.SYMBOL) {
+        const syms = await this._symbols(pinned);
+        const idx = vec;
+        vec = this._sdk._unscoped(() => this._sdk._wrapPtr(this._sdk._splayUnenum(idx._ptr, syms._ptr)));
+        idx.drop();
+        if (vec.isError) {
+          const message = vec.message;
+          vec.drop();
+          throw new Error(message);
         }
       }
+      const bytes = this._sdk._getDataByteSize(vec._ptr);
+      this._cache.set(name, { vec, bytes });
+      this._bytes += bytes;
+      this._shrink(pinned);
+      return vec;
+    }
 
-      switch (type) {
-        case Types.C8: return new RayString(this, ptr);
-        case Types.LIST: return new List(this, ptr);
-        case Types.DICT: return new Dict(this, ptr);
-        case Types.TABLE: return new Table(this, ptr);
-        case Types.LAMBDA: return new Lambda(this, ptr);
-        default:
-          if (TYPED_ARRAY_MAP[type]) return new Vector(this, ptr, type);
-          return new RayObject(this, ptr);
+    async _symbols(pinned) {
+      if (this._syms !== null) return this._syms;
+      if (this._symsLoading === null) {
+        this._symsLoading = this._read('.sym', pinned)
+          .then((syms) => { this._syms = syms; return syms; })
+          .finally(() => { this._symsLoading = null; });
+      }
+      return this._symsLoading;
+    }
+
+    // On a decode failure evict unpinned columns and retry once
+    async _read(file, pinned) {
+      for (let attempt = 0; ; attempt++) {
+        const obj = await this._sdk._readObject(this._path, file);
+        if (obj === null) throw new Error(`Splayed table '${this._path[0]}' is missing '${file}'`);
+        if (!obj.isError) return obj;
+        const message = obj.message;
+        obj.drop();
+        if (attempt > 0 || this._bytes === 0) throw new Error(message);
+        this._shrink(pinned, 0);
+      }
+    }
+
+    _shrink(pinned, limit = this._maxBytes) {
+      for (const [key, entry] of [...this._cache]) {
+        if (this._bytes <= limit) return;
+        if (pinned.has(key)) continue;
+        entry.vec.drop();
+        this._bytes -= entry.bytes;
+        this._cache.delete(key);
+      }
+    }
+  }
+
+  // SELECT over a SplayedTable: runs over a table of just the referenced columns
+  class SplayedQuery extends SelectQuery {
+    async execute() {
+      const table = await this._table.table(...this.columnsUsed());
+      const q = this._clone();
+      q._table = table;
+      try {
+        const plan = q.plan();
+        try {
+          return this._sdk._wrapPtr(this._sdk._querySelectUncached(plan._ptr));
+        } finally {
+          plan.drop();
+        }
+      } finally {
+        table.drop();
+      }
+    }
+
+    columnsUsed() {
+      const all = this._table.columnNames();
+      if (this._selectCols === null && Object.keys(this._computedCols).length === 0) return all;
+      const used = new Set();
+      const visit = (e) => {
+        if (!(e instanceof Expr)) return;
+        if (e._op === null) used.add(e._args[0]);
+        else e._args.forEach(visit);
+      };
+      for (const col of this._selectCols || []) {
+        if (typeof col === 'string') used.add(col);
+        else visit(col);
+      }
+      Object.values(this._computedCols).forEach(visit);
+      visit(this._whereCond);
+      for (const col of this._byCols || []) used.add(col);
+      return all.filter(name => used.has(name));
+    }
+
+    plan() {
+      if (!(this._table instanceof RayObject)) {
+        throw new Error('Splayed queries are planned on execute()');
+      }
+      return super.plan();
+    }
+  }
+
+  // Connection to a native rayforce server (sdk.connect): IPC messages over a
+  // WebSocket, framed by their header and decoded in place on the WASM heap
+  class RemoteConnection {
+    constructor(sdk, options) {
+      this._sdk = sdk;
+      this._socket = null;
+      this._pending = [];
+      this._opening = null;
+      this._awaitHello = options.handshake !== false;
+      this._headerSize = sdk._ipcHeaderSize();
+      this._header = new Uint8Array(this._headerSize);
+      this._headerFill = 0;
+      this._scratch = 0;
+      this._message = null;
+      this._messageType = 0;
+      this._messageFill = 0;
+      this.bytesSent = 0;
+      this.bytesReceived = 0;
+      this.onmessage = null;
+      this.onclose = null;
+    }
+
+    get connected() {
+      return this._socket !== null && this._opening === null && this._socket.readyState === 1;
+    }
+
+    query(expr) {
+      return new Promise((resolve, reject) => {
+        this._send(expr, IPC_MSG.SYNC);
+        this._pending.push({ resolve, reject });
+      });
+    }
+
+    send(expr) { this._send(expr, IPC_MSG.ASYNC); }
+    close() { if (this._socket !== null) this._socket.close(); }
+
+    _open(url, options) {
+      const Socket = options.WebSocket || globalThis.WebSocket;
+      if (typeof Socket !== 'function') throw new Error('No WebSocket implementation: pass options.WebSocket');
+      const timeout = options.timeout ?? 10000;
+      return new Promise((resolve, reject) => {
+        this._scratch = this._sdk._malloc(this._headerSize);
+        const socket = new Socket(url);
+        let timer = 0;
+        this._opening = {
+          resolve: () => { clearTimeout(timer); this._opening = null; resolve(); },
+          reject: (message) => {
+            clearTimeout(timer);
+            this._opening = null;
+            reject(new Error(message));
+            if (this._socket !== null) socket.close();
+          },
+        };
+        if (timeout > 0) timer = setTimeout(() => this._opening.reject(`Connection to ${url} timed out`), timeout);
+        socket.binaryType = 'arraybuffer';
+        socket.onopen = () => {
+          if (!this._awaitHello) { this._opening.resolve(); return; }
+          // Handshake: credentials, version byte, zero; the server answers with its version
+          const auth = new TextEncoder().encode(options.auth || '');
+          const hello = new Uint8Array(auth.length + 2);
+          hello.set(auth);
+          hello[auth.length] = this._sdk._ipcVersion();
+          socket.send(hello);
+        };
+        socket.onmessage = (event) => this._receive(new Uint8Array(event.data));
+        socket.onerror = () => { if (this._opening !== null) this._opening.reject(`Cannot connect to ${url}`); };
+        socket.onclose = () => this._closed(url);
+        this._socket = socket;
+      });
+    }
+
+    _send(expr, msgtype) {
+      if (!this.connected) throw new Error('Connection is closed');
+      const sdk = this._sdk;
+      const obj = typeof expr === 'string' ? sdk.string(expr) : sdk._toRayObject(expr);
+      const msg = sdk._unscoped(() => sdk._wrapPtr(sdk._ipcEncode(obj._ptr, msgtype)));
+      try {
+        if (msg.isError) throw new Error(msg.message);
+        // Copied: sockets may queue past this call, and shared heaps can't be sent
+        const bytes = msg.typedArray.slice();
+        this._socket.send(bytes);
+        this.bytesSent += bytes.length;
+      } finally {
+        msg.drop();
+        if (obj !== expr) obj.drop();
+      }
+    }
+
+    _receive(bytes) {
+      let pos = 0;
+      this.bytesReceived += bytes.length;
+      if (this._awaitHello && bytes.length > 0) {
+        this._awaitHello = false;
+        pos = 1;
+        if (this._opening !== null) this._opening.resolve();
+      }
+      try {
+        while (pos < bytes.length) {
+          if (this._message === null) {
+            const n = Math.min(this._headerSize - this._headerFill, bytes.length - pos);
+            this._header.set(bytes.subarray(pos, pos + n), this._headerFill);
+            this._headerFill += n;
+            pos += n;
+            if (this._headerFill < this._headerSize) return;
+            this._begin();
+          }
+          const view = this._message.typedArray;
+          const n = Math.min(view.length - this._messageFill, bytes.length - pos);
+          view.set(bytes.subarray(pos, pos + n), this._messageFill);
+          this._messageFill += n;
+          pos += n;
+          if (this._messageFill === view.length) this._dispatch();
+        }
+      } catch (error) {
+        this._fail(error);
+      }
+    }
+
+    _begin() {
+      const sdk = this._sdk;
+      sdk._wasm.HEAPU8.set(this._header, this._scratch);
+      const len = Number(sdk._ipcMsgLen(this._scratch));
+      if (len < this._headerSize) throw new Error('Malformed rayforce IPC message header');
+      this._messageType = sdk._ipcMsgType(this._scratch);
+      this._message = sdk._unscoped(() => sdk.vector(Types.U8, len));
+      this._message.typedArray.set(this._header);
+      this._messageFill = this._headerSize;
+      this._headerFill = 0;
+    }
+
+    _dispatch() {
+      const sdk = this._sdk;
+      const buf = this._message;
+      let obj;
+      this._message = null;
+      try {
+        obj = sdk._unscoped(() => sdk._wrapPtr(sdk._deserialize(buf._ptr)));
+      } finally {
+        buf.drop();
+      }
+      if (this._messageType === IPC_MSG.RESPONSE) {
+        const pending = this._pending.shift();
+        if (pending !== undefined) pending.resolve(obj);
+        else obj.drop();
+        return;
+      }
+      const sync = this._messageType === IPC_MSG.SYNC;
+      let reply = null;
+      if (typeof this.onmessage === 'function') reply = this.onmessage(obj, sync);
+      else obj.drop();
+      if (sync) this._send(reply instanceof RayObject ? reply : null, IPC_MSG.RESPONSE);
+    }
+
+    _fail(error) {
+      for (const pending of this._pending.splice(0)) pending.reject(error);
+      this.close();
+    }
+
+    _closed(url) {
+      if (this._socket === null) return;
+      this._socket = null;
+      if (this._opening !== null) this._opening.reject(`Connection to ${url} closed during handshake`);
+      for (const pending of this._pending.splice(0)) pending.reject(new Error('Connection closed'));
+      if (this._message !== null) this._message.drop();
+      this._message = null;
+      this._sdk._free(this._scratch);
+      this._scratch = 0;
+      if (typeof this.onclose === 'function') this.onclose();
+    }
+  }
+
+  // ============================================================================
+  // Scope Helpers
+  // ============================================================================
+
+  // RayObjects returned from scope(): the value or members of an array / object
+  function scopeResults(result) {
+    const kept = new Set();
+    const visit = (v) => { if (v instanceof RayObject) kept.add(v); };
+    if (Array.isArray(result)) result.forEach(visit);
+    else if (result !== null && typeof result === 'object' && result.constructor === Object) {
+      Object.values(result).forEach(visit);
+    } else visit(result);
+    return kept;
+  }
+
+  // ============================================================================
+  // Bulk Column Helpers
+  // ============================================================================
+
+  // Pack strings as UTF-8 into one buffer with n + 1 offsets
+  function packStrings(strings) {
+    const encoder = new TextEncoder();
+    const offsets = new Int32Array(strings.length + 1);
+    let bytes = new Uint8Array(Math.max(64, strings.length * 8));
+    let pos = 0;
+    for (let i = 0; i < strings.length; i++) {
+      const str = String(strings[i]);
+      if (pos + str.length * 3 > bytes.length) {
+        const grown = new Uint8Array(Math.max(bytes.length * 2, pos + str.length * 3));
+        grown.set(bytes.subarray(0, pos));
+        bytes = grown;
+      }
+      pos += encoder.encodeInto(str, bytes.subarray(pos)).written;
+      offsets[i + 1] = pos;
+    }
+    return { bytes: bytes.subarray(0, pos), offsets };
+  }
+
+  // Decode packed UTF-8 from the heap; ASCII blobs in one TextDecoder pass
+  function decodePacked(heap, ptr, offsets) {
+    const n = offsets.length - 1;
+    const total = offsets[n];
+    let bytes = heap.subarray(ptr, ptr + total);
+    if (typeof SharedArrayBuffer !== 'undefined' && bytes.buffer instanceof SharedArrayBuffer) {
+      bytes = bytes.slice();
+    }
+    const decoder = new TextDecoder('utf-8');
+    const text = decoder.decode(bytes);
+    const result = new Array(n);
+    if (text.length === total) {
+      for (let i = 0; i < n; i++) result[i] = text.slice(offsets[i], offsets[i + 1]);
+    } else {
+      for (let i = 0; i < n; i++) result[i] = decoder.decode(bytes.subarray(offsets[i], offsets[i + 1]));
+    }
+    return result;
+  }
+
+  // LRU cache of symbol id -> string (Map keeps insertion order)
+  const SYMBOL_CACHE_SIZE = 65536;
+
+  class SymbolCache {
+    constructor(capacity) {
+      this._capacity = capacity;
+      this._map = new Map();
+    }
+
+    get(id) {
+      const str = this._map.get(id);
+      if (str !== undefined) {
+        this._map.delete(id);
+        this._map.set(id, str);
+      }
+      return str;
+    }
+
+    set(id, str) {
+      this._map.delete(id);
+      this._map.set(id, str);
+      if (this._map.size > this._capacity) this._map.delete(this._map.keys().next().value);
+    }
+
+    clear() { this._map.clear(); }
+  }
+
+  function isPackedStrings(col) {
+    return col !== null && typeof col === 'object' &&
+      col.bytes instanceof Uint8Array && ArrayBuffer.isView(col.offsets);
+  }
+
+  // Columns table() may bulk-build with the same result as _arrayToVector
+  function isBulkIdentical(col) {
+    if (col instanceof BigInt64Array) return col.length > 0;
+    if (col instanceof Float64Array) return col.length > 0 && !Number.isInteger(col[0]);
+    if (Array.isArray(col)) return col.length > 0 && col.every(v => typeof v === 'string');
+    return isPackedStrings(col);
+  }
+
+  // ============================================================================
+  // Persistent Storage
+  // ============================================================================
+
+  // OPFS directory (and IndexedDB database) holding saved objects
+  const STORAGE_ROOT = 'rayforce';
+
+  function storageName(name) {
+    if (typeof name !== 'string' || !/^[A-Za-z0-9_.-]+$/.test(name) || /^\.\.?$/.test(name)) {
+      throw new Error(`Invalid storage name '${name}'`);
+    }
+    return name;
+  }
+
+  // Column file name; leading '.' is reserved for `.d` and `.sym`
+  function splayFile(column) {
+    if (column === '' || column[0] === '.' || /[\/\\]/.test(column)) {
+      throw new Error(`Column name '${column}' cannot be splayed`);
+    }
+    return column;
+  }
+
+  let splayGenerations = 0;
+
+  // Hidden generation directory of a splayed table save
+  function splayGeneration() {
+    return `.g${Date.now().toString(36)}${(splayGenerations++).toString(36)}`;
+  }
+
+  function hasOPFS() {
+    return typeof navigator !== 'undefined' && navigator.storage !== undefined &&
+      typeof navigator.storage.getDirectory === 'function';
+  }
+
+  function noStorage() {
+    if (typeof indexedDB === 'undefined') throw new Error('Persistent storage is not available');
+  }
+
+  // Directory below STORAGE_ROOT, or null if missing and !create
+  async function opfsDir(path, create) {
+    let dir = await navigator.storage.getDirectory();
+    try {
+      for (const part of [STORAGE_ROOT, ...path]) dir = await dir.getDirectoryHandle(part, { create });
+    } catch (error) {
+      if (error.name === 'NotFoundError') return null;
+      throw error;
+    }
+    return dir;
+  }
+
+  function idbRequest(mode, fn) {
+    return new Promise((resolve, reject) => {
+      const open = indexedDB.open(STORAGE_ROOT, 1);
+      open.onupgradeneeded = () => open.result.createObjectStore('files');
+      open.onerror = () => reject(open.error);
+      open.onsuccess = () => {
+        const db = open.result;
+        const tx = db.transaction('files', mode);
+        const req = fn(tx.objectStore('files'));
+        tx.oncomplete = () => { db.close(); resolve(req.result); };
+        tx.onerror = () => { db.close(); reject(tx.error); };
+      };
+    });
+  }
+
+  // Write view() (called right before use); sync access handles in workers
+  async function storageWrite(path, file, view) {
+    if (!hasOPFS()) {
+      noStorage();
+      const blob = new Blob([view()]);
+      await idbRequest('readwrite', store => store.put(blob, [...path, file].join('/')));
+      return;
+    }
+    const handle = await (await opfsDir(path, true)).getFileHandle(file, { create: true });
+    if (typeof handle.createSyncAccessHandle === 'function') {
+      const access = await handle.createSyncAccessHandle();
+      try {
+        const bytes = view();
+        access.truncate(0);
+        access.write(bytes, { at: 0 });
+        access.flush();
+      } finally {
+        access.close();
+      }
+      return;
+    }
+    const blob = new Blob([view()]);
+    const writable = await handle.createWritable();
+    await writable.write(blob);
+    await writable.close();
+  }
+
+  // Read into the view returned by alloc(size); false if the file is missing
+  async function storageRead(path, file, alloc) {
+    let blob;
+    if (!hasOPFS()) {
+      noStorage();
+      blob = await idbRequest('readonly', store => store.get([...path, file].join('/')));
+      if (blob === undefined) return false;
+    } else {
+      const dir = await opfsDir(path, false);
+      if (dir === null) return false;
+      let handle;
+      try {
+        handle = await dir.getFileHandle(file);
+      } catch (error) {
+        if (error.name === 'NotFoundError') return false;
+        throw error;
+      }
+      if (typeof handle.createSyncAccessHandle === 'function') {
+        const access = await handle.createSyncAccessHandle();
+        try {
+          const view = alloc(access.getSize());
+          access.read(view(), { at: 0 });
+        } finally {
+          access.close();
+        }
+        return true;
+      }
+      blob = await handle.getFile();
+    }
+    const view = alloc(blob.size);
+    const reader = blob.stream().getReader();
+    let offset = 0;
+    try {
+      while (true) {
+        const { done, value } = await reader.read();
+        if (done) break;
+        view().set(value, offset);
+        offset += value.length;
+      }
+    } finally {
+      reader.releaseLock();
+    }
+    return true;
+  }
+
+  async function storageRemove(path, entry) {
+    if (!hasOPFS()) {
+      noStorage();
+      // A directory is every key below `entry/`
+      const key = [...path, entry].join('/');
+      const below = IDBKeyRange.bound(key + '/', key + '0', false, true);
+      const counts = await Promise.all([key, below].map(range => idbRequest('readwrite', store => {
+        const count = store.count(range);
+        store.delete(range);
+        return count;
+      })));
+      return counts[0] + counts[1] > 0;
+    }
+    const dir = await opfsDir(path, false);
+    if (dir === null) return false;
+    try {
+      await dir.removeEntry(entry, { recursive: true });
+      return true;
+    } catch (error) {
+      if (error.name === 'NotFoundError') return false;
+      throw error;
+    }
+  }
+
+  async function storageList(path) {
+    if (!hasOPFS()) {
+      noStorage();
+      const prefix = path.length ? path.join('/') + '/' : '';
+      const keys = await idbRequest('readonly', store => store.getAllKeys());
+      const names = new Set();
+      for (const key of keys) {
+        if (key.startsWith(prefix)) names.add(key.slice(prefix.length).split('/')[0]);
+      }
+      return [...names].sort();
+    }
+    const dir = await opfsDir(path, false);
+    if (dir === null) return [];
+    const names = [];
+    for await (const name of dir.keys()) names.push(name);
+    return names.sort();
+  }
+
+  // Give the event loop a turn: scheduler.yield() where available, else a timer
+  function yieldTask() {
+    if (typeof globalThis.scheduler?.yield === 'function') return globalThis.scheduler.yield();
+    return new Promise(resolve => setTimeout(resolve, 0));
+  }
+
+  // ============================================================================
+  // Main SDK Class
+  // ============================================================================
+
+  class RayforceSDK {
+    constructor(wasm) {
+      this._wasm = wasm;
+      this._cmdCounter = 0;
+      this._profiling = false;
+      this._setupBindings();
+      this._setupHeapTracking();
+      this._symbolCache = new SymbolCache(SYMBOL_CACHE_SIZE);
+      this._setupReclamation();
+      // Polled by native loops; reading consumes a pending interrupt
+      this._interrupt = new Int32Array(1);
+      wasm.rayforce_interrupted = () => Atomics.exchange(this._interrupt, 0, 0);
+    }
+
+    // GC'd RayObjects drop their pointer; scope() arenas drop eagerly
+    _setupReclamation() {
+      this._scopes = [];
+      this._registry = typeof FinalizationRegistry === 'function'
+        ? new FinalizationRegistry((cell) => {
+          this._live.delete(cell);
+          if (cell.ptr !== 0) this._dropObj(cell.ptr);
+        })
+        : null;
+      this._live = new Set();
+      // WeakRefs of live TableIndexes; collected ones free their native index
+      this._indexes = new Set();
+      this._indexRegistry = typeof FinalizationRegistry === 'function'
+        ? new FinalizationRegistry(({ handle, ref }) => {
+          this._indexes.delete(ref);
+          this._indexFree(handle);
+        })
+        : null;
+    }
+
+    _track(obj) {
+      this._live.add(obj._cell);
+      if (this._registry !== null) this._registry.register(obj, obj._cell, obj);
+      if (this._scopes.length > 0) this._scopes[this._scopes.length - 1].push(obj);
+    }
+
+    _untrack(obj) {
+      this._live.delete(obj._cell);
+      if (this._registry !== null) this._registry.unregister(obj);
+    }
+
+    _unscoped(fn) {
+      const scopes = this._scopes;
+      this._scopes = [];
+      try {
+        return fn();
+      } finally {
+        this._scopes = scopes;
+      }
+    }
+
+    // Drop everything created in fn except the returned objects
+    scope(fn) {
+      const arena = [];
+      this._scopes.push(arena);
+      let result;
+      let kept = new Set();
+      try {
+        result = fn(this);
+        if (result !== null && typeof result === 'object' && typeof result.then === 'function') {
+          throw new Error('scope() callback must be synchronous');
+        }
+        kept = scopeResults(result);
+      } finally {
+        this._scopes.pop();
+        const outer = this._scopes.length > 0 ? this._scopes[this._scopes.length - 1] : null;
+        for (const obj of arena) {
+          if (kept.has(obj)) {
+            if (outer !== null) outer.push(obj);
+          } else {
+            obj.drop();
+          }
+        }
+      }
+      return result;
+    }
+
+    // Pointer for a native call that takes ownership of value
+    _handOff(value) {
+      if (value instanceof RayObject) return this._cloneObj(value._ptr);
+      return this._toRayObject(value).release();
+    }
+
+    // Memory growth detaches heap views; rayforce.post.js reports it
+    _setupHeapTracking() {
+      const w = this._wasm;
+      this._heapGeneration = 0;
+      const previous = w.onMemoryGrowth;
+      w.onMemoryGrowth = () => {
+        this._heapGeneration++;
+        if (previous) previous();
+      };
+    }
+
+    get heapGeneration() { return this._heapGeneration; }
+
+    get pointerSize() { return this._ptrSize; }
+
+    get simd() { return this._kernSimd() === 1; }
+
+    _setupBindings() {
+      const w = this._wasm;
+      // Bound from C signatures (return first): p pointer, j i64, i i32,
+      // d f64, v void, s string; wasm64 pointers/i64 cross as BigInt
+      this._ptrSize = w._ptr_size ? w._ptr_size() : 4;
+      const wide = this._ptrSize === 8;
+      const bind = (name, sig) => {
+        const fn = w['_' + name];
+        const ret = sig[0];
+        const args = sig.slice(1);
+        const strings = sig.includes('s');
+        if (!strings && !(wide && /[pj]/.test(sig))) return fn;
+        return (...a) => {
+          const stack = strings ? w.stackSave() : 0;
+          try {
+            for (let i = 0; i < args.length; i++) {
+              if (args[i] === 's') a[i] = this._stackString(a[i]);
+              if (wide && args[i] !== 'i' && args[i] !== 'd') a[i] = BigInt(a[i]);
+            }
+            const r = fn(...a);
+            if (ret === 's') return w.UTF8ToString(Number(r));
+            return wide && (ret === 'p' || ret === 'j') ? Number(r) : r;
+          } finally {
+            if (strings) w.stackRestore(stack);
+          }
+        };
+      };
+      this._malloc = bind('malloc', 'pp');
+      this._free = bind('free', 'vp');
+
+      this._evalCmd = bind('eval_cmd', 'pss');
+      this._evalStr = bind('eval_str', 'ps');
+      this._evalNextForm = bind('eval_next_form', 'ipi');
+      this._evalFormEnd = bind('eval_form_end', 'ipi');
+      this._evalSpan = bind('eval_span', 'ppiis');
+      this._strOfObj = bind('strof_obj', 'sp');
+      this._dropObj = bind('drop_obj', 'vp');
+      this._cloneObj = bind('clone_obj', 'pp');
+      this._versionStr = bind('version_str', 's');
+
+      this._getObjType = bind('get_obj_type', 'ip');
+      this._getObjLen = bind('get_obj_len', 'jp');
+      this._isObjAtom = bind('is_obj_atom', 'ip');
+      this._isObjVector = bind('is_obj_vector', 'ip');
+      this._isObjNull = bind('is_obj_null', 'ip');
+      this._isObjError = bind('is_obj_error', 'ip');
+      this._getObjRc = bind('get_obj_rc', 'ip');
+      this._objHeader = bind('obj_header', 'vpp');
+      this._headerPtr = this._malloc(OBJ_HEADER_SIZE);
+
+      this._getDataPtr = bind('get_data_ptr', 'pp');
+      this._getElementSize = bind('get_element_size', 'ii');
+      this._getDataByteSize = bind('get_data_byte_size', 'jp');
+
+      this._initB8 = bind('init_b8', 'pi');
+      this._initU8 = bind('init_u8', 'pi');
+      this._initC8 = bind('init_c8', 'pi');
+      this._initI16 = bind('init_i16', 'pi');
+      this._initI32 = bind('init_i32', 'pi');
+      this._initI64 = bind('init_i64', 'pj');
+      this._initF64 = bind('init_f64', 'pd');
+      this._initDate = bind('init_date', 'pi');
+      this._initTime = bind('init_time', 'pi');
+      this._initTimestamp = bind('init_timestamp', 'pj');
+      this._initSymbolStr = bind('init_symbol_str', 'psj');
+      this._initStringStr = bind('init_string_str', 'psj');
+
+      this._readB8 = bind('read_b8', 'ip');
+      this._readU8 = bind('read_u8', 'ip');
+      this._readC8 = bind('read_c8', 'ip');
+      this._readI16 = bind('read_i16', 'ip');
+      this._readI32 = bind('read_i32', 'ip');
+      this._readI64 = bind('read_i64', 'jp');
+      this._readF64 = bind('read_f64', 'dp');
+      this._readDate = bind('read_date', 'ip');
+      this._readTime = bind('read_time', 'ip');
+      this._readTimestamp = bind('read_timestamp', 'jp');
+      this._readSymbolId = bind('read_symbol_id', 'jp');
+      this._symbolToStr = bind('symbol_to_str', 'sj');
+      // Change signature to number (ptr) to handle manual heap allocation
+      this._readCSV = bind('read_csv', 'ppj');
+      this._readCSVTyped = bind('read_csv_typed', 'pppij');
+      this._lastIngestStats = bind('last_ingest_stats', 'p');
+      this._csvBegin = bind('csv_begin', 'ppj');
+      this._csvFeed = bind('csv_feed', 'jppj');
+      this._csvEnd = bind('csv_end', 'pp');
+      this._csvAbort = bind('csv_abort', 'vp');
+
+      this._initVector = bind('init_vector', 'pij');
+      this._initTableBulk = bind('init_table_bulk', 'pipppppj');
+      this._initList = bind('init_list', 'pj');
+      this._vecAtIdx = bind('vec_at_idx', 'ppj');
+      this._atIdx = bind('at_idx', 'ppj');
+      this._atObj = bind('at_obj', 'ppp');
+      this._pushObj = bind('push_obj', 'ppp');
+      this._vecInsert = bind('vec_insert', 'pppj');
+      this._insObj = bind('ins_obj', 'ppjp');
+
+      this._initDict = bind('init_dict', 'ppp');
+      this._dictKeys = bind('dict_keys', 'pp');
+      this._dictVals = bind('dict_vals', 'pp');
+      this._dictGet = bind('dict_get', 'ppp');
+
+      this._initTable = bind('init_table', 'ppp');
+      this._tableKeys = bind('table_keys', 'pp');
+      this._tableVals = bind('table_vals', 'pp');
+      this._tableCol = bind('table_col', 'ppsj');
+      this._tableRow = bind('table_row', 'ppj');
+      this._tableCount = bind('table_count', 'jp');
+      this._exportArrow = bind('export_arrow', 'pp');
+      this._importArrow = bind('import_arrow', 'ppj');
+      this._serialize = bind('serialize', 'pp');
+      this._deserialize = bind('deserialize', 'pp');
+      this._ipcVersion = bind('ipc_version', 'i');
+      this._ipcHeaderSize = bind('ipc_header_size', 'i');
+      this._ipcEncode = bind('ipc_encode', 'ppi');
+      this._ipcMsgLen = bind('ipc_msg_len', 'jp');
+      this._ipcMsgType = bind('ipc_msg_type', 'ip');
+      this._splayEnum = bind('splay_enum', 'pp');
+      this._splayUnenum = bind('splay_unenum', 'ppp');
+      this._appendBegin = bind('append_begin', 'pp');
+      this._appendRows = bind('append_rows', 'jpppj');
+      this._appendFlush = bind('append_flush', 'pp');
+      this._appendEnd = bind('append_end', 'pp');
+      this._mviewNew = bind('mview_new', 'pppipi');
+      this._mviewUpdate = bind('mview_update', 'jpp');
+      this._mviewRead = bind('mview_read', 'ppp');
+      this._mviewFree = bind('mview_free', 'vp');
+      this._tableSort = bind('table_sort', 'ppsj');
+      this._vecIsSorted = bind('vec_is_sorted', 'ip');
+      this._indexNew = bind('index_new', 'ppsj');
+      this._indexKind = bind('index_kind', 'ip');
+      this._indexSource = bind('index_source', 'pp');
+      this._indexRebuild = bind('index_rebuild', 'ip');
+      this._indexRows = bind('index_rows', 'ppp');
+      this._indexWhere = bind('index_where', 'ppp');
+      this._indexGroups = bind('index_groups', 'pp');
+      this._indexFree = bind('index_free', 'vp');
+      this._indexKey = this._malloc(8);
+
+      this._querySelect = bind('query_select', 'pp');
+      this._querySelectUncached = bind('query_select_uncached', 'pp');
+      this._queryUpdate = bind('query_update', 'pp');
+      this._tableInsert = bind('table_insert', 'ppp');
+      this._tableUpsert = bind('table_upsert', 'pppp');
+
+      this._internSymbol = bind('intern_symbol', 'jsj');
+      this._internSymbolsBulk = bind('intern_symbols_bulk', 'vpppj');
+      this._symbolsToStrsBulk = bind('symbols_to_strs_bulk', 'ppj');
+      this._globalSet = bind('global_set', 'ppp');
+      this._quoteObj = bind('quote_obj', 'pp');
+      this._buildPlan = bind('build_plan', 'ppipi');
+      this._evalPlan = bind('eval_plan', 'pp');
+      this._prepareCmd = bind('prepare_cmd', 'pss');
+      this._evalCached = bind('eval_cached', 'ps');
+      this._preparedCacheClear = bind('prepared_cache_clear', 'v');
+      this._resultCacheSetBudget = bind('result_cache_set_budget', 'vj');
+      this._resultCacheStats = bind('result_cache_stats', 'p');
+      this._resultCacheClear = bind('result_cache_clear', 'v');
+      this._profileBegin = bind('profile_begin', 'v');
+      this._profileEnd = bind('profile_end', 'p');
+      this._profileCmd = bind('profile_cmd', 'ps');
+      this._heapStats = bind('heap_stats', 'p');
+      this._heapEnd = bind('heap_end', 'p');
+      this._splitFeatures = w._split_features ? w._split_features() : 0;
+      this._loadedFeatures = 0;
+      this._featureLoads = new Map();
+      this._kernReduce = bind('kern_reduce', 'ppi');
+      this._kernCompare = bind('kern_compare', 'ppip');
+      this._kernCompact = bind('kern_compact', 'ppp');
+      this._kernSimd = bind('kern_simd', 'i');
+      this._temporalToMsF64 = bind('temporal_to_ms_f64', 'jpp');
+      this._temporalToMsI64 = bind('temporal_to_ms_i64', 'jpp');
+      this._temporalFromMsF64 = bind('temporal_from_ms_f64', 'pipj');
+      this._temporalFromMsI64 = bind('temporal_from_ms_i64', 'pipj');
+      this._getTypeName = bind('get_type_name', 'si');
+    }
+
+    get version() { return this._versionStr(); }
+
+    eval(code, sourceName) {
+      const ptr = this._evalCmd(code, sourceName || `eval:${++this._cmdCounter}`);
+      return this._wrapPtr(ptr);
+    }
+
+    // One top-level form at a time, yielding every yieldMs; an AbortSignal
+    // (at yields) or interrupt() (before each form) stops it between forms,
+    // a single form runs to completion
+    async evalAsync(code, options = {}) {
+      const { signal, onProgress, yieldMs = 10 } = options;
+      const name = options.sourceName || `eval:${++this._cmdCounter}`;
+      signal?.throwIfAborted();
+      const w = this._wasm;
+      const length = w.lengthBytesUTF8(code);
+      const src = this._malloc(length + 1);
+      w.stringToUTF8(code, src, length + 1);
+      let result = null;
+      let forms = 0;
+      let slice = performance.now();
+      try {
+        for (let pos = this._evalNextForm(src, 0); pos >= 0; pos = this._evalNextForm(src, pos)) {
+          if (Atomics.exchange(this._interrupt, 0, 0) !== 0) {
+            throw signal?.aborted ? signal.reason : new DOMException('Interrupted', 'AbortError');
+          }
+          const end = this._evalFormEnd(src, pos);
+          if (result !== null) result.drop();
+          result = this._unscoped(() => this._wrapPtr(this._evalSpan(src, pos, end, name)));
+          if (result.isError) break;
+          pos = end;
+          forms++;
+          if (onProgress) onProgress({ forms, offset: end, length });
+          if (performance.now() - slice >= yieldMs) {
+            await yieldTask();
+            signal?.throwIfAborted();
+            slice = performance.now();
+          }
+        }
+      } catch (error) {
+        if (result !== null) result.drop();
+        throw error;
+      } finally {
+        this._free(src);
+      }
+      return result ?? new RayNull(this, 0);
+    }
+
+    // Stop the running kernel, sortBy or view refresh ("Interrupted"), or
+    // evalAsync before its next form; set from another thread through a
+    // shared interruptFlag
+    interrupt() { Atomics.store(this._interrupt, 0, 1); }
+
+    get interruptFlag() { return this._interrupt; }
+    set interruptFlag(flag) { this._interrupt = flag; }
+
+    evalPlan(plan) { return this._wrapPtr(this._evalPlan(plan._ptr)); }
+
+    prepare(code, params = []) {
+      for (const p of params) {
+        if (typeof p !== 'string' || !/^[^\s()[\]{}"`]+$/.test(p)) {
+          throw new Error(`Invalid parameter name: ${p}`);
+        }
+      }
+      const fn = this._wrapPtr(this._prepareCmd(code, params.join(' ')));
+      if (fn.isError) {
+        const message = fn.message;
+        fn.drop();
+        throw new Error(message);
+      }
+      return new PreparedQuery(this, fn, params);
+    }
+
+    evalCached(code) { return this._wrapPtr(this._evalCached(code)); }
+
+    clearPreparedCache() { this._preparedCacheClear(); }
+
+    // Native select result cache: byte budget (0 = off), counters, clear
+    setResultCacheBudget(bytes) { this._resultCacheSetBudget(bytes); }
+    resultCacheStats() {
+      const base = this._resultCacheStats() / 8;
+      const f = this._wasm.HEAPF64;
+      return {
+        hits: f[base], misses: f[base + 1], bypassed: f[base + 2], evictions: f[base + 3],
+        invalidations: f[base + 4], entries: f[base + 5], bytes: f[base + 6], budget: f[base + 7],
+      };
+    }
+    clearResultCache() { this._resultCacheClear(); }
+
+    // Live TableIndex over `column` of `table`, or null
+    _indexFor(table, column) {
+      for (const ref of this._indexes) {
+        const index = ref.deref();
+        if (index !== undefined && index._column === column &&
+            this._indexSource(index._handle) === table._ptr) {
+          return index;
+        }
+      }
+      return null;
+    }
+
+    _stageIndexKey(key) {
+      new BigInt64Array(this._wasm.HEAPU8.buffer, this._indexKey, 1)[0] = key;
+      return this._indexKey;
+    }
+
+    materialize(query, options = {}) {
+      const view = new MaterializedView(this, query);
+      if (options.session) {
+        view._session = options.session;
+        options.session._views.add(view);
+      }
+      return view;
+    }
+
+    // Native phase/entry timings, also emitted as performance measures
+    profile(code) {
+      if (this._profiling) throw new Error('A profile is already running');
+      const perf = globalThis.performance;
+      let result, base, start, end;
+      this._profiling = true;
+      this._profileBegin();
+      try {
+        start = perf.now();
+        result = typeof code === 'function' ? code() : this._wrapPtr(this._profileCmd(code));
+        end = perf.now();
+      } finally {
+        base = this._profileEnd() / 8;
+        this._profiling = false;
+      }
+      const f = this._wasm.HEAPF64;
+      const entries = {};
+      PROFILE_ENTRIES.forEach((name, i) => {
+        const at = base + i * PROFILE_SLOT_FIELDS;
+        if (f[at] === 0) return;
+        entries[name] = { calls: f[at], ms: f[at + 1], bytes: f[at + 2] };
+        this._measure(`rayforce:${name}`, f[at + 3], f[at + 4]);
+      });
+      this._measure('rayforce:profile', start, end - start);
+      const tail = base + PROFILE_ENTRIES.length * PROFILE_SLOT_FIELDS;
+      return {
+        result,
+        totalMs: end - start,
+        allocatedBytes: f[tail],
+        maxEndBytes: f[tail + 1],
+        heapBytes: this._wasm.HEAPU8.length,
+        entries,
+      };
+    }
+
+    // Allocator statistics and SDK-owned objects by type name
+    heapStats() {
+      const base = this._heapStats() / 8;
+      const f = this._wasm.HEAPF64;
+      const liveByType = {};
+      let liveObjects = 0;
+      for (const cell of this._live) {
+        if (cell.ptr === 0) continue;
+        const name = this._getTypeName(this._getObjType(cell.ptr));
+        liveByType[name] = (liveByType[name] || 0) + 1;
+        liveObjects++;
+      }
+      return {
+        allocator: f[base + 6] === 1 ? 'pool' : 'sys',
+        heapBytes: this._wasm.HEAPU8.length,
+        arenaBytes: f[base],
+        usedBytes: f[base + 1],
+        freeBytes: f[base + 2],
+        freeChunks: f[base + 3],
+        releasableBytes: f[base + 4],
+        fragmentation: f[base + 5],
+        liveObjects,
+        liveByType,
+      };
+    }
+
+    // Module memory up to the heap top, for init({ snapshot })
+    snapshot() {
+      const heap = this._wasm.HEAPU8;
+      if (typeof SharedArrayBuffer !== 'undefined' && heap.buffer instanceof SharedArrayBuffer) {
+        throw new Error('Snapshots need the single-threaded build');
+      }
+      return heap.slice(0, this._heapEnd());
+    }
+
+    // Split build side modules ('io': CSV ingest and serialization)
+    hasFeature(name) {
+      const bit = SPLIT_FEATURES[name];
+      if (bit === undefined) throw new Error(`Unknown feature '${name}'`);
+      return (this._splitFeatures & bit) === 0 || (this._loadedFeatures & bit) !== 0;
+    }
+
+    loadFeature(name) {
+      if (this.hasFeature(name)) return Promise.resolve();
+      let pending = this._featureLoads.get(name);
+      if (pending === undefined) {
+        const options = { loadAsync: true, global: true, nodelete: true };
+        pending = this._wasm.loadDynamicLibrary(`rayforce-${name}.wasm`, options).then(
+          () => { this._loadedFeatures |= SPLIT_FEATURES[name]; },
+          (error) => {
+            this._featureLoads.delete(name);
+            throw new Error(`Failed to load feature '${name}': ${error.message || error}`);
+          });
+        this._featureLoads.set(name, pending);
+      }
+      return pending;
+    }
+
+    _requireFeature(name) {
+      if (!this.hasFeature(name)) {
+        throw new Error(`'${name}' is a side module in this build: await sdk.loadFeature('${name}') first`);
+      }
+    }
+
+    _measure(name, start, duration) {
+      const perf = globalThis.performance;
+      if (typeof perf.measure !== 'function') return;
+      try {
+        perf.measure(name, { start, duration });
+      } catch (error) {
+        // performance.measure(name, options) is User Timing Level 3
+      }
+    }
+
+    format(obj) {
+      const ptr = obj instanceof RayObject ? obj._ptr : obj;
+      return this._strOfObj(ptr);
+    }
+
+    // Object header in one native call
+    _header(ptr) {
+      this._objHeader(ptr, this._headerPtr);
+      const h = this._wasm.HEAP32;
+      const i = this._headerPtr / 4;
+      return {
+        type: h[i],
+        attrs: h[i + 1],
+        rc: h[i + 2] >>> 0,
+        flags: h[i + 3],
+        length: (h[i + 4] >>> 0) + h[i + 5] * 4294967296,
+        data: this._getPtr(this._headerPtr + 24),
+      };
+    }
+
+    // Native pointers (raw_p) in the heap, 4 or 8 bytes wide
+    _getPtr(addr) {
+      const h = this._wasm.HEAPU32;
+      const i = addr / 4;
+      return this._ptrSize === 8 ? h[i] + h[i + 1] * 4294967296 : h[i];
+    }
+
+    _setPtrs(addr, ptrs) {
+      this._wasm.HEAPU8.set(new Uint8Array(this._ptrArray(ptrs).buffer), addr);
+    }
+
+    _ptrArray(ptrs) {
+      return this._ptrSize === 8 ? BigUint64Array.from(ptrs, BigInt) : Uint32Array.from(ptrs);
+    }
+
+    // NUL-terminated UTF-8 on the stack (inside stackSave/stackRestore)
+    _stackString(str) {
+      if (str === null || str === undefined) return 0;
+      const w = this._wasm;
+      const size = w.lengthBytesUTF8(str) + 1;
+      const ptr = w.stackAlloc(size);
+      w.stringToUTF8(str, ptr, size);
+      return ptr;
+    }
+
+    _wrapPtr(ptr) {
+      if (ptr === 0) return new RayNull(this, 0);
+      const header = this._header(ptr);
+      const obj = this._wrapHeader(ptr, header);
+      obj._type = header.type;
+      return obj;
+    }
+
+    _wrapHeader(ptr, header) {
+      const type = header.type;
+      const isAtom = (header.flags & OBJ_HEADER_ATOM) !== 0;
+      const absType = type < 0 ? -type : type;
+
+      if (type === Types.ERR) return new RayError(this, ptr);
+      if (type === Types.NULL || (header.flags & OBJ_HEADER_NULL) !== 0) return new RayNull(this, ptr);
+
+      if (isAtom) {
+        switch (absType) {
+          case Types.B8: return new B8(this, ptr);
+          case Types.U8: return new U8(this, ptr);
+          case Types.C8: return new C8(this, ptr);
+          case Types.I16: return new I16(this, ptr);
+          case Types.I32: return new I32(this, ptr);
+          case Types.I64: return new I64(this, ptr);
+          case Types.F64: return new F64(this, ptr);
+          case Types.DATE: return new RayDate(this, ptr);
+          case Types.TIME: return new RayTime(this, ptr);
+          case Types.TIMESTAMP: return new RayTimestamp(this, ptr);
+          case Types.SYMBOL: return new RaySymbol(this, ptr);
+          case Types.GUID: return new GUID(this, ptr);
+          default: return new RayObject(this, ptr);
+        }
+      }
+
+      switch (type) {
+        case Types.C8: return new RayString(this, ptr);
+        case Types.LIST: return new List(this, ptr);
+        case Types.DICT: return new Dict(this, ptr);
+        case Types.TABLE: return new Table(this, ptr);
+        case Types.LAMBDA: return new Lambda(this, ptr);
+        default:
+          if (TYPED_ARRAY_MAP[type]) return new Vector(this, ptr, type);
+          return new RayObject(this, ptr);
       }
     }
 
@@ -707,8 +2426,7 @@
     date(value) {
       let days;
       if (value instanceof Date) {
-        const epoch = new Date(2000, 0, 1);
-        days = Math.floor((value - epoch) / (1000 * 60 * 60 * 24));
+        days = Math.floor((value.getTime() - RAY_EPOCH_MS) / DAY_MS);
       } else {
         days = value | 0;
       }
@@ -729,8 +2447,7 @@
     timestamp(value) {
       let ns;
       if (value instanceof Date) {
-        const epoch = new Date(2000, 0, 1);
-        ns = Number(value - epoch) * 1000000;
+        ns = (value.getTime() - RAY_EPOCH_MS) * 1000000;
       } else {
         ns = Number(value);
       }
@@ -771,26 +2488,185 @@
     dict(obj) {
       const keys = Object.keys(obj);
       const keyVec = this.vector(Types.SYMBOL, keys.length);
-      const keyView = keyVec.typedArray;
-      for (let i = 0; i < keys.length; i++) {
-        keyView[i] = BigInt(this._internSymbol(keys[i], keys[i].length));
-      }
+      const keyIds = this.internSymbols(keys);
+      keyVec.typedArray.set(keyIds);
       const valList = this.list(Object.values(obj).map(v => this._toRayObject(v)));
-      return new Dict(this, this._initDict(keyVec._ptr, valList._ptr));
+      return new Dict(this, this._initDict(keyVec.release(), valList.release()));
     }
 
     table(columns) {
+      const values = Object.values(columns);
+      if (values.length > 0 && values.every(isBulkIdentical)) return this.tableFromColumns(columns);
+
       const colNames = Object.keys(columns);
       const keyVec = this.vector(Types.SYMBOL, colNames.length);
-      const keyView = keyVec.typedArray;
-      for (let i = 0; i < colNames.length; i++) {
-        keyView[i] = BigInt(this._internSymbol(colNames[i], colNames[i].length));
-      }
+      const keyIds = this.internSymbols(colNames);
+      keyVec.typedArray.set(keyIds);
       const valList = this.list();
       for (const name of colNames) {
         valList.push(this._arrayToVector(columns[name]));
       }
-      return new Table(this, this._initTable(keyVec._ptr, valList._ptr));
+      return new Table(this, this._initTable(keyVec.release(), valList.release()));
+    }
+
+    symbolString(id) {
+      const key = Number(id);
+      let str = this._symbolCache.get(key);
+      if (str === undefined) {
+        str = this._symbolToStr(key);
+        this._symbolCache.set(key, str);
+      }
+      return str;
+    }
+
+    // Cache misses resolved in one native call and one decode pass
+    resolveSymbols(ids) {
+      const n = ids.length;
+      const result = new Array(n);
+      const missing = new Map();
+      for (let i = 0; i < n; i++) {
+        const id = Number(ids[i]);
+        const str = this._symbolCache.get(id);
+        if (str !== undefined) result[i] = str;
+        else if (missing.has(id)) missing.get(id).push(i);
+        else missing.set(id, [i]);
+      }
+      if (missing.size === 0) return result;
+
+      const w = this._wasm;
+      const unique = BigInt64Array.from(missing.keys(), BigInt);
+      const idsPtr = this._malloc(unique.byteLength);
+      if (idsPtr === 0) throw new Error('Out of memory: failed to stage symbol ids');
+      try {
+        new BigInt64Array(w.HEAPU8.buffer, idsPtr, unique.length).set(unique);
+        const blob = this._symbolsToStrsBulk(idsPtr, unique.length);
+        if (blob === 0) throw new Error('Out of memory: failed to resolve symbols');
+        const heap = w.HEAPU8;
+        const offsets = new Int32Array(heap.buffer, blob, unique.length + 1);
+        const strs = decodePacked(heap, blob + offsets.byteLength, offsets);
+        for (let k = 0; k < unique.length; k++) {
+          const id = Number(unique[k]);
+          this._symbolCache.set(id, strs[k]);
+          for (const i of missing.get(id)) result[i] = strs[k];
+        }
+      } finally {
+        this._free(idsPtr);
+      }
+      return result;
+    }
+
+    internSymbols(strings) {
+      const w = this._wasm;
+      const n = strings.length;
+      const ids = new BigInt64Array(n);
+      if (n === 0) return ids;
+
+      const { bytes, offsets } = packStrings(strings);
+      const bytesPtr = this._malloc(Math.max(bytes.length, 1));
+      const offsetsPtr = this._malloc(offsets.byteLength);
+      const idsPtr = this._malloc(ids.byteLength);
+      try {
+        if (bytesPtr === 0 || offsetsPtr === 0 || idsPtr === 0) {
+          throw new Error('Out of memory: failed to stage symbols');
+        }
+        w.HEAPU8.set(bytes, bytesPtr);
+        w.HEAPU8.set(new Uint8Array(offsets.buffer), offsetsPtr);
+        this._internSymbolsBulk(bytesPtr, offsetsPtr, idsPtr, n);
+        ids.set(new BigInt64Array(w.HEAPU8.buffer, idsPtr, n));
+      } finally {
+        this._free(idsPtr);
+        this._free(offsetsPtr);
+        this._free(bytesPtr);
+      }
+      for (let i = 0; i < n; i++) this._symbolCache.set(Number(ids[i]), String(strings[i]));
+      return ids;
+    }
+
+    // DATE/TIME/TIMESTAMP vector from epoch ms in one native pass
+    fromEpochMillis(type, ms) {
+      const w = this._wasm;
+      const wide = ms instanceof BigInt64Array;
+      const view = wide || ms instanceof Float64Array ? ms : Float64Array.from(ms);
+      const ptr = this._malloc(Math.max(view.byteLength, 1));
+      if (ptr === 0) throw new Error('Out of memory: failed to stage epoch values');
+      try {
+        w.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+        const convert = wide ? this._temporalFromMsI64 : this._temporalFromMsF64;
+        return this._wrapPtr(convert(type, ptr, view.length));
+      } finally {
+        this._free(ptr);
+      }
+    }
+
+    // Single-call table from TypedArrays / strings / packed { bytes, offsets }
+    tableFromColumns(columns, options = {}) {
+      const w = this._wasm;
+      const names = Object.keys(columns);
+      const ncols = names.length;
+      if (ncols === 0) throw new Error('tableFromColumns: no columns');
+
+      const types = new Int8Array(ncols);
+      const data = new Array(ncols);
+      const packed = new Array(ncols).fill(null);
+      let rows = -1;
+
+      for (let i = 0; i < ncols; i++) {
+        const name = names[i];
+        let col = columns[name];
+        let len;
+        if (Array.isArray(col)) col = packStrings(col);
+
+        if (isPackedStrings(col)) {
+          types[i] = Types.SYMBOL;
+          packed[i] = col;
+          data[i] = col.bytes;
+          len = col.offsets.length - 1;
+        } else if (ArrayBuffer.isView(col) && BULK_COLUMN_TYPES.has(col.constructor)) {
+          const override = options.types && options.types[name];
+          types[i] = override !== undefined ? override : BULK_COLUMN_TYPES.get(col.constructor);
+          if (ELEMENT_SIZES[types[i]] !== col.BYTES_PER_ELEMENT) {
+            throw new TypeError(`Column '${name}': ${col.constructor.name} cannot hold type ${types[i]}`);
+          }
+          data[i] = col;
+          len = col.length;
+        } else {
+          throw new TypeError(`Column '${name}': expected a TypedArray or strings`);
+        }
+
+        if (rows !== -1 && len !== rows) {
+          throw new RangeError(`Column '${name}' has ${len} rows, expected ${rows}`);
+        }
+        rows = len;
+      }
+
+      const allocs = [];
+      const stage = (view) => {
+        const ptr = this._malloc(Math.max(view.byteLength, 1));
+        if (ptr === 0) throw new Error('Out of memory: failed to stage table columns');
+        allocs.push(ptr);
+        w.HEAPU8.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), ptr);
+        return ptr;
+      };
+
+      try {
+        const nameList = packStrings(names);
+        const namesPtr = stage(nameList.bytes);
+        const nameOffsPtr = stage(nameList.offsets);
+        const typesPtr = stage(types);
+        const dataPtrs = new Array(ncols).fill(0);
+        const symOffPtrs = new Array(ncols).fill(0);
+        for (let i = 0; i < ncols; i++) {
+          dataPtrs[i] = stage(data[i]);
+          if (packed[i] !== null) {
+            const offsets = packed[i].offsets;
+            symOffPtrs[i] = stage(offsets instanceof Int32Array ? offsets : Int32Array.from(offsets));
+          }
+        }
+        return this._wrapPtr(this._initTableBulk(ncols, namesPtr, nameOffsPtr, typesPtr,
+          stage(this._ptrArray(dataPtrs)), stage(this._ptrArray(symOffPtrs)), rows));
+      } finally {
+        for (const ptr of allocs) this._free(ptr);
+      }
     }
 
     _arrayToVector(arr) {
@@ -803,22 +2679,24 @@
       else if (typeof first === 'number') type = Number.isInteger(first) ? Types.I64 : Types.F64;
       else if (typeof first === 'bigint') type = Types.I64;
       else if (typeof first === 'string') type = Types.SYMBOL;
-      else if (first instanceof Date) type = Types.TIMESTAMP;
-      else return this.list(arr.map(v => this._toRayObject(v)));
+      else if (first instanceof Date) {
+        const ms = new Float64Array(arr.length);
+        for (let i = 0; i < arr.length; i++) ms[i] = arr[i] == null ? NaN : arr[i] instanceof Date ? arr[i].getTime() : Number(arr[i]);
+        return this.fromEpochMillis(Types.TIMESTAMP, ms);
+      } else return this.list(arr.map(v => this._toRayObject(v)));
 
       const vec = this.vector(type, arr.length);
+      if (type === Types.SYMBOL) {
+        const ids = this.internSymbols(arr);
+        vec.typedArray.set(ids);
+        return vec;
+      }
+
       const view = vec.typedArray;
 
       for (let i = 0; i < arr.length; i++) {
-        if (type === Types.SYMBOL) {
-          view[i] = BigInt(this._internSymbol(arr[i], arr[i].length));
-        } else if (type === Types.I64 || type === Types.TIMESTAMP) {
-          if (arr[i] instanceof Date) {
-            const epoch = new Date(2000, 0, 1);
-            view[i] = BigInt((arr[i] - epoch) * 1000000);
-          } else {
-            view[i] = BigInt(arr[i]);
-          }
+        if (type === Types.I64) {
+          view[i] = BigInt(arr[i]);
         } else if (type === Types.B8) {
           view[i] = arr[i] ? 1 : 0;
         } else {
@@ -853,21 +2731,274 @@
 
     col(name) { return Expr.col(this, name); }
 
-    read_csv(content) {
+    read_csv(content, options = {}) {
       if (typeof content !== 'string') throw new Error('Content must be a string');
 
+      this._requireFeature('io');
       // Manually allocate memory on WASM heap to avoid stack overflow with large CSVs
       const lengthBytes = this._wasm.lengthBytesUTF8(content) + 1;
-      const stringOnHeap = this._wasm._malloc(lengthBytes);
+      const stringOnHeap = this._malloc(lengthBytes);
+      let typesOnHeap = 0;
 
       try {
         this._wasm.stringToUTF8(content, stringOnHeap, lengthBytes);
-        // Pass pointer and length (excluding null terminator)
-        return new Table(this, this._readCSV(stringOnHeap, lengthBytes - 1));
+
+        // Optional schema override: type codes by column name or position (0 = infer)
+        const schema = this._csvSchema(content, options.types);
+        if (schema === null) {
+          // Pass pointer and length (excluding null terminator)
+          return this._wrapPtr(this._readCSV(stringOnHeap, lengthBytes - 1));
+        }
+        typesOnHeap = this._malloc(schema.length);
+        this._wasm.HEAP8.set(schema, typesOnHeap);
+        return this._wrapPtr(this._readCSVTyped(stringOnHeap, typesOnHeap, schema.length, lengthBytes - 1));
+      } finally {
+        if (typesOnHeap !== 0) this._free(typesOnHeap);
+        this._free(stringOnHeap);
+      }
+    }
+
+    readArrow(bytes) {
+      const data = ArrayBuffer.isView(bytes)
+        ? new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+        : new Uint8Array(bytes);
+      const ptr = this._malloc(data.length || 1);
+      if (ptr === 0) throw new Error('Out of memory: failed to stage Arrow buffer');
+      try {
+        this._wasm.HEAPU8.set(data, ptr);
+        return this._wrapPtr(this._importArrow(ptr, data.length));
+      } finally {
+        this._free(ptr);
+      }
+    }
+
+    // Ingest a ReadableStream / async iterable of CSV chunks without
+    // holding the whole file in the heap
+    async readCsvStream(stream, options = {}) {
+      await this.loadFeature('io');
+      const w = this._wasm;
+      const encoder = new TextEncoder();
+      const decoder = new TextDecoder('utf-8');
+      let session = 0;
+      let staging = 0;
+      let stagingSize = 0;
+      let header = '';
+
+      const begin = (firstLine) => {
+        const schema = this._csvSchema(firstLine, options.types);
+        let typesPtr = 0;
+        if (schema !== null) {
+          typesPtr = this._malloc(schema.length);
+          w.HEAP8.set(schema, typesPtr);
+        }
+        try {
+          session = this._csvBegin(typesPtr, schema ? schema.length : 0);
+        } finally {
+          if (typesPtr !== 0) this._free(typesPtr);
+        }
+        if (session === 0) throw new Error('Failed to start CSV stream');
+      };
+
+      const feed = (bytes) => {
+        if (bytes.length > stagingSize) {
+          if (staging !== 0) this._free(staging);
+          stagingSize = Math.max(bytes.length, stagingSize * 2, 65536);
+          staging = this._malloc(stagingSize);
+          if (staging === 0) throw new Error('Out of memory: failed to allocate CSV chunk');
+        }
+        w.HEAPU8.set(bytes, staging);
+        const rows = this._csvFeed(session, staging, bytes.length);
+        if (rows >= 0 && options.onProgress) options.onProgress(rows);
+      };
+
+      const pending = [];
+      try {
+        for await (const chunk of this._streamChunks(stream)) {
+          const bytes = typeof chunk === 'string' ? encoder.encode(chunk) : chunk;
+          if (session === 0) {
+            // Type overrides by name need the header line first
+            pending.push(bytes);
+            header += decoder.decode(bytes, { stream: true });
+            if (header.indexOf('\n') === -1) continue;
+            begin(header);
+            for (const b of pending) feed(b);
+            pending.length = 0;
+            continue;
+          }
+          feed(bytes);
+        }
+        if (session === 0) {
+          begin(header);
+          for (const b of pending) feed(b);
+        }
+        const ptr = this._csvEnd(session);
+        session = 0;
+        return this._wrapPtr(ptr);
+      } finally {
+        if (session !== 0) this._csvAbort(session);
+        if (staging !== 0) this._free(staging);
+      }
+    }
+
+    async *_streamChunks(stream) {
+      if (typeof stream.getReader !== 'function') {
+        yield* stream;
+        return;
+      }
+      const reader = stream.getReader();
+      try {
+        while (true) {
+          const { done, value } = await reader.read();
+          if (done) return;
+          yield value;
+        }
+      } finally {
+        reader.releaseLock();
+      }
+    }
+
+    lastIngestStats() {
+      const base = this._lastIngestStats() / 8;
+      const f = this._wasm.HEAPF64;
+      return {
+        rows: f[base], columns: f[base + 1], bytes: f[base + 2],
+        countMs: f[base + 3], headerMs: f[base + 4], allocMs: f[base + 5],
+        parseMs: f[base + 6], totalMs: f[base + 7],
+      };
+    }
+
+    _csvSchema(content, types) {
+      if (!types) return null;
+      if (Array.isArray(types)) return Int8Array.from(types, t => t || 0);
+      const eol = content.indexOf('\n');
+      const header = (eol === -1 ? content : content.slice(0, eol)).replace(/\r$/, '');
+      const names = header.split(',').map(n => n.trim().replace(/^"|"$/g, ''));
+      return Int8Array.from(names, n => types[n] || 0);
+    }
+
+    serialize(obj) {
+      this._requireFeature('io');
+      return this._wrapPtr(this._serialize(obj._ptr));
+    }
+
+    deserialize(bytes) {
+      this._requireFeature('io');
+      if (bytes instanceof RayObject) return this._wrapPtr(this._deserialize(bytes._ptr));
+      const data = ArrayBuffer.isView(bytes)
+        ? new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+        : new Uint8Array(bytes);
+      const buf = this._unscoped(() => this.vector(Types.U8, data.length));
+      try {
+        buf.typedArray.set(data);
+        return this._wrapPtr(this._deserialize(buf._ptr));
+      } finally {
+        buf.drop();
+      }
+    }
+
+    async save(name, obj) { return this._writeObject([], storageName(name), obj); }
+    load(name) { return this._readObject([], storageName(name)); }
+
+    // Columns go to a new generation directory; `.d` (written last) switches
+    // readers to it, then older generations are removed
+    async saveSplayed(name, table) {
+      const dir = storageName(name);
+      const gen = splayGeneration();
+      const names = table.columnNames();
+      names.forEach(splayFile);
+      const parts = this._unscoped(() => this._wrapPtr(this._splayEnum(table._ptr)));
+      if (parts.isError) {
+        const message = parts.message;
+        parts.drop();
+        throw new Error(message);
+      }
+      const meta = this._unscoped(() => this.scope(() => {
+        const vals = table.values();
+        const types = names.map((_, i) => vals.at(i).type);
+        return this.list([table.columns(), this.vector(Types.I16, types), this.i64(table.rowCount),
+          this.string(gen)]);
+      }));
+      let size;
+      try {
+        size = await this._writeObject([dir, gen], '.sym', parts.at(0));
+        for (let i = 0; i < names.length; i++) {
+          size += await this._writeObject([dir, gen], splayFile(names[i]), parts.at(i + 1));
+        }
+        size += await this._writeObject([dir], '.d', meta);
+      } catch (error) {
+        await storageRemove([dir], gen).catch(() => {});
+        throw error;
+      } finally {
+        meta.drop();
+        parts.drop();
+      }
+      for (const entry of await storageList([dir])) {
+        if (entry !== '.d' && entry !== gen) await storageRemove([dir], entry);
+      }
+      return size;
+    }
+
+    async openSplayed(name, options = {}) {
+      const dir = storageName(name);
+      const meta = await this._readObject([dir], '.d');
+      if (meta === null) return null;
+      try {
+        if (meta.isError || !(meta instanceof List) || (meta.length !== 3 && meta.length !== 4)) {
+          throw new Error(`Corrupt splayed table '${name}'`);
+        }
+        const names = meta.at(0).toJS();
+        const types = Array.from(meta.at(1).typedArray);
+        const rows = Number(meta.at(2).value);
+        const path = meta.length === 4 ? [dir, storageName(meta.at(3).toJS())] : [dir];
+        return new SplayedTable(this, path, names, types, rows, options.maxBytes);
+      } finally {
+        meta.drop();
+      }
+    }
+
+    async _writeObject(path, file, obj) {
+      await this.loadFeature('io');
+      const buf = this._unscoped(() => this.serialize(obj));
+      if (buf.isError) {
+        const message = buf.message;
+        buf.drop();
+        throw new Error(message);
+      }
+      try {
+        const size = buf.length;
+        await storageWrite(path, file, () => buf.typedArray);
+        return size;
+      } finally {
+        buf.drop();
+      }
+    }
+
+    async _readObject(path, file) {
+      await this.loadFeature('io');
+      let buf = null;
+      try {
+        const found = await storageRead(path, file, (size) => {
+          buf = this._unscoped(() => this.vector(Types.U8, size));
+          return () => buf.typedArray;
+        });
+        if (!found) return null;
+        return this._wrapPtr(this._deserialize(buf._ptr));
       } finally {
-        this._wasm._free(stringOnHeap);
+        if (buf !== null) buf.drop();
       }
     }
+
+    removeSaved(name) { return storageRemove([], storageName(name)); }
+    listSaved() { return storageList([]); }
+
+    // Connect to a native rayforce server over a WebSocket speaking its IPC
+    // protocol (WebSocket listener, or a WebSocket-to-TCP bridge)
+    async connect(url, options = {}) {
+      await this.loadFeature('io');
+      const conn = new RemoteConnection(this, options);
+      await conn._open(url, options);
+      return conn;
+    }
   }
 
   // ============================================================================
@@ -877,8 +3008,79 @@
   let _sdkInstance = null;
   let _initPromise = null;
 
+  const WASM_PAGE_SIZE = 65536;
+  const DEFAULT_INITIAL_MEMORY = 16 * 1024 * 1024;
+  const DEFAULT_MAXIMUM_MEMORY = 4 * 1024 * 1024 * 1024;
+  const DEFAULT_MAXIMUM_MEMORY_64 = 16 * 1024 * 1024 * 1024;
+
+  function createMemory(initialMemory, maximumMemory, shared, memory64 = false, required = false) {
+    if (initialMemory === undefined && maximumMemory === undefined && !required) return undefined;
+    const ceiling = memory64 ? DEFAULT_MAXIMUM_MEMORY_64 : DEFAULT_MAXIMUM_MEMORY;
+    const initial = Math.ceil((initialMemory ?? DEFAULT_INITIAL_MEMORY) / WASM_PAGE_SIZE);
+    const maximum = Math.ceil((maximumMemory ?? ceiling) / WASM_PAGE_SIZE);
+    if (initial > maximum) throw new Error('initialMemory exceeds maximumMemory');
+    if (memory64) {
+      return new WebAssembly.Memory({ address: 'i64', initial: BigInt(initial), maximum: BigInt(maximum) });
+    }
+    return new WebAssembly.Memory({ initial, maximum, shared });
+  }
+
+  // Compiled modules by .wasm URL, shared by later instances
+  const _modules = new Map();
+
+  function compileModule(loaderPath) {
+    const url = String(loaderPath).replace(/\.js$/, '.wasm');
+    let compiled = _modules.get(url);
+    if (compiled === undefined) {
+      compiled = (typeof WebAssembly.compileStreaming === 'function'
+        ? WebAssembly.compileStreaming(fetch(url)).catch(() => loadBytes(url).then(b => WebAssembly.compile(b)))
+        : loadBytes(url).then(b => WebAssembly.compile(b)));
+      _modules.set(url, compiled);
+      compiled.catch(() => _modules.delete(url));
+    }
+    return compiled;
+  }
+
+  async function loadBytes(source) {
+    if (source instanceof ArrayBuffer) return new Uint8Array(source);
+    if (ArrayBuffer.isView(source)) return new Uint8Array(source.buffer, source.byteOffset, source.byteLength);
+    const response = await fetch(source);
+    if (!response.ok) throw new Error(`Failed to fetch ${source}: ${response.status}`);
+    return new Uint8Array(await response.arrayBuffer());
+  }
+
+  // Emscripten factory over a precompiled module (instantiateWasm errors
+  // never reach the factory's promise, hence the race)
+  function instantiate(createRayforce, moduleOptions, module) {
+    if (module === undefined) return createRayforce(moduleOptions);
+    let fail;
+    const failed = new Promise((resolve, reject) => { fail = reject; });
+    const instance = createRayforce({
+      ...moduleOptions,
+      instantiateWasm: (imports, receiveInstance) => {
+        WebAssembly.instantiate(module, imports).then((result) => receiveInstance(result, module), fail);
+        return {};
+      },
+    });
+    return Promise.race([instance, failed]);
+  }
+
   async function init(options = {}) {
-    const { wasmPath = './rayforce.js', singleton = true, onReady = null } = options;
+    const {
+      wasmPath = './rayforce.js',
+      wasmMtPath = './rayforce-mt.js',
+      memory64 = false,
+      wasm64Path = './rayforce-64.js',
+      threads = 1,
+      initialMemory,
+      maximumMemory,
+      lean = false,
+      snapshot,
+      wasmModule,
+      cacheModule = true,
+      singleton = true,
+      onReady = null,
+    } = options;
 
     if (singleton && _sdkInstance !== null) return _sdkInstance;
     if (singleton && _initPromise !== null) return _initPromise;
@@ -888,26 +3090,43 @@
         // For browser usage, we need to load the WASM module
         let createRayforce;
 
+        // Multi-threaded build needs SharedArrayBuffer (cross-origin isolation)
+        const multiThreaded = !memory64 && threads > 1 && canUseThreads();
+        const loader = memory64 ? wasm64Path : multiThreaded ? wasmMtPath : wasmPath;
+        const memory = snapshot === undefined ? null : await loadBytes(snapshot);
+        if (memory !== null && multiThreaded) {
+          throw new Error('snapshot needs the single-threaded build (threads: 1)');
+        }
+
         if (typeof window !== 'undefined') {
           // Browser environment - expect global createRayforce or load via script
-          if (typeof window.createRayforce === 'function') {
+          if (!multiThreaded && !memory64 && typeof window.createRayforce === 'function') {
             createRayforce = window.createRayforce;
           } else {
             // Try dynamic import
-            const module = await import(wasmPath);
+            const module = await import(loader);
             createRayforce = module.default;
           }
         } else {
           // Node.js environment
-          const module = await import(wasmPath);
+          const module = await import(loader);
           createRayforce = module.default;
         }
 
-        const wasm = await createRayforce({
+        const compiled = wasmModule ?? (cacheModule ? await compileModule(loader).catch(() => undefined) : undefined);
+        const wasmMemory = createMemory(
+          memory === null ? initialMemory : Math.max(initialMemory ?? DEFAULT_INITIAL_MEMORY, memory.length),
+          maximumMemory, multiThreaded, memory64, memory !== null);
+        const wasm = await instantiate(createRayforce, {
+          arguments: ['-p', String(multiThreaded ? threads : 1), ...(lean ? ['--lean'] : [])],
+          noInitialRun: memory !== null,
+          ...(wasmMemory && { wasmMemory }),
           rayforce_ready: (msg) => { if (onReady) onReady(msg); }
-        });
+        }, compiled);
+        if (memory !== null) wasm.HEAPU8.set(memory);
 
         const sdk = new RayforceSDK(wasm);
+        if (memory !== null && onReady) onReady(sdk.version);
         if (singleton) _sdkInstance = sdk;
         return sdk;
       } catch (error) {
@@ -923,6 +3142,11 @@
     return initFn();
   }
 
+  function canUseThreads() {
+    return typeof SharedArrayBuffer !== 'undefined' &&
+      globalThis.crossOriginIsolated !== false;
+  }
+
   function getInstance() { return _sdkInstance; }
   function isInitialized() { return _sdkInstance !== null; }
   function reset() { _sdkInstance = null; _initPromise = null; }
@@ -933,11 +3157,16 @@
 
   return {
     init,
+    canUseThreads,
+    compileModule,
     getInstance,
     isInitialized,
     reset,
     Types,
     Expr,
+    PlanBuilder,
+    SplayedTable,
+    RemoteConnection,
     RayforceSDK,
     RayObject,
     Vector,
@@ -0,0 +1,254 @@
+/**
+ * RayforceDB Web Worker Host
+ *
+ * Hosts the WASM module and SDK in a dedicated worker so long evals and
+ * CSV loads don't block the page. Driven by RayforceWorkerSDK
+ * (rayforce.proxy.js) over a small request/response protocol:
+ *
+ *   { id, op: 'init', options, interrupt }       - create the module and SDK;
+ *                                                  interrupt is a shared
+ *                                                  Int32 flag (optional)
+ *   { id, op: 'sdk', method, args }              - call a RayforceSDK method
+ *   { id, op: 'obj', handle, method, args }      - call a method on a held object
+ *   { id, op: 'columns', handle }                - table columns by name
+ *   { id, op: 'drop', handle }                   - drop and forget a held object
+ *   { id, op: 'evalAsync', code, options, progress } - sdk.evalAsync, posting
+ *                                                  { id, progress } updates
+ *   { id, op: 'abort', target }                  - abort a running evalAsync
+ *
+ * Replies are { id, result } or { id, error }. RayObjects (and splayed
+ * tables and query builders) stay in the worker and cross as { $handle }
+ * references, also when nested in argument arrays and objects. Vector data
+ * crosses as a transferred copy of the column, or as a view over the shared
+ * heap when the module runs on SharedArrayBuffer memory (wasm-mt build);
+ * table columns ('columns') are always copies.
+ *
+ * @module rayforce/worker
+ */
+
+import { init } from './index.js';
+import {
+  RayObject, Vector, RayString, Types, Expr, SelectQuery, SplayedTable, AppendSession,
+  MaterializedView, TableIndex, RemoteConnection,
+} from './rayforce.sdk.js';
+
+let sdk = null;
+let nextHandle = 1;
+const handles = new Map();
+// evalAsync request id -> AbortController; aborts arrive at yields (the
+// shared interrupt flag is seen before every form)
+const aborts = new Map();
+
+// ============================================================================
+// Value Encoding
+// ============================================================================
+
+/**
+ * Encode a value for postMessage, collecting transferables
+ * @param {any} value
+ * @param {Transferable[]} transfer
+ * @returns {any}
+ */
+function encode(value, transfer) {
+  if (value instanceof RayObject || isHeld(value)) {
+    const handle = nextHandle++;
+    handles.set(handle, value);
+    return {
+      $handle: handle,
+      className: value.constructor.name,
+      type: value.type,
+      length: value.length,
+    };
+  }
+
+  if (ArrayBuffer.isView(value)) return encodeView(value, transfer);
+
+  if (Array.isArray(value)) return value.map(v => encode(v, transfer));
+
+  if (value !== null && typeof value === 'object' && value.constructor === Object) {
+    const result = {};
+    for (const [k, v] of Object.entries(value)) result[k] = encode(v, transfer);
+    return result;
+  }
+
+  return value;
+}
+
+/**
+ * TypedArrays over the WASM heap are never transferred (that would detach
+ * the module memory): shared heaps are sent as views, private heaps as a
+ * single transferred copy.
+ */
+function encodeView(view, transfer) {
+  const heap = sdk._wasm.HEAPU8.buffer;
+
+  if (view.buffer !== heap) {
+    if (!isShared(view.buffer)) transfer.push(view.buffer);
+    return view;
+  }
+
+  if (isShared(heap)) {
+    return {
+      $view: view.constructor.name,
+      buffer: heap,
+      byteOffset: view.byteOffset,
+      length: view.length,
+    };
+  }
+
+  const copy = view.slice();
+  transfer.push(copy.buffer);
+  return copy;
+}
+
+/**
+ * Non-RayObject SDK values that also stay in the worker behind a handle:
+ * splayed tables, append sessions, materialized views, remote connections
+ * and query builders (so their chained calls work remotely)
+ */
+function isHeld(value) {
+  return value instanceof SplayedTable || value instanceof AppendSession ||
+    value instanceof MaterializedView || value instanceof TableIndex ||
+    value instanceof RemoteConnection ||
+    value instanceof SelectQuery || value instanceof Expr;
+}
+
+function isShared(buffer) {
+  return typeof SharedArrayBuffer !== 'undefined' && buffer instanceof SharedArrayBuffer;
+}
+
+/**
+ * Resolve { $handle } references in call arguments
+ * @param {any[]} args
+ * @returns {any[]}
+ */
+function decodeArgs(args) {
+  return (args || []).map(decodeArg);
+}
+
+/**
+ * Resolve { $handle } references anywhere in an argument, e.g. vectors in
+ * the column map of sdk.table() or the items of sdk.list()
+ */
+function decodeArg(value) {
+  if (value === null || typeof value !== 'object' || ArrayBuffer.isView(value)) return value;
+  if (value.$handle !== undefined) return lookup(value.$handle);
+  if (Array.isArray(value)) return value.map(decodeArg);
+  if (value.constructor !== Object) return value;
+
+  const result = {};
+  for (const [k, v] of Object.entries(value)) result[k] = decodeArg(v);
+  return result;
+}
+
+function lookup(handle) {
+  const obj = handles.get(handle);
+  if (obj === undefined) throw new Error(`Unknown object handle ${handle}`);
+  return obj;
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+/**
+ * Call a method on a target, or read it if it is a property
+ */
+async function invoke(target, method, args) {
+  const member = target[method];
+  if (typeof member !== 'function') {
+    if (member === undefined && !(method in target)) {
+      throw new Error(`Unknown member '${method}'`);
+    }
+    return member;
+  }
+  return member.apply(target, decodeArgs(args));
+}
+
+/**
+ * Table columns keyed by name: numeric vectors as TypedArrays, symbol and
+ * string columns as JS arrays. Numeric columns are copied out of the heap
+ * (and the copies transferred), so the wrappers are dropped right away.
+ */
+function tableColumns(table) {
+  const names = table.columnNames();
+  const vals = table.values();
+  const result = {};
+
+  try {
+    for (let i = 0; i < names.length; i++) {
+      const col = vals.at(i);
+      try {
+        if (col instanceof Vector && !(col instanceof RayString) &&
+            col.elementType !== Types.SYMBOL) {
+          result[names[i]] = col.typedArray.slice();
+        } else {
+          result[names[i]] = col.toJS();
+        }
+      } finally {
+        col.drop();
+      }
+    }
+  } finally {
+    vals.drop();
+  }
+
+  return result;
+}
+
+async function handle(msg) {
+  // A new call starts without a stale interrupt meant for an earlier one
+  if (sdk !== null && msg.op !== 'abort') Atomics.store(sdk.interruptFlag, 0, 0);
+
+  switch (msg.op) {
+    case 'init':
+      sdk = await init({ ...msg.options, singleton: false, worker: false });
+      if (msg.interrupt) sdk.interruptFlag = new Int32Array(msg.interrupt);
+      return true;
+    case 'sdk':
+      if (sdk === null) throw new Error('RayforceDB worker not initialized');
+      return invoke(sdk, msg.method, msg.args);
+    case 'obj':
+      return invoke(lookup(msg.handle), msg.method, msg.args);
+    case 'columns':
+      return tableColumns(lookup(msg.handle));
+    case 'evalAsync': {
+      if (sdk === null) throw new Error('RayforceDB worker not initialized');
+      const controller = new AbortController();
+      const onProgress = msg.progress
+        ? (progress) => self.postMessage({ id: msg.id, progress })
+        : undefined;
+      aborts.set(msg.id, controller);
+      try {
+        return await sdk.evalAsync(msg.code, { ...msg.options, signal: controller.signal, onProgress });
+      } finally {
+        aborts.delete(msg.id);
+      }
+    }
+    case 'abort': {
+      const controller = aborts.get(msg.target);
+      if (controller !== undefined) controller.abort();
+      return true;
+    }
+    case 'drop': {
+      const obj = lookup(msg.handle);
+      if (typeof obj.drop === 'function') obj.drop();
+      handles.delete(msg.handle);
+      return true;
+    }
+    default:
+      throw new Error(`Unknown operation '${msg.op}'`);
+  }
+}
+
+self.onmessage = async (event) => {
+  const msg = event.data;
+  try {
+    const result = await handle(msg);
+    const transfer = [];
+    const encoded = encode(result, transfer);
+    self.postMessage({ id: msg.id, result: encoded }, transfer);
+  } catch (error) {
+    self.postMessage({ id: msg.id, error: error.message || String(error) });
+  }
+};